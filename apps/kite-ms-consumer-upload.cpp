@@ -18,6 +18,7 @@
  **/
 
 #include "kite-ms-consumer-upload.hpp"
+#include "kite-ms-server.hpp"
 #include "ns3/ptr.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -68,7 +69,7 @@ KiteMsConsumerUpload::GetTypeId(void)
 KiteMsConsumerUpload::KiteMsConsumerUpload()
   : m_frequency(1.0)
   , m_firstTime(true)
-  , m_mapSeq(0)
+  , m_mapPrefix(NamePrefixTable::get().intern("/map"))
   , m_receivedData(0)
   , m_totalHopCount(0)
   , m_overheadInts(0)
@@ -109,11 +110,10 @@ KiteMsConsumerUpload::OnData(shared_ptr<const Data> data)
     return;
   }
   // get the new locator
-  if (Name("/map").isPrefixOf(data->getName())) {
-    uint32_t seq = data->getName().at(-1).toSequenceNumber();
-    NS_LOG_INFO("> Map Data for " << seq);
+  if (NamePrefixTable::get().getPrefix(m_mapPrefix).isPrefixOf(data->getName())) {
+    NS_LOG_INFO("> Map Data " << data->getName());
     Block content(data->getContent().value(), data->getContent().value_size());
-    m_interestName.wireDecode(content);
+    SetInterestName(Name(content));
     NS_LOG_INFO("New locator: " << m_interestName);
     m_overheadData++;
     m_outstandingMappingInterest = false;
@@ -154,20 +154,16 @@ KiteMsConsumerUpload::OnTimeout(uint32_t sequenceNumber)
   NS_LOG_FUNCTION_NOARGS();
 
   if (!m_outstandingMappingInterest) {
-    //
-    shared_ptr<Name> nameWithSequence = make_shared<Name>("/map");
-    nameWithSequence->appendSequenceNumber(m_mapSeq++);
-    //
     m_overheadInts++;
 
-    shared_ptr<Interest> interest = make_shared<Interest>();
+    // the same name for all lookups, so that fresh responses can come from caches
+    shared_ptr<Interest> interest =
+      KiteMsServer::MakeLookupInterest(NamePrefixTable::get().getPrefix(m_mapPrefix), Name());
     interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-    interest->setName(*nameWithSequence);
     time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
     interest->setInterestLifetime(interestLifeTime);
 
-    // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
-    NS_LOG_INFO("> Map Interest for " << m_mapSeq);
+    NS_LOG_INFO("> Map Interest " << interest->getName());
 
     m_transmittedInterests(interest, this, m_face);
     m_appLink->onReceiveInterest(*interest);
@@ -76,7 +76,7 @@ protected:
   bool m_firstTime;
   Ptr<RandomVariableStream> m_random;
   std::string m_randomType;
-  int m_mapSeq;
+  NamePrefixTable::Id m_mapPrefix;
   uint64_t m_totalHopCount;
   uint64_t m_receivedData;
   uint64_t m_interestSent;
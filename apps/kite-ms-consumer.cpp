@@ -18,6 +18,7 @@
  **/
 
 #include "kite-ms-consumer.hpp"
+#include "kite-ms-server.hpp"
 #include "ns3/ptr.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -68,7 +69,7 @@ KiteMsConsumer::GetTypeId(void)
 KiteMsConsumer::KiteMsConsumer()
   : m_frequency(1.0)
   , m_firstTime(true)
-  , m_mapSeq(0)
+  , m_mapPrefix(NamePrefixTable::get().intern("/map"))
   , m_outstandingMappingInterest(false)
   , m_interestSent(0)
   , m_dataReceived(0)
@@ -137,12 +138,11 @@ void
 KiteMsConsumer::OnData(shared_ptr<const Data> data)
 {
   // get the new locator
-  if (Name("/map").isPrefixOf(data->getName())) {
+  if (NamePrefixTable::get().getPrefix(m_mapPrefix).isPrefixOf(data->getName())) {
     m_mapDataReceived++;
-    uint32_t seq = data->getName().at(-1).toSequenceNumber();
-    NS_LOG_INFO("> Map Data for " << seq);
+    NS_LOG_INFO("> Map Data " << data->getName());
     Block content(data->getContent().value(), data->getContent().value_size());
-    m_interestName.wireDecode(content);
+    SetInterestName(Name(content));
     NS_LOG_INFO("New locator: " << m_interestName);
     m_outstandingMappingInterest = false;
 
@@ -184,18 +184,14 @@ void
 KiteMsConsumer::UpdateLocator()
 {
   if (!m_outstandingMappingInterest) {
-    //
-    shared_ptr<Name> nameWithSequence = make_shared<Name>("/map");
-    nameWithSequence->appendSequenceNumber(m_mapSeq++);
-    //
-
-    shared_ptr<Interest> interest = make_shared<Interest>();
+    // the same name for all lookups, so that fresh responses can come from caches
+    shared_ptr<Interest> interest =
+      KiteMsServer::MakeLookupInterest(NamePrefixTable::get().getPrefix(m_mapPrefix), Name());
     interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-    interest->setName(*nameWithSequence);
     time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
     interest->setInterestLifetime(interestLifeTime);
 
-    NS_LOG_INFO("> Map Interest for " << m_mapSeq - 1);
+    NS_LOG_INFO("> Map Interest " << interest->getName());
 
     m_mapInterestSent++;
 
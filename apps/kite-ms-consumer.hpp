@@ -86,7 +86,7 @@ protected:
   bool m_firstTime;
   Ptr<RandomVariableStream> m_random;
   std::string m_randomType;
-  int m_mapSeq;
+  NamePrefixTable::Id m_mapPrefix;
   bool m_outstandingMappingInterest;
 
   int m_interestSent;
@@ -84,7 +84,7 @@ KiteMsMobile::StartApplication()
   NS_LOG_FUNCTION_NOARGS();
   App::StartApplication();
 
-  FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
+  RegisterPrefix(m_prefix);
 }
 
 void
@@ -50,20 +50,32 @@ KiteMsServer::GetTypeId(void)
 
                         .AddAttribute("Prefix", "Prefix of this server", StringValue("/map"),
                                       MakeNameAccessor(&KiteMsServer::m_prefix), MakeNameChecker())
-                        .AddAttribute("Locator", "Current prefix of MN", StringValue("/"),
-                                      MakeNameAccessor(&KiteMsServer::m_locator), MakeNameChecker())
+                        .AddAttribute("Locator", "Current prefix of the unnamed MN",
+                                      StringValue("/"),
+                                      MakeNameAccessor(&KiteMsServer::SetLocator,
+                                                       &KiteMsServer::GetLocator),
+                                      MakeNameChecker())
+                        .AddAttribute("Freshness", "Freshness of mapping responses",
+                                      TimeValue(Seconds(0)),
+                                      MakeTimeAccessor(&KiteMsServer::m_freshness),
+                                      MakeTimeChecker())
 
-                        .AddTraceSource("UpdateCallback", "UpdateCallback",
+                        .AddTraceSource("UpdateCallback", "Locator of a MN has been updated",
                                         MakeTraceSourceAccessor(&KiteMsServer::m_updateCallback),
-                                        "ns3::ndn::KiteRv::UpdateCallback")
+                                        "ns3::ndn::KiteMsServer::UpdateCallback")
     ;
   return tid;
 }
 
 KiteMsServer::KiteMsServer()
-  : m_rand(CreateObject<UniformRandomVariable>())
+  : m_updatePrefix(NamePrefixTable::INVALID_ID)
+  , m_batchPrefix(NamePrefixTable::INVALID_ID)
+  , m_rand(CreateObject<UniformRandomVariable>())
 {
   NS_LOG_FUNCTION_NOARGS();
+
+  const Block& root = Name("/").wireEncode();
+  m_emptyContent = ::ndn::makeBinaryBlock(::ndn::tlv::Content, root.wire(), root.size());
 }
 
 // inherited from Application base class.
@@ -74,7 +86,17 @@ KiteMsServer::StartApplication()
 
   App::StartApplication();
 
-  FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
+  RegisterPrefix(m_prefix);
+
+  m_updatePrefix = NamePrefixTable::get().intern(Name(m_prefix).append("update"));
+  m_batchPrefix = NamePrefixTable::get().intern(Name(m_prefix).append("batch"));
+
+  // signature is the same in all responses, so it is created only once
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+  signatureInfo.wireEncode();
+
+  m_dataSignature.setInfo(signatureInfo);
+  m_dataSignature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
 }
 
 void
@@ -85,6 +107,107 @@ KiteMsServer::StopApplication()
   App::StopApplication();
 }
 
+const std::string&
+KiteMsServer::makeKey(const Name& name, size_t begin, size_t end)
+{
+  m_key.clear();
+  for (size_t i = begin; i < end; i++) {
+    m_key.append(reinterpret_cast<const char*>(name[i].wire()), name[i].size());
+  }
+  return m_key;
+}
+
+void
+KiteMsServer::SetMapping(const Name& producer, const Name& locator)
+{
+  Mapping& mapping = m_mappings[makeKey(producer, 0, producer.size())];
+  if (mapping.locator == locator && mapping.content.hasWire()) {
+    return;
+  }
+
+  mapping.locator = locator;
+  const Block& wire = locator.wireEncode();
+  mapping.content = ::ndn::makeBinaryBlock(::ndn::tlv::Content, wire.wire(), wire.size());
+}
+
+Name
+KiteMsServer::GetMapping(const Name& producer) const
+{
+  std::string key;
+  for (const auto& component : producer) {
+    key.append(reinterpret_cast<const char*>(component.wire()), component.size());
+  }
+
+  auto entry = m_mappings.find(key);
+  if (entry == m_mappings.end()) {
+    return "/";
+  }
+  return entry->second.locator;
+}
+
+void
+KiteMsServer::SetLocator(Name locator)
+{
+  SetMapping(Name(), locator);
+}
+
+Name
+KiteMsServer::GetLocator() const
+{
+  return GetMapping(Name());
+}
+
+shared_ptr<Interest>
+KiteMsServer::MakeLookupInterest(const Name& prefix, const Name& producer)
+{
+  auto interest = make_shared<Interest>(Name(prefix).append(producer));
+  interest->setMustBeFresh(true);
+  interest->setMaxSuffixComponents(1); // only the implicit digest
+  return interest;
+}
+
+name::Component
+KiteMsServer::EncodeMappings(const std::vector<std::pair<Name, Name>>& mappings)
+{
+  Block batch = ::ndn::makeEmptyBlock(::ndn::tlv::Content);
+  for (const auto& mapping : mappings) {
+    batch.push_back(mapping.first.wireEncode());
+    batch.push_back(mapping.second.wireEncode());
+  }
+  batch.encode();
+
+  return name::Component(batch.value(), batch.value_size());
+}
+
+bool
+KiteMsServer::applyMappings(const name::Component& mappings)
+{
+  try {
+    Block batch = ::ndn::makeBinaryBlock(::ndn::tlv::Content, mappings.value(),
+                                         mappings.value_size());
+    batch.parse();
+
+    const Block::element_container& elements = batch.elements();
+    if (elements.size() % 2 != 0) {
+      return false;
+    }
+
+    for (size_t i = 0; i < elements.size(); i += 2) {
+      Name producer(elements[i]);
+      Name locator(elements[i + 1]);
+
+      SetMapping(producer, locator);
+      NS_LOG_INFO("New locator of " << producer << ": " << locator);
+      m_updateCallback(this, producer, locator);
+    }
+  }
+  catch (const ::ndn::tlv::Error& e) {
+    NS_LOG_ERROR("Malformed batched update: " << e.what());
+    return false;
+  }
+  return true;
+}
+
 void
 KiteMsServer::OnInterest(shared_ptr<const Interest> interest)
 {
@@ -95,37 +218,56 @@ KiteMsServer::OnInterest(shared_ptr<const Interest> interest)
   if (!m_active)
     return;
 
-  if (Name("/map/update").isPrefixOf(interest->getName())) {
-    // mapping udpate interest
-    m_locator = interest->getName().getSubName(2, 2);
-    NS_LOG_INFO("New locator: " << m_locator);
-    m_updateCallback(this);
-    // return;
-  }
+  const Name& interestName = interest->getName();
+  const Name& updatePrefix = NamePrefixTable::get().getPrefix(m_updatePrefix);
+  const Name& batchPrefix = NamePrefixTable::get().getPrefix(m_batchPrefix);
 
-  Name dataName(interest->getName());
-  auto data = make_shared<Data>();
-  data->setName(dataName);
-  data->setFreshnessPeriod(::ndn::time::milliseconds(0));
+  const Block* content = &m_emptyContent;
 
-  data->setContent((uint8_t*)m_locator.wireEncode().wire(), m_locator.wireEncode().size());
+  if (updatePrefix.isPrefixOf(interestName)) {
+    // mapping udpate interest, e.g. /map/update/router/1/<seq>
+    Name locator = interestName.getSubName(updatePrefix.size(),
+                                           interestName.size() - updatePrefix.size() - 1);
+    SetMapping(Name(), locator);
+    NS_LOG_INFO("New locator: " << locator);
+    m_updateCallback(this, Name(), locator);
 
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    content = &m_mappings[makeKey(Name(), 0, 0)].content;
+  }
+  else if (batchPrefix.isPrefixOf(interestName)) {
+    // batched mapping update, e.g. /map/batch/<mappings>/<seq>
+    if (interestName.size() != batchPrefix.size() + 2
+        || !applyMappings(interestName.get(batchPrefix.size()))) {
+      NS_LOG_ERROR("Invalid batched update, ignoring: " << interestName);
+      return;
+    }
+  }
+  else {
+    // lookup, e.g. /map/alice/photo, or /map for the unnamed MN, optionally followed by <seq>
+    size_t end = interestName.size();
+    if (end > m_prefix.size() && interestName.get(-1).isSequenceNumber()) {
+      end--;
+    }
+    auto entry = m_mappings.find(makeKey(interestName, m_prefix.size(), end));
+    if (entry != m_mappings.end()) {
+      content = &entry->second.content;
+    }
+  }
 
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+  auto data = make_shared<Data>();
+  data->setName(interestName);
+  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
-  data->setSignature(signature);
+  data->setContent(*content);
+  data->setSignature(m_dataSignature);
 
-  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName() << ", locator=" << m_locator);
+  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
   // to create real wire encoding
   data->wireEncode();
 
   m_transmittedDatas(data, this, m_face);
   m_appLink->onReceiveData(*data);
-
 }
 
 } // namespace ndn
@@ -27,17 +27,33 @@
 #include "ns3/ptr.h"
 
 #include "ns3/ndnSIM/apps/ndn-app.hpp"
+#include "ns3/ndnSIM/utils/ndn-name-prefix-table.hpp"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
 
 /**
  * @ingroup ndn-apps
- * @brief A simple Interest-sink applia simple Interest-sink application
+ * @brief Mapping server of KITE, resolving mobile producer names to their current locators
+ *
+ * Mappings are kept in a hash table keyed by producer name.  The server answers:
  *
- * A simple Interest-sink.
- * It also sends out trace interest periodically to corresponding RV to update it's location in the network.
- * In upload scenario, this should run on a mobile node.
+ * - lookups <Prefix>/<producer> with the locator of the producer ("/" if not known); <Prefix>
+ *   alone looks up the unnamed producer, whose locator is the Locator attribute.  The older form
+ *   with a sequence number appended, <Prefix>/<producer>/<seq>, is accepted as well, therefore
+ *   producer names should not end with a sequence number component;
+ * - updates <Prefix>/update/<locator>/<seq> of the locator of the unnamed producer;
+ * - batched updates <Prefix>/batch/<mappings>/<seq>, where <mappings> is a single component
+ *   made by EncodeMappings(), carrying any number of (producer, locator) pairs.
+ *
+ * Content of lookup responses is encoded once per mapping update and shared by all responses,
+ * which carry the configurable Freshness.  Lookups made by MakeLookupInterest() have the same
+ * name for all consumers of a producer, so that they are served from in-network caches as long
+ * as the response is fresh.
  */
 class KiteMsServer : public App {
 public:
@@ -46,6 +62,46 @@ public:
 
   KiteMsServer();
 
+  /**
+   * @brief Make a lookup Interest for the locator of the mobile producer
+   * @param prefix prefix of the mapping server
+   * @param producer name of the mobile producer, empty name for the unnamed producer
+   *
+   * The Interest requires a fresh response with exactly the lookup name, so that a cached
+   * response for another producer or for an update cannot satisfy it.  Nonce and lifetime are
+   * left to the caller.
+   */
+  static shared_ptr<Interest>
+  MakeLookupInterest(const Name& prefix, const Name& producer);
+
+  /**
+   * @brief Set locator of the mobile producer
+   * @param producer name of the mobile producer, empty name for the unnamed producer
+   */
+  void
+  SetMapping(const Name& producer, const Name& locator);
+
+  /**
+   * @brief Get locator of the mobile producer, "/" if not known
+   */
+  Name
+  GetMapping(const Name& producer) const;
+
+  /**
+   * @brief Get number of mobile producers with known locators, including the unnamed one
+   */
+  size_t
+  GetNMappings() const
+  {
+    return m_mappings.size();
+  }
+
+  /**
+   * @brief Encode (producer, locator) pairs into the name component of a batched update
+   */
+  static name::Component
+  EncodeMappings(const std::vector<std::pair<Name, Name>>& mappings);
+
 protected:
   // inherited from Application base class.
   virtual void
@@ -57,16 +113,46 @@ protected:
   virtual void
   OnInterest(shared_ptr<const Interest> interest);
 
+private:
+  struct Mapping {
+    Name locator;
+    Block content; // Content TLV with the wire encoding of the locator
+  };
+
+  typedef std::unordered_map<std::string, Mapping> MappingTable;
+
+  const std::string&
+  makeKey(const Name& name, size_t begin, size_t end);
+
+  /**
+   * @brief Apply the batched update, encoded in the name component
+   * @return false if the component cannot be decoded, mappings before the error are applied
+   */
+  bool
+  applyMappings(const name::Component& mappings);
+
+  void
+  SetLocator(Name locator);
+
+  Name
+  GetLocator() const;
+
 private:
   Name m_prefix; // prefix of mapping server
-  // Name m_mobilePrefix; // prefix of MP, supports only one for now, RV needs to respond to trace Interests
+  NamePrefixTable::Id m_updatePrefix; // m_prefix + "update", interned on start
+  NamePrefixTable::Id m_batchPrefix;  // m_prefix + "batch", interned on start
+  Time m_freshness;
+
+  MappingTable m_mappings;
+  std::string m_key;    // reusable buffer for table keys
+  Block m_emptyContent; // Content TLV with the wire encoding of "/", for unknown producers
+  Signature m_dataSignature;
 
   Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
 
 public:
-  Name m_locator; // prefix of MN
-  typedef void (*UpdateCallback)(Ptr<App>);
-  TracedCallback<Ptr<App>> m_updateCallback;
+  typedef void (*UpdateCallback)(Ptr<App> app, const Name& producer, const Name& locator);
+  TracedCallback<Ptr<App>, const Name&, const Name&> m_updateCallback;
 };
 
 } // namespace ndn
@@ -29,6 +29,8 @@
 #include "ns3/integer.h"
 #include "ns3/double.h"
 
+#include "utils/ndn-hop-distance-oracle.hpp"
+
 #include <ndn-cxx/lp/tags.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.kite.KitePullConsumer");
@@ -60,10 +62,6 @@ KitePullConsumer::GetTypeId(void)
                     IntegerValue(std::numeric_limits<uint32_t>::max()),
                     MakeIntegerAccessor(&KitePullConsumer::m_seqMax),
                     MakeIntegerChecker<uint32_t>())
-      .AddAttribute("attachNode", "",
-                    IntegerValue(0),
-                    MakeIntegerAccessor(&KitePullConsumer::m_attachNode),
-                    MakeIntegerChecker<uint32_t>())
 
     ;
 
@@ -80,120 +78,6 @@ KitePullConsumer::KitePullConsumer()
 {
   NS_LOG_FUNCTION_NOARGS();
   m_seqMax = std::numeric_limits<uint32_t>::max();
-
-  for (int i = 0; i < 11; i++)
-    paths[i][i] = 0;
-
-  paths[0][1] = 1;
-  paths[0][2] = 2;
-  paths[0][3] = 1;
-  paths[0][4] = 3;
-  paths[0][5] = 2;
-  paths[0][6] = 4;
-  paths[0][7] = 3;
-  paths[0][8] = 4;
-  paths[0][9] = 5;
-  paths[0][10] = 5;
-  paths[1][0] = 1;
-  paths[1][2] = 1;
-  paths[1][3] = 1;
-  paths[1][4] = 2;
-  paths[1][5] = 2;
-  paths[1][6] = 3;
-  paths[1][7] = 3;
-  paths[1][8] = 4;
-  paths[1][9] = 4;
-  paths[1][10] = 5;
-  paths[2][0] = 2;
-  paths[2][1] = 1;
-  paths[2][3] = 2;
-  paths[2][4] = 1;
-  paths[2][5] = 2;
-  paths[2][6] = 2;
-  paths[2][7] = 3;
-  paths[2][8] = 4;
-  paths[2][9] = 3;
-  paths[2][10] = 4;
-  paths[3][0] = 1;
-  paths[3][1] = 1;
-  paths[3][2] = 2;
-  paths[3][4] = 2;
-  paths[3][5] = 1;
-  paths[3][6] = 3;
-  paths[3][7] = 2;
-  paths[3][8] = 3;
-  paths[3][9] = 4;
-  paths[3][10] = 4;
-  paths[4][0] = 3;
-  paths[4][1] = 2;
-  paths[4][2] = 1;
-  paths[4][3] = 2;
-  paths[4][5] = 1;
-  paths[4][6] = 1;
-  paths[4][7] = 2;
-  paths[4][8] = 3;
-  paths[4][9] = 2;
-  paths[4][10] = 3;
-  paths[5][0] = 2;
-  paths[5][1] = 2;
-  paths[5][2] = 2;
-  paths[5][3] = 1;
-  paths[5][4] = 1;
-  paths[5][6] = 2;
-  paths[5][7] = 1;
-  paths[5][8] = 2;
-  paths[5][9] = 3;
-  paths[5][10] = 3;
-  paths[6][0] = 4;
-  paths[6][1] = 3;
-  paths[6][2] = 2;
-  paths[6][3] = 3;
-  paths[6][4] = 1;
-  paths[6][5] = 2;
-  paths[6][7] = 1;
-  paths[6][8] = 2;
-  paths[6][9] = 1;
-  paths[6][10] = 2;
-  paths[7][0] = 3;
-  paths[7][1] = 3;
-  paths[7][2] = 3;
-  paths[7][3] = 2;
-  paths[7][4] = 2;
-  paths[7][5] = 1;
-  paths[7][6] = 1;
-  paths[7][8] = 1;
-  paths[7][9] = 2;
-  paths[7][10] = 2;
-  paths[8][0] = 4;
-  paths[8][1] = 4;
-  paths[8][2] = 4;
-  paths[8][3] = 3;
-  paths[8][4] = 3;
-  paths[8][5] = 2;
-  paths[8][6] = 2;
-  paths[8][7] = 1;
-  paths[8][9] = 2;
-  paths[8][10] = 1;
-  paths[9][0] = 5;
-  paths[9][1] = 4;
-  paths[9][2] = 3;
-  paths[9][3] = 4;
-  paths[9][4] = 2;
-  paths[9][5] = 3;
-  paths[9][6] = 1;
-  paths[9][7] = 2;
-  paths[9][8] = 2;
-  paths[9][10] = 1;
-  paths[10][0] = 5;
-  paths[10][1] = 5;
-  paths[10][2] = 4;
-  paths[10][3] = 4;
-  paths[10][4] = 3;
-  paths[10][5] = 3;
-  paths[10][6] = 2;
-  paths[10][7] = 2;
-  paths[10][8] = 1;
-  paths[10][9] = 1;
 }
 
 KitePullConsumer::~KitePullConsumer()
@@ -252,7 +136,11 @@ KitePullConsumer::OnData(shared_ptr<const Data> data)
     hopCount = *hopCountTag;
   }
   Name dataName = data->getName();
-  int opHopCount = paths[m_attachNode][dataName[-1].toSequenceNumber()] + 2;
+
+  // the mobile producer puts the id of its AP into the last component, and is one hop behind it
+  uint32_t distance =
+    HopDistanceOracle::get().getDistance(GetNode()->GetId(), dataName[-1].toSequenceNumber());
+  int opHopCount = distance != HopDistanceOracle::UNREACHABLE ? distance + 1 : hopCount;
   NS_LOG_DEBUG("Hop count: " << hopCount << ", best: " << opHopCount);
 
   if (hopCount < opHopCount) {
@@ -85,10 +85,6 @@ protected:
   int m_dataReceived;
   int m_totalHopCount;
   int m_totalOpHopCount;
-
-  int paths[11][11];
-
-  int m_attachNode;
 };
 
 } // namespace ndn
@@ -60,17 +60,43 @@ KitePullMobile::GetTypeId(void)
       .AddAttribute("RefreshInterval",
                     "Interval between trace interests, set to 0 to disable periodic sending",
                     StringValue("1s"), MakeTimeAccessor(&KitePullMobile::m_refreshInterval),
-                    MakeTimeChecker());
+                    MakeTimeChecker())
+      .AddAttribute("AdaptiveRefresh",
+                    "Double the refresh interval each time a trace interest is confirmed",
+                    BooleanValue(false), MakeBooleanAccessor(&KitePullMobile::m_adaptiveRefresh),
+                    MakeBooleanChecker())
+      .AddAttribute("MaxRefreshInterval", "Upper bound of the adaptive refresh interval",
+                    StringValue("8s"), MakeTimeAccessor(&KitePullMobile::m_maxRefreshInterval),
+                    MakeTimeChecker())
+
+      .AddTraceSource("TracingOverhead",
+                      "Messages exchanged with RV, and trace interests saved by adaptive "
+                      "refresh, reported when the application stops",
+                      MakeTraceSourceAccessor(&KitePullMobile::m_tracingOverhead),
+                      "ns3::ndn::KitePullMobile::TracingOverheadCallback")
+      .AddTraceSource("Association", "Associated with a new AP",
+                      MakeTraceSourceAccessor(&KitePullMobile::m_associationTrace),
+                      "ns3::ndn::KitePullMobile::AssociationCallback")
+      .AddTraceSource("TraceSent", "Trace interest has been sent",
+                      MakeTraceSourceAccessor(&KitePullMobile::m_traceSentTrace),
+                      "ns3::ndn::KitePullMobile::TraceSentCallback")
+      .AddTraceSource("TraceConfirmed", "Trace interest has been confirmed by RV",
+                      MakeTraceSourceAccessor(&KitePullMobile::m_traceConfirmedTrace),
+                      "ns3::ndn::KitePullMobile::TraceConfirmedCallback");
   return tid;
 }
 
 KitePullMobile::KitePullMobile()
-  : m_rand(CreateObject<UniformRandomVariable>())
+  : m_adaptiveRefresh(false)
+  , m_rand(CreateObject<UniformRandomVariable>())
+  , m_tracePrefix(NamePrefixTable::INVALID_ID)
+  , m_traceOutstanding(false)
   , m_traceRetryCnt(0)
   , m_rvInterests(0)
   , m_rvData(0)
   , m_interestForData(0)
   , m_data(0)
+  , m_savedTraces(0)
 {
   NS_LOG_FUNCTION_NOARGS();
   m_seq = 1; // don't negotiate
@@ -81,10 +107,16 @@ void
 KitePullMobile::OnAssociation()
 {
   NS_LOG_INFO("> Association done with AP");
+  m_associationTrace(this);
+  m_currentInterval = m_refreshInterval; // producer has moved, refresh at the base rate again
+
   if (!m_negotiationDone)
     StartNegotiation();
-  else
-    Simulator::Schedule(Seconds(0.01), &KitePullMobile::SendTrace, this); // send TI when relocate
+  else {
+    Simulator::Cancel(m_traceEvent);
+    m_traceEvent = Simulator::Schedule(Seconds(0.01), &KitePullMobile::SendTrace,
+                                       this); // send TI when relocate
+  }
 }
 
 // inherited from Application base class.
@@ -93,6 +125,7 @@ KitePullMobile::StartApplication()
 {
   NS_LOG_FUNCTION_NOARGS();
   Producer::StartApplication(); // will register prefix
+  m_currentInterval = m_refreshInterval;
   // SendTrace(); // should be done in OnAssociation
 }
 
@@ -101,10 +134,13 @@ KitePullMobile::StopApplication()
 {
   // NS_LOG_UNCOND ("Tracing Overhead (%): " << (100.0 * (m_rvInterests + m_rvData) / (m_data +
   // + m_rvInterests + m_rvData + m_interestForData))););
-  std::cerr << "Tracing Overhead (number of messages): " << m_rvInterests + m_rvData << std::endl;
-
   NS_LOG_FUNCTION_NOARGS();
 
+  Simulator::Cancel(m_traceEvent);
+
+  CountSavedTraces(0);
+  m_tracingOverhead(this, m_rvInterests + m_rvData, m_savedTraces);
+
   App::StopApplication();
 }
 
@@ -144,37 +180,70 @@ KitePullMobile::SendTrace()
 
   BOOST_ASSERT(m_seq > 0);
 
-  shared_ptr<Name> name = MakeTracePrefix();
-  name->appendSequenceNumber(m_seq);
+  Name name = NamePrefixTable::get().makeName(GetTracePrefix(), m_seq);
 
   m_seq++;
 
+  // trace must outlive the (stretched) interval until the next refresh
+  Time traceLifetime = m_traceLifetime + (m_currentInterval - m_refreshInterval);
+
   shared_ptr<Interest> interest = make_shared<Interest>();
   interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*name);
-  time::milliseconds interestLifeTime(m_traceLifetime.GetMilliSeconds());
+  interest->setName(name);
+  time::milliseconds interestLifeTime(traceLifetime.GetMilliSeconds());
   interest->setInterestLifetime(interestLifeTime);
   m_rvInterests++;
-  NS_LOG_INFO("> Trace Interest sent to " << name->toUri());
+  NS_LOG_INFO("> Trace Interest sent to " << name.toUri());
 
   m_transmittedInterests(interest, this, m_face);
   m_appLink->onReceiveInterest(*interest);
 
-  if (m_traceRefreshEvent.IsRunning())
-    Simulator::Cancel(m_traceRefreshEvent);
-
-  if (m_refreshInterval != 0)
-    m_traceRefreshEvent =
-      Simulator::Schedule(Seconds(m_refreshInterval.GetSeconds()), &KitePullMobile::SendTrace,
-                          this); // Send out trace at fixed intervals
-  
-  if (m_traceTimeoutEvent.IsRunning())
-    Simulator::Cancel(m_traceTimeoutEvent);
-
-  m_traceTimeoutEvent =
-    Simulator::Schedule(Seconds(m_traceLifetime.GetSeconds()), &KitePullMobile::OnTraceTimeout,
-                        this); // Trace interest times out after a specified period, will retry with
-                               // new seq
+  CountSavedTraces(1);
+  m_traceSent = Simulator::Now();
+  m_traceOutstanding = true;
+  m_traceSentTrace(this, m_seq - 1);
+
+  ScheduleTraceTimer(); // Send out trace at refresh interval, or retry with new seq on timeout
+}
+
+void
+KitePullMobile::ScheduleTraceTimer()
+{
+  Simulator::Cancel(m_traceEvent);
+
+  Time next = m_traceSent + m_traceLifetime;
+  if (m_currentInterval != 0) {
+    next = m_traceOutstanding ? std::min(next, m_traceSent + m_currentInterval)
+                              : m_traceSent + m_currentInterval;
+  }
+  else if (!m_traceOutstanding) {
+    return; // periodic sending disabled
+  }
+
+  m_traceEvent = Simulator::Schedule(next - Simulator::Now(), &KitePullMobile::OnTraceTimer, this);
+}
+
+void
+KitePullMobile::OnTraceTimer()
+{
+  if (m_traceOutstanding
+      && (m_currentInterval == 0 || Simulator::Now() < m_traceSent + m_currentInterval))
+    OnTraceTimeout();
+  else
+    SendTrace();
+}
+
+void
+KitePullMobile::CountSavedTraces(uint64_t sentTraces)
+{
+  if (!m_adaptiveRefresh || m_refreshInterval == 0 || m_traceSent.IsZero())
+    return;
+
+  // trace interests that fixed RefreshInterval would have sent since the last one
+  uint64_t fixedTraces =
+    (Simulator::Now() - m_traceSent).GetInteger() / m_refreshInterval.GetInteger();
+  if (fixedTraces > sentTraces)
+    m_savedTraces += fixedTraces - sentTraces;
 }
 
 void
@@ -220,17 +289,25 @@ KitePullMobile::OnData(shared_ptr<const Data> data)
     return;
   }
 
-  Simulator::Cancel(m_traceTimeoutEvent);       // stop timeout timer
   Simulator::Cancel(m_negotiationTimeoutEvent); // no need to retry negotiation
 
   m_traceRetryCnt = 0;
+  m_traceOutstanding = false;
+  m_traceConfirmedTrace(this, seq, Simulator::Now() - m_traceSent);
+  if (m_adaptiveRefresh && m_currentInterval != 0) {
+    // still attached, trace is confirmed, refresh less often
+    m_currentInterval = std::min(m_currentInterval * 2, m_maxRefreshInterval);
+  }
+  ScheduleTraceTimer(); // stop timeout timer
 }
 
 void
 KitePullMobile::OnTraceTimeout()
 {
   NS_LOG_INFO("Trace interest timed out " << m_seq - 1);
-  Simulator::Cancel(m_traceRefreshEvent);
+  Simulator::Cancel(m_traceEvent);
+  m_traceOutstanding = false;
+  m_currentInterval = m_refreshInterval;
 
   if (m_traceRetryCnt >= 3) {
     m_traceRetryCnt = 0;
@@ -254,13 +331,16 @@ KitePullMobile::OnNegotiationTimeout()
   StartNegotiation();
 }
 
-shared_ptr<Name>
-KitePullMobile::MakeTracePrefix()
+NamePrefixTable::Id
+KitePullMobile::GetTracePrefix()
 {
-  shared_ptr<Name> tracePrefix = make_shared<Name>(m_rvPrefix); // e.g. /rv
-  tracePrefix->append("trace");
-  tracePrefix->append(m_dataPrefix); // e.g. /alice/photo
-  return tracePrefix;                // e.g. /rv/trace/alice/photo
+  if (m_tracePrefix == NamePrefixTable::INVALID_ID) {
+    Name tracePrefix(m_rvPrefix); // e.g. /rv
+    tracePrefix.append("trace");
+    tracePrefix.append(m_dataPrefix); // e.g. /alice/photo
+    m_tracePrefix = NamePrefixTable::get().intern(tracePrefix); // e.g. /rv/trace/alice/photo
+  }
+  return m_tracePrefix;
 }
 
 void
@@ -293,19 +373,8 @@ KitePullMobile::OnInterest(shared_ptr<const Interest> interest)
   data->setName(dataName);
   data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
-  data->setContent(make_shared<::ndn::Buffer>(m_virtualPayloadSize));
-
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast<::ndn::tlv::SignatureTypeValue>(255));
-
-  if (m_keyLocator.size() > 0) {
-    signatureInfo.setKeyLocator(m_keyLocator);
-  }
-
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-
-  data->setSignature(signature);
+  data->setContent(m_payload);
+  data->setSignature(m_dataSignature);
 
   NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
@@ -27,6 +27,7 @@
 #include "ns3/ptr.h"
 
 #include "ns3/ndnSIM/apps/ndn-producer.hpp"
+#include "ns3/ndnSIM/utils/ndn-name-prefix-table.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -34,8 +35,10 @@ namespace ndn {
 /**
  * a mobile producer used in Pull scenario
  * - sends TI periodically
+ * - with AdaptiveRefresh, doubles the refresh interval (up to MaxRefreshInterval) each time a TI
+ *   is confirmed, and returns to RefreshInterval when associated with a new AP or when a TI times
+ *   out; TI lifetime is stretched together with the interval
  * - (todo) adjust TI sending when receives Interest (assuming routers do prolongTrace)
- * - (todo) set TI lifetime to estimation of stay
  */
 class KitePullMobile : public Producer {
 public:
@@ -63,13 +66,18 @@ public:
   void
   OnTraceTimeout(); // TI times out, should not happen, and if due to relocation, will send when associated
 
+  typedef void (*TracingOverheadCallback)(Ptr<App> app, uint64_t messages, uint64_t savedTraces);
+  typedef void (*AssociationCallback)(Ptr<App> app);
+  typedef void (*TraceSentCallback)(Ptr<App> app, uint64_t seq);
+  typedef void (*TraceConfirmedCallback)(Ptr<App> app, uint64_t seq, Time rtt);
+
   // TODO: OnNack()
 
   void
   OnNegotiationTimeout(); // retry negotiation until success
 
-  shared_ptr<Name>
-  MakeTracePrefix();
+  NamePrefixTable::Id
+  GetTracePrefix(); // interned on first use, e.g. /rv/trace/alice/photo
 
 protected:
   // inherited from Application base class.
@@ -80,18 +88,34 @@ protected:
   StopApplication(); // Called at time specified by Stop
 
 private:
+  void
+  OnTraceTimer(); // refresh the trace, or time out the outstanding TI
+
+  void
+  ScheduleTraceTimer(); // reschedule the timer for the next refresh or timeout
+
+  void
+  CountSavedTraces(uint64_t sentTraces); // TIs saved since the last one, compared to fixed
+                                         // RefreshInterval, sentTraces are sent now
+
   Name m_rvPrefix; // prefix of RV, /rv
   Name m_dataPrefix; // prefix of data to be uploaded, e.g. /alice/photo, producer prefix in paper
 
   Time m_traceLifetime; // lifeTime for trace interest
   Time m_refreshInterval; // interval between trace interests
+  bool m_adaptiveRefresh; // stretch refresh interval while traces are confirmed
+  Time m_maxRefreshInterval; // upper bound of the stretched refresh interval
+  Time m_currentInterval; // current refresh interval, m_refreshInterval unless stretched
 
   Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
 
   uint64_t m_seq; // increments each time new trace interest is sent, initiated after negotiation
+  NamePrefixTable::Id m_tracePrefix;
 
-  EventId m_traceRefreshEvent; // send new trace interest at fixed interval, unless previous trace interest fetched invalid data or times out.
-  EventId m_traceTimeoutEvent; // triggered when interest times out, use trace Interest lifetime
+  EventId m_traceEvent; // send new trace interest after m_currentInterval, or time out the
+                        // outstanding one after m_traceLifetime, whichever comes first
+  Time m_traceSent; // when the last trace interest was sent
+  bool m_traceOutstanding; // last trace interest has not been confirmed yet
 
   int m_traceRetryCnt; // retry up to 3 times for sending trace Interest
 
@@ -103,6 +127,12 @@ private:
   int m_rvData; // data received from RV
   int m_interestForData; // Interest for Data from consumer
   int m_data; // data packets sent to the consumer
+  uint64_t m_savedTraces; // trace interests saved by adaptive refresh
+
+  TracedCallback<Ptr<App>, uint64_t, uint64_t> m_tracingOverhead;
+  TracedCallback<Ptr<App>> m_associationTrace;
+  TracedCallback<Ptr<App>, uint64_t> m_traceSentTrace;
+  TracedCallback<Ptr<App>, uint64_t, Time> m_traceConfirmedTrace;
 
 public:
   int m_current;
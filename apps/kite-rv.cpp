@@ -52,24 +52,58 @@ KiteRv::GetTypeId(void)
 
       .AddAttribute("RvPrefix", "Prefix of Rendezvous Point", StringValue("/rv"),
                     MakeNameAccessor(&KiteRv::m_rvPrefix), MakeNameChecker())
-      // .AddAttribute("MobilePrefix", "Prefix of Mobile Producer", StringValue("/alice"),
-      //               MakeNameAccessor(&KiteRv::m_mobilePrefix), MakeNameChecker())
       .AddAttribute("InstancePrefix", "Unique prefix of the instance", StringValue("/rv"),
                     MakeNameAccessor(&KiteRv::m_instancePrefix), MakeNameChecker())
-
-      .AddTraceSource("AttachedCallback", "AttachedCallback",
+      .AddAttribute("BufferCapacity",
+                    "Maximum number of consumer Interests queued for one mobile producer",
+                    UintegerValue(40), MakeUintegerAccessor(&KiteRv::m_bufferCapacity),
+                    MakeUintegerChecker<uint32_t>())
+      .AddAttribute("BufferLifetime", "Time after which a queued consumer Interest is dropped",
+                    TimeValue(Seconds(1)), MakeTimeAccessor(&KiteRv::m_bufferLifetime),
+                    MakeTimeChecker())
+      .AddAttribute("TraceBatchWindow",
+                    "Time trace Interests are collected to be answered together, 0 to answer "
+                    "each one immediately",
+                    TimeValue(Seconds(0)), MakeTimeAccessor(&KiteRv::m_traceBatchWindow),
+                    MakeTimeChecker())
+
+      .AddTraceSource("AttachedCallback",
+                      "Mobile producer has sent a trace Interest to this RV",
                       MakeTraceSourceAccessor(&KiteRv::m_attachCallback),
-                      "ns3::ndn::KiteRv::AttachCallback");
+                      "ns3::ndn::KiteRv::AttachCallback")
+      .AddTraceSource("InterestBuffered",
+                      "Consumer Interest has been queued until the next trace of the producer",
+                      MakeTraceSourceAccessor(&KiteRv::m_interestBuffered),
+                      "ns3::ndn::KiteRv::AttachCallback")
+      .AddTraceSource("BufferedInterestSent", "Queued consumer Interest has been sent out",
+                      MakeTraceSourceAccessor(&KiteRv::m_bufferedInterestSent),
+                      "ns3::ndn::KiteRv::BufferedInterestSentCallback");
   return tid;
 }
 
+KiteRv::ProducerState::ProducerState()
+  : isn(0)
+  , attachedPrefix("/")
+  , head(0)
+  , nBuffered(0)
+  , traceBatch(0)
+{
+}
+
 KiteRv::KiteRv()
-  : m_rand(CreateObject<UniformRandomVariable>())
-  , m_isn(0)
-  , m_attached(false)
-  , m_attachedPrefix("/")
+  : m_negotiationPrefix(NamePrefixTable::INVALID_ID)
+  , m_tracePrefix(NamePrefixTable::INVALID_ID)
+  , m_bufferCapacity(40)
+  , m_bufferLifetime(Seconds(1))
+  , m_rand(CreateObject<UniformRandomVariable>())
+  , m_traceBatchWindow(Seconds(0))
+  , m_nTraceBatches(0)
 {
   NS_LOG_FUNCTION_NOARGS();
+
+  // content of trace replies is the same for all producers
+  const uint8_t traceDigest[32] = {};
+  m_traceContent = ::ndn::makeBinaryBlock(::ndn::tlv::Content, traceDigest, sizeof(traceDigest));
 }
 
 // inherited from Application base class.
@@ -80,9 +114,18 @@ KiteRv::StartApplication()
 
   App::StartApplication();
 
-  FibHelper::AddRoute(GetNode(), m_rvPrefix, m_face, 0);
-  // FibHelper::AddRoute(GetNode(), m_mobilePrefix, m_face, 0);
-  FibHelper::AddRoute(GetNode(), m_instancePrefix, m_face, 0);
+  RegisterPrefix(m_rvPrefix);
+  RegisterPrefix(m_instancePrefix);
+
+  m_negotiationPrefix = NamePrefixTable::get().intern(Name(m_rvPrefix).append("negotiate"));
+  m_tracePrefix = NamePrefixTable::get().intern(Name(m_rvPrefix).append("trace"));
+
+  // signature is the same in all responses, so it is created only once
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+  signatureInfo.wireEncode();
+
+  m_dataSignature.setInfo(signatureInfo);
+  m_dataSignature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
 }
 
 void
@@ -90,9 +133,77 @@ KiteRv::StopApplication()
 {
   NS_LOG_FUNCTION_NOARGS();
 
+  Simulator::Cancel(m_expiryEvent);
+  Simulator::Cancel(m_traceBatchEvent);
+  m_traceBatch.clear();
+
   App::StopApplication();
 }
 
+void
+KiteRv::SetAttachment(const Name& producer, const Name& attachedPrefix)
+{
+  insertProducer(producer, 0, producer.size()).attachedPrefix = attachedPrefix;
+}
+
+Name
+KiteRv::GetAttachment(const Name& producer) const
+{
+  std::string key;
+  for (const auto& component : producer) {
+    key.append(reinterpret_cast<const char*>(component.wire()), component.size());
+  }
+
+  auto entry = m_producers.find(key);
+  if (entry == m_producers.end()) {
+    return "/";
+  }
+  return entry->second.attachedPrefix;
+}
+
+KiteRv::ProducerState*
+KiteRv::findProducer(const Name& name, size_t begin, size_t end)
+{
+  m_key.clear();
+  for (size_t i = begin; i < end; i++) {
+    m_key.append(reinterpret_cast<const char*>(name[i].wire()), name[i].size());
+  }
+
+  auto entry = m_producers.find(m_key);
+  return entry == m_producers.end() ? nullptr : &entry->second;
+}
+
+KiteRv::ProducerState&
+KiteRv::insertProducer(const Name& name, size_t begin, size_t end)
+{
+  ProducerState* producer = findProducer(name, begin, end);
+  if (producer != nullptr) {
+    return *producer;
+  }
+
+  ProducerState& newProducer = m_producers[m_key];
+  newProducer.prefix = name.getSubName(begin, end - begin);
+  NS_LOG_DEBUG("New mobile producer: " << newProducer.prefix << ", total " << m_producers.size());
+  return newProducer;
+}
+
+KiteRv::ProducerState*
+KiteRv::matchProducer(const Name& name)
+{
+  ProducerState* match = nullptr;
+
+  m_key.clear();
+  for (size_t i = m_rvPrefix.size(); i < name.size(); i++) {
+    m_key.append(reinterpret_cast<const char*>(name[i].wire()), name[i].size());
+
+    auto entry = m_producers.find(m_key);
+    if (entry != m_producers.end()) {
+      match = &entry->second;
+    }
+  }
+  return match;
+}
+
 void
 KiteRv::OnInterest(shared_ptr<const Interest> interest)
 {
@@ -103,42 +214,54 @@ KiteRv::OnInterest(shared_ptr<const Interest> interest)
   if (!m_active)
     return;
 
-  Name dataName(interest->getName());
-  auto data = make_shared<Data>();
-  data->setName(dataName);
-  data->setFreshnessPeriod(::ndn::time::milliseconds(0));
-
-  Name negPrefix = m_rvPrefix;
-  negPrefix.append("negotiate");
+  const Name& interestName = interest->getName();
+  const Name& negPrefix = NamePrefixTable::get().getPrefix(m_negotiationPrefix);
+  const Name& tracePrefix = NamePrefixTable::get().getPrefix(m_tracePrefix);
 
-  Name tracePrefix = m_rvPrefix;
-  tracePrefix.append("trace");
+  if (negPrefix.isPrefixOf(interestName)) {
+    // negotiation interest, e.g. /rv/negotiate/alice/photo
+    ProducerState& producer = insertProducer(interestName, negPrefix.size(), interestName.size());
+    producer.isn = m_rand->GetValue(1, std::numeric_limits<uint32_t>::max()); // must > 0
 
-  if (negPrefix.isPrefixOf(dataName)) {
-    // negotiation interest
-    m_isn = m_rand->GetValue(1, std::numeric_limits<uint32_t>::max()); // must > 0
-
-    data->setContent((uint8_t *)&m_isn, sizeof(m_isn));
+    NS_LOG_INFO("node(" << GetNode()->GetId() << ") ISN of " << producer.prefix << ": "
+                        << producer.isn);
+    reply(*interest, ::ndn::makeBinaryBlock(::ndn::tlv::Content,
+                                            reinterpret_cast<const uint8_t*>(&producer.isn),
+                                            sizeof(producer.isn)));
   }
-  else if (tracePrefix.isPrefixOf(dataName)) {
-    // received TI
-    uint64_t seq = dataName.at(-1).toSequenceNumber();
-    if (seq < m_isn) {
-      NS_LOG_ERROR("Invalid sequence number, ignoring...");
+  else if (tracePrefix.isPrefixOf(interestName)) {
+    // received TI, e.g. /rv/trace/alice/photo/<seq>
+    if (interestName.size() <= tracePrefix.size() + 1) {
+      NS_LOG_ERROR("Trace Interest without producer prefix, ignoring...");
       return;
     }
 
-    data->setContent(make_shared< ::ndn::Buffer>(32)); // td 
+    ProducerState& producer =
+      insertProducer(interestName, tracePrefix.size(), interestName.size() - 1);
+    uint64_t seq = interestName.at(-1).toSequenceNumber();
+    if (seq < producer.isn) {
+      NS_LOG_ERROR("Invalid sequence number, ignoring...");
+      return;
+    }
 
-    sendBuffered(); // new trace, send out bufferd interests
+    if (m_traceBatchWindow.IsStrictlyPositive()) {
+      m_traceBatch.push_back(PendingTrace{interest, &producer});
+      if (!m_traceBatchEvent.IsRunning()) {
+        m_traceBatchEvent = Simulator::Schedule(m_traceBatchWindow, &KiteRv::flushTraces, this);
+      }
+      return;
+    }
 
-    m_attachCallback(this); // update attachment information globally
+    onTrace(producer);
+    reply(*interest, m_traceContent);
   }
-  else if (m_rvPrefix.isPrefixOf(dataName)) {
+  else if (m_rvPrefix.isPrefixOf(interestName)) {
     // consumer Interest for the MP
+    ProducerState* producer = matchProducer(interestName);
+
     if (!interest->hasLink()) {
       // this is the access RV
-      if (m_attached || m_attachedPrefix == "/") {
+      if (producer == nullptr || isAttached(*producer) || producer->attachedPrefix == "/") {
         // also the attach RV, do nothing, will be forwarded according to traces
         return;
       }
@@ -146,97 +269,185 @@ KiteRv::OnInterest(shared_ptr<const Interest> interest)
       // not attach RV, append forwarding hint, send out
       shared_ptr<Interest> hinted = make_shared<Interest>(interest->wireEncode());
       hinted->setNonce(interest->getNonce() + 1);
-      ::ndn::Link link;
-      link.addDelegation(1, m_attachedPrefix);
-      ndn::StackHelper::getKeyChain().sign(link, ::ndn::security::SigningInfo(::ndn::security::SigningInfo::SIGNER_TYPE_SHA256));
-      hinted->setLink(link.wireEncode());
+      hinted->setLink(getLink(*producer));
 
       m_appLink->onReceiveInterest(*hinted);
-      NS_LOG_DEBUG("Redirected consumer Interest with hint: " << link.getDelegations().begin()->second);
+      NS_LOG_DEBUG("Redirected consumer Interest with hint: " << producer->attachedPrefix);
     }
     else {
       // should be for this RV
       BOOST_ASSERT(interest->getLink().getDelegations().begin()->second == m_instancePrefix);
-      if (!m_attached) {
-        BOOST_ASSERT(m_attachedPrefix != m_instancePrefix);
+      if (producer == nullptr) {
+        NS_LOG_DEBUG("Hinted Interest for unknown mobile producer, ignoring: " << interestName);
+        return;
+      }
+
+      if (!isAttached(*producer)) {
         // correct the hint and send out
         shared_ptr<Interest> hinted = make_shared<Interest>(interest->wireEncode());
         hinted->setNonce(interest->getNonce() + 1);
         hinted->unsetLink();
-        ::ndn::Link link;
-        link.addDelegation(1, m_attachedPrefix);
-        ndn::StackHelper::getKeyChain().sign(link,
-                                             ::ndn::security::SigningInfo(
-                                               ::ndn::security::SigningInfo::SIGNER_TYPE_SHA256));
-        hinted->setLink(link.wireEncode());
+        hinted->setLink(getLink(*producer));
 
         m_appLink->onReceiveInterest(*hinted);
-        NS_LOG_DEBUG(
-          "Redirected consumer Interest with corrected hint: " << link.getDelegations().begin()->second);
-        return;
+        NS_LOG_DEBUG("Redirected consumer Interest with corrected hint: "
+                     << producer->attachedPrefix);
       }
       else {
         // trace is dead, buffer and send out after TI comes, or update comes
-      NS_LOG_DEBUG("To be buffered: " << interest->getName());        
-        if (m_bufferedInterests.size() < 40) {
-          m_bufferedInterests.push_back(std::make_pair<shared_ptr<Interest>, Time>(make_shared<Interest>(interest->wireEncode()), Simulator::Now()));
-        }
-        return;
+        NS_LOG_DEBUG("To be buffered: " << interestName);
+        bufferInterest(*producer, make_shared<Interest>(interest->wireEncode()));
       }
-      // remove hint, and forward
-      shared_ptr<Interest> raw = make_shared<Interest>(interest->wireEncode());
-      raw->unsetLink();
-      raw->setNonce(interest->getNonce() + 1);
-
-      m_appLink->onReceiveInterest(*raw);
-      NS_LOG_DEBUG("Removed hint from consumer Interest and sent out: " << m_instancePrefix);
     }
     // never send data back
-    return;
-  }
-  else {
-    return;
   }
+}
 
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+void
+KiteRv::onTrace(ProducerState& producer)
+{
+  sendBuffered(producer); // new trace, send out bufferd interests
+
+  m_attachCallback(this, producer.prefix); // update attachment information globally
+}
 
-  // if (m_keyLocator.size() > 0) {
-  //   signatureInfo.setKeyLocator(m_keyLocator);
-  // }
+void
+KiteRv::flushTraces()
+{
+  NS_LOG_DEBUG("Answering batch of " << m_traceBatch.size() << " trace Interests");
+
+  m_nTraceBatches++;
+  for (const PendingTrace& trace : m_traceBatch) {
+    if (trace.producer->traceBatch != m_nTraceBatches) {
+      // first trace of the producer in this batch
+      trace.producer->traceBatch = m_nTraceBatches;
+      onTrace(*trace.producer);
+    }
+    reply(*trace.interest, m_traceContent);
+  }
+  m_traceBatch.clear();
+}
 
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+void
+KiteRv::reply(const Interest& interest, const Block& content)
+{
+  auto data = make_shared<Data>();
+  data->setName(interest.getName());
+  data->setFreshnessPeriod(::ndn::time::milliseconds(0));
 
-  data->setSignature(signature);
+  data->setContent(content);
+  data->setSignature(m_dataSignature);
 
-  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName() << ", ISN=" << m_isn);
+  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
   // to create real wire encoding
   data->wireEncode();
 
   m_transmittedDatas(data, this, m_face);
   m_appLink->onReceiveData(*data);
+}
+
+const Block&
+KiteRv::getLink(ProducerState& producer)
+{
+  if (!producer.link.hasWire() || producer.linkPrefix != producer.attachedPrefix) {
+    ::ndn::Link link;
+    link.addDelegation(1, producer.attachedPrefix);
+    ndn::StackHelper::getKeyChain().sign(link, ::ndn::security::SigningInfo(
+                                                 ::ndn::security::SigningInfo::SIGNER_TYPE_SHA256));
+    producer.link = link.wireEncode();
+    producer.linkPrefix = producer.attachedPrefix;
+    NS_LOG_DEBUG("Signed new forwarding hint for " << producer.prefix << ": "
+                                                   << producer.attachedPrefix);
+  }
+  return producer.link;
+}
+
+void
+KiteRv::bufferInterest(ProducerState& producer, shared_ptr<Interest> interest)
+{
+  if (producer.nBuffered == 0 && producer.buffer.size() != m_bufferCapacity) {
+    // first use, or BufferCapacity has been changed
+    producer.buffer.resize(m_bufferCapacity);
+    producer.head = 0;
+  }
+
+  if (producer.nBuffered >= producer.buffer.size()) {
+    NS_LOG_DEBUG("Queue of " << producer.prefix << " is full, dropping " << interest->getName());
+    return;
+  }
+
+  Time now = Simulator::Now();
+  size_t tail = (producer.head + producer.nBuffered) % producer.buffer.size();
+  producer.buffer[tail].interest = std::move(interest);
+  producer.buffer[tail].arrival = now;
+  producer.nBuffered++;
+  m_interestBuffered(this, producer.prefix);
 
+  m_expiryQueue.push_back(std::make_pair(now + m_bufferLifetime, &producer));
+  if (!m_expiryEvent.IsRunning()) {
+    m_expiryEvent = Simulator::Schedule(m_bufferLifetime, &KiteRv::expireBuffered, this);
+  }
+}
+
+void
+KiteRv::sendBuffered(const Name& producer)
+{
+  ProducerState* state = findProducer(producer, 0, producer.size());
+  if (state != nullptr) {
+    sendBuffered(*state);
+  }
 }
 
 void
-KiteRv::sendBuffered()
-{
-  ::ndn::Link link;
-  link.addDelegation(1, m_attachedPrefix);
-  ndn::StackHelper::getKeyChain().sign(link, ::ndn::security::SigningInfo(
-                                               ::ndn::security::SigningInfo::SIGNER_TYPE_SHA256));
-  for (auto it = m_bufferedInterests.begin(); it != m_bufferedInterests.end(); ++it) {
-    if (Simulator::Now() - it->second > Seconds(1))
+KiteRv::sendBuffered(ProducerState& producer)
+{
+  if (producer.nBuffered == 0)
+    return;
+
+  const Block& link = getLink(producer);
+  Time now = Simulator::Now();
+  for (; producer.nBuffered > 0; producer.nBuffered--) {
+    BufferedInterest& entry = producer.buffer[producer.head];
+    producer.head = (producer.head + 1) % producer.buffer.size();
+
+    shared_ptr<Interest> p = std::move(entry.interest);
+    if (now - entry.arrival > m_bufferLifetime)
       continue;
-    auto p = it->first;
+
     p->setNonce(p->getNonce() + 1);
     p->unsetLink();
-    p->setLink(link.wireEncode());
+    p->setLink(link);
     m_appLink->onReceiveInterest(*p);
+    m_bufferedInterestSent(this, producer.prefix, now - entry.arrival);
+  }
+  // entries of the expiration queue, referring to this producer, are skipped on expiration
+}
+
+void
+KiteRv::expireBuffered()
+{
+  Time now = Simulator::Now();
+
+  while (!m_expiryQueue.empty() && m_expiryQueue.front().first <= now) {
+    ProducerState& producer = *m_expiryQueue.front().second;
+    m_expiryQueue.pop_front();
+
+    // the queue of the producer is ordered by arrival, so only its head can be expired
+    while (producer.nBuffered > 0
+           && now - producer.buffer[producer.head].arrival >= m_bufferLifetime) {
+      NS_LOG_DEBUG("Expired queued Interest "
+                   << producer.buffer[producer.head].interest->getName());
+      producer.buffer[producer.head].interest.reset();
+      producer.head = (producer.head + 1) % producer.buffer.size();
+      producer.nBuffered--;
+    }
+  }
+
+  if (!m_expiryQueue.empty()) {
+    m_expiryEvent =
+      Simulator::Schedule(m_expiryQueue.front().first - now, &KiteRv::expireBuffered, this);
   }
-  m_bufferedInterests.clear();
 }
 
 } // namespace ndn
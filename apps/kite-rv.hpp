@@ -27,17 +27,32 @@
 #include "ns3/ptr.h"
 
 #include "ns3/ndnSIM/apps/ndn-app.hpp"
+#include "ns3/ndnSIM/utils/ndn-name-prefix-table.hpp"
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
 
 /**
  * @ingroup ndn-apps
- * @brief A simple Interest-sink applia simple Interest-sink application
+ * @brief Rendezvous point (RV) of KITE mobile producers
+ *
+ * The RV answers ISN negotiation and trace Interests of mobile producers, and redirects consumer
+ * Interests for a mobile producer with a forwarding hint towards the RV, to which the producer is
+ * currently attached.
  *
- * A simple Interest-sink.
- * It also sends out trace interest periodically to corresponding RV to update it's location in the network.
- * In upload scenario, this should run on a mobile node.
+ * State is kept separately for each mobile producer, in a hash table keyed by the producer
+ * prefix (name under RvPrefix, e.g., /alice/photo for /rv/trace/alice/photo/<seq>): ISN, current
+ * attachment, signed forwarding hint, and a bounded queue of consumer Interests waiting for a new
+ * trace.  Queued Interests older than BufferLifetime are expired by a single timer per RV.
+ *
+ * Replies to trace Interests are built from a pre-encoded content and signature.  If
+ * TraceBatchWindow is positive, trace Interests arriving within the window are answered together
+ * at its end, and queued Interests are sent out and the attachment is announced only once per
+ * producer in the batch, e.g., when many producers hand off at once.
  */
 class KiteRv : public App {
 public:
@@ -46,8 +61,36 @@ public:
 
   KiteRv();
 
+  /**
+   * @brief Record that the mobile producer is attached to the RV with the instance prefix
+   * @param producer prefix of the mobile producer, e.g., /alice/photo
+   * @param attachedPrefix instance prefix of the attachment RV, m_instancePrefix if the producer
+   *                       is attached to this RV
+   */
+  void
+  SetAttachment(const Name& producer, const Name& attachedPrefix);
+
+  /**
+   * @brief Get instance prefix of the RV, to which the mobile producer is attached
+   * @return "/" if the attachment of the producer is not known
+   */
+  Name
+  GetAttachment(const Name& producer) const;
+
+  /**
+   * @brief Send out Interests queued for the mobile producer, with the current forwarding hint
+   */
   void
-  sendBuffered();
+  sendBuffered(const Name& producer);
+
+  /**
+   * @brief Get number of mobile producers, for which the RV keeps state
+   */
+  size_t
+  GetNProducers() const
+  {
+    return m_producers.size();
+  }
 
 protected:
   // inherited from Application base class.
@@ -60,27 +103,138 @@ protected:
   virtual void
   OnInterest(shared_ptr<const Interest> interest);
 
+private:
+  struct BufferedInterest {
+    shared_ptr<Interest> interest;
+    Time arrival;
+  };
+
+  struct ProducerState {
+    ProducerState();
+
+    Name prefix;         // e.g. /alice/photo
+    uint64_t isn;        // ISN negotiated with the producer, 0 if none
+    Name attachedPrefix; // instance prefix of the attachment RV, "/" if not known
+
+    Name linkPrefix; // attachment prefix, for which link has been signed
+    Block link;      // cached signed Link, empty if not yet signed
+
+    // ring buffer of Interests waiting for a new trace, in the order of arrival
+    std::vector<BufferedInterest> buffer; // allocated on first use
+    size_t head;
+    size_t nBuffered;
+
+    uint64_t traceBatch; // last batch of trace Interests, in which the producer has been seen
+  };
+
+  struct PendingTrace {
+    shared_ptr<const Interest> interest;
+    ProducerState* producer;
+  };
+
+  typedef std::unordered_map<std::string, ProducerState> ProducerTable;
+
+  /**
+   * @brief Find state of the producer, whose prefix consists of name components [begin, end)
+   */
+  ProducerState*
+  findProducer(const Name& name, size_t begin, size_t end);
+
+  /**
+   * @brief Find or create state of the producer, whose prefix consists of components [begin, end)
+   */
+  ProducerState&
+  insertProducer(const Name& name, size_t begin, size_t end);
+
+  /**
+   * @brief Find state of the producer with the longest prefix of the name after RvPrefix
+   */
+  ProducerState*
+  matchProducer(const Name& name);
+
+  bool
+  isAttached(const ProducerState& producer) const
+  {
+    return producer.attachedPrefix == m_instancePrefix;
+  }
+
+  /**
+   * @brief Get signed Link with the single delegation to the attachment RV of the producer
+   *
+   * The Link is signed only when the attachment prefix differs from the one of the cached Link,
+   * i.e., once per mobility event, instead of once per redirected Interest.
+   */
+  const Block&
+  getLink(ProducerState& producer);
+
+  void
+  bufferInterest(ProducerState& producer, shared_ptr<Interest> interest);
+
+  void
+  sendBuffered(ProducerState& producer);
+
+  /**
+   * @brief Drop queued Interests older than BufferLifetime and reschedule the expiration timer
+   */
+  void
+  expireBuffered();
+
+  /**
+   * @brief Send out queued Interests and announce the attachment of the producer after its trace
+   */
+  void
+  onTrace(ProducerState& producer);
+
+  /**
+   * @brief Answer trace Interests of the current batch
+   */
+  void
+  flushTraces();
+
+  /**
+   * @brief Respond to the Interest with Data carrying the content and the common signature
+   */
+  void
+  reply(const Interest& interest, const Block& content);
+
 private:
   Name m_rvPrefix; // prefix of RV
-  // Name m_mobilePrefix; // prefix of MP, supports only one for now, RV needs to respond to trace Interests
+  NamePrefixTable::Id m_negotiationPrefix; // m_rvPrefix + "negotiate", interned on start
+  NamePrefixTable::Id m_tracePrefix; // m_rvPrefix + "trace", interned on start
+
+  uint32_t m_bufferCapacity; // maximum number of Interests queued for one producer
+  Time m_bufferLifetime;     // maximum time an Interest stays in the queue
 
   Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
-  
-  uint64_t m_isn;
 
-public:
-  typedef void (*AttachCallback)(Ptr<App>);
-  TracedCallback<Ptr<App>> m_attachCallback;
+  ProducerTable m_producers;
+  std::string m_key; // reusable buffer for table keys
 
-  Name m_instancePrefix; // unique prefix of the instance
+  // producers in the order Interests have been queued, to expire queued Interests in time order
+  // (producer states are never removed, and references to them stay valid on rehashing)
+  std::deque<std::pair<Time, ProducerState*>> m_expiryQueue;
+  EventId m_expiryEvent;
+
+  Time m_traceBatchWindow; // time trace Interests are collected before being answered, 0 if none
+  std::vector<PendingTrace> m_traceBatch;
+  uint64_t m_nTraceBatches;
+  EventId m_traceBatchEvent;
+
+  Block m_traceContent; // pre-encoded content of trace replies
+  Signature m_dataSignature;
 
-  bool m_attached; // whether an MP is attached to this RV
-  Name m_attachedPrefix; // the prefix of the current attachment RV
+public:
+  typedef void (*AttachCallback)(Ptr<App> app, const Name& producer);
+  TracedCallback<Ptr<App>, const Name&> m_attachCallback;
+
+  typedef void (*BufferedInterestSentCallback)(Ptr<App> app, const Name& producer, Time wait);
+  TracedCallback<Ptr<App>, const Name&> m_interestBuffered;
+  TracedCallback<Ptr<App>, const Name&, Time> m_bufferedInterestSent;
 
-  std::list<std::pair<shared_ptr<Interest>, Time>> m_bufferedInterests;
+  Name m_instancePrefix; // unique prefix of the instance
 };
 
 } // namespace ndn
 } // namespace ns3
 
-#endif // NDN_PRODUCER_H
+#endif // KITE_RV_H
@@ -62,15 +62,41 @@ KiteUploadMobile::GetTypeId(void)
       .AddAttribute("RefreshInterval",
                     "Interval between trace interests, set to 0 to disable periodic sending",
                     StringValue("1s"), MakeTimeAccessor(&KiteUploadMobile::m_refreshInterval),
-                    MakeTimeChecker());
+                    MakeTimeChecker())
+      .AddAttribute("AdaptiveRefresh",
+                    "Double the refresh interval each time a trace interest is confirmed",
+                    BooleanValue(false), MakeBooleanAccessor(&KiteUploadMobile::m_adaptiveRefresh),
+                    MakeBooleanChecker())
+      .AddAttribute("MaxRefreshInterval", "Upper bound of the adaptive refresh interval",
+                    StringValue("8s"), MakeTimeAccessor(&KiteUploadMobile::m_maxRefreshInterval),
+                    MakeTimeChecker())
+
+      .AddTraceSource("TracingOverhead",
+                      "Messages exchanged with RV, and trace interests saved by adaptive "
+                      "refresh, reported when the application stops",
+                      MakeTraceSourceAccessor(&KiteUploadMobile::m_tracingOverhead),
+                      "ns3::ndn::KiteUploadMobile::TracingOverheadCallback")
+      .AddTraceSource("Association", "Associated with a new AP",
+                      MakeTraceSourceAccessor(&KiteUploadMobile::m_associationTrace),
+                      "ns3::ndn::KiteUploadMobile::AssociationCallback")
+      .AddTraceSource("TraceSent", "Trace interest has been sent",
+                      MakeTraceSourceAccessor(&KiteUploadMobile::m_traceSentTrace),
+                      "ns3::ndn::KiteUploadMobile::TraceSentCallback")
+      .AddTraceSource("TraceConfirmed", "Trace interest has been confirmed by RV",
+                      MakeTraceSourceAccessor(&KiteUploadMobile::m_traceConfirmedTrace),
+                      "ns3::ndn::KiteUploadMobile::TraceConfirmedCallback");
   return tid;
 }
 
 // set m_seq=1, m_negotiationDone=false to disable initial negotiation
 KiteUploadMobile::KiteUploadMobile()
-  : m_rand(CreateObject<UniformRandomVariable>())
+  : m_adaptiveRefresh(false)
+  , m_rand(CreateObject<UniformRandomVariable>())
   , m_seq(0)
   , m_dataSeq(0)
+  , m_tracePrefix(NamePrefixTable::INVALID_ID)
+  , m_uploadPrefix(NamePrefixTable::INVALID_ID)
+  , m_traceOutstanding(false)
   , m_traceRetryCnt(0)
   , m_negotiationDone(false)
   , m_uploadRequests(0)
@@ -79,6 +105,7 @@ KiteUploadMobile::KiteUploadMobile()
   , m_interestForData(0)
   , m_data(0)
   , m_uploadSuccess(false)
+  , m_savedTraces(0)
 {
   NS_LOG_FUNCTION_NOARGS();
 }
@@ -87,10 +114,16 @@ void
 KiteUploadMobile::OnAssociation()
 {
   NS_LOG_INFO("> Association done with AP");
+  m_associationTrace(this);
+  m_currentInterval = m_refreshInterval; // producer has moved, refresh at the base rate again
+
   if (!m_negotiationDone)
     StartNegotiation();
-  else
-    Simulator::Schedule(Seconds(0), &KiteUploadMobile::SendTrace, this); // send TI when relocate
+  else {
+    Simulator::Cancel(m_traceEvent);
+    m_traceEvent =
+      Simulator::Schedule(Seconds(0), &KiteUploadMobile::SendTrace, this); // send TI when relocate
+  }
 }
 
 // inherited from Application base class.
@@ -99,6 +132,7 @@ KiteUploadMobile::StartApplication()
 {
   NS_LOG_FUNCTION_NOARGS();
   Producer::StartApplication(); // will register prefix
+  m_currentInterval = m_refreshInterval;
   StartNegotiation();
 }
 
@@ -108,10 +142,13 @@ KiteUploadMobile::StopApplication()
   NS_LOG_UNCOND("Upload Requests sent: " << m_uploadRequests);
   // NS_LOG_UNCOND ("Tracing Overhead (%): " << (100.0 * (m_rvInterests + m_rvData) / (m_data +
   // m_uploadRequests + m_rvInterests + m_rvData + m_interestForData)));
-  NS_LOG_UNCOND("Tracing Overhead (number of messages): " << m_rvInterests + m_rvData);
-
   NS_LOG_FUNCTION_NOARGS();
 
+  Simulator::Cancel(m_traceEvent);
+
+  CountSavedTraces(0);
+  m_tracingOverhead(this, m_rvInterests + m_rvData, m_savedTraces);
+
   App::StopApplication();
 }
 
@@ -166,40 +203,80 @@ KiteUploadMobile::SendTrace()
 
   BOOST_ASSERT(m_seq > 0);
 
-  if (m_traceRefreshEvent.IsRunning())
-    Simulator::Cancel(m_traceRefreshEvent);
-
-  shared_ptr<Name> name = MakeTracePrefix();
-  name->appendSequenceNumber(m_seq);
+  Name name = NamePrefixTable::get().makeName(GetTracePrefix(), m_seq);
 
   m_seq++;
 
+  // trace must outlive the (stretched) interval until the next refresh
+  Time traceLifetime = m_traceLifetime + (m_currentInterval - m_refreshInterval);
+
   shared_ptr<Interest> interest = make_shared<Interest>();
   interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*name);
-  time::milliseconds interestLifeTime(m_traceLifetime.GetMilliSeconds());
+  interest->setName(name);
+  time::milliseconds interestLifeTime(traceLifetime.GetMilliSeconds());
   interest->setInterestLifetime(interestLifeTime);
   m_rvInterests++;
-  NS_LOG_INFO("> Trace Interest sent to " << name->toUri());
+  NS_LOG_INFO("> Trace Interest sent to " << name.toUri());
 
   m_transmittedInterests(interest, this, m_face);
   m_appLink->onReceiveInterest(*interest);
 
-  if (m_refreshInterval != 0)
-    m_traceRefreshEvent =
-      Simulator::Schedule(Seconds(m_refreshInterval.GetSeconds()), &KiteUploadMobile::SendTrace,
-                          this); // Send out trace at fixed intervals
-  m_traceTimeoutEvent =
-    Simulator::Schedule(Seconds(m_traceLifetime.GetSeconds()), &KiteUploadMobile::OnTraceTimeout,
-                        this); // Trace interest times out after a specified period, will retry with
-                               // new seq
+  CountSavedTraces(1);
+  m_traceSent = Simulator::Now();
+  m_traceOutstanding = true;
+  m_traceSentTrace(this, m_seq - 1);
+
+  ScheduleTraceTimer(); // Send out trace at refresh interval, or retry with new seq on timeout
+}
+
+void
+KiteUploadMobile::ScheduleTraceTimer()
+{
+  Simulator::Cancel(m_traceEvent);
+
+  Time next = m_traceSent + m_traceLifetime;
+  if (m_currentInterval != 0) {
+    next = m_traceOutstanding ? std::min(next, m_traceSent + m_currentInterval)
+                              : m_traceSent + m_currentInterval;
+  }
+  else if (!m_traceOutstanding) {
+    return; // periodic sending disabled
+  }
+
+  m_traceEvent =
+    Simulator::Schedule(next - Simulator::Now(), &KiteUploadMobile::OnTraceTimer, this);
+}
+
+void
+KiteUploadMobile::OnTraceTimer()
+{
+  if (m_traceOutstanding
+      && (m_currentInterval == 0 || Simulator::Now() < m_traceSent + m_currentInterval))
+    OnTraceTimeout();
+  else
+    SendTrace();
+}
+
+void
+KiteUploadMobile::CountSavedTraces(uint64_t sentTraces)
+{
+  if (!m_adaptiveRefresh || m_refreshInterval == 0 || m_traceSent.IsZero())
+    return;
+
+  // trace interests that fixed RefreshInterval would have sent since the last one
+  uint64_t fixedTraces =
+    (Simulator::Now() - m_traceSent).GetInteger() / m_refreshInterval.GetInteger();
+  if (fixedTraces > sentTraces)
+    m_savedTraces += fixedTraces - sentTraces;
 }
 
 void
 KiteUploadMobile::OnTraceTimeout()
 {
   NS_LOG_INFO("Trace interest timed out " << m_seq - 1);
-  Simulator::Cancel(m_traceRefreshEvent);
+  Simulator::Cancel(m_traceEvent);
+  m_traceOutstanding = false;
+  m_currentInterval = m_refreshInterval;
 
   if (m_traceRetryCnt >= 3) {
     m_traceRetryCnt = 0;
@@ -219,12 +296,7 @@ KiteUploadMobile::SendUploadRequest()
 {
   NS_LOG_FUNCTION_NOARGS();
 
-  Name name(m_serverPrefix); // consumer is actually a stationary server under upload scenario
-
-  name.append("upload");
-  name.append(m_rvPrefix); // the new setup, rv announces its own prefix, mn has a prefix under that
-  name.append(m_dataPrefix);
-  name.appendSequenceNumber(m_dataSeq++);
+  Name name = NamePrefixTable::get().makeName(GetUploadPrefix(), m_dataSeq++);
 
   shared_ptr<Interest> interest = make_shared<Interest>();
   interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
@@ -284,22 +356,47 @@ KiteUploadMobile::OnData(shared_ptr<const Data> data)
     NS_LOG_INFO("Wrong seq: " << seq);
     return;
   }
-  Simulator::Cancel(m_traceTimeoutEvent);       // stop timeout timer
   Simulator::Cancel(m_negotiationTimeoutEvent); // no need to retry negotiation
 
   m_traceRetryCnt = 0;
+  m_traceOutstanding = false;
+  m_traceConfirmedTrace(this, seq, Simulator::Now() - m_traceSent);
+  if (m_adaptiveRefresh && m_currentInterval != 0) {
+    // still attached, trace is confirmed, refresh less often
+    m_currentInterval = std::min(m_currentInterval * 2, m_maxRefreshInterval);
+  }
+  ScheduleTraceTimer(); // stop timeout timer
+
   if (!m_uploadSuccess) {
     SendUploadRequest(); // send after receiving TD (trace is set up)
   }
 }
 
-shared_ptr<Name>
-KiteUploadMobile::MakeTracePrefix()
+NamePrefixTable::Id
+KiteUploadMobile::GetTracePrefix()
 {
-  shared_ptr<Name> tracePrefix = make_shared<Name>(m_rvPrefix); // e.g. /rv
-  tracePrefix->append("trace");
-  tracePrefix->append(m_dataPrefix); // e.g. /alice/photo
-  return tracePrefix;                // e.g. /rv/trace/alice/photo
+  if (m_tracePrefix == NamePrefixTable::INVALID_ID) {
+    Name tracePrefix(m_rvPrefix); // e.g. /rv
+    tracePrefix.append("trace");
+    tracePrefix.append(m_dataPrefix); // e.g. /alice/photo
+    m_tracePrefix = NamePrefixTable::get().intern(tracePrefix); // e.g. /rv/trace/alice/photo
+  }
+  return m_tracePrefix;
+}
+
+NamePrefixTable::Id
+KiteUploadMobile::GetUploadPrefix()
+{
+  if (m_uploadPrefix == NamePrefixTable::INVALID_ID) {
+    Name uploadPrefix(m_serverPrefix); // consumer is actually a stationary server under upload
+                                       // scenario
+    uploadPrefix.append("upload");
+    uploadPrefix.append(m_rvPrefix); // the new setup, rv announces its own prefix, mn has a prefix
+                                     // under that
+    uploadPrefix.append(m_dataPrefix);
+    m_uploadPrefix = NamePrefixTable::get().intern(uploadPrefix);
+  }
+  return m_uploadPrefix;
 }
 
 void
@@ -27,6 +27,7 @@
 #include "ns3/ptr.h"
 
 #include "ns3/ndnSIM/apps/ndn-producer.hpp"
+#include "ns3/ndnSIM/utils/ndn-name-prefix-table.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -39,6 +40,10 @@ namespace ndn {
  * It also sends out trace interest periodically to corresponding RV to update it's location in the
  *network.
  * In upload scenario, this should run on a mobile node.
+ *
+ * With AdaptiveRefresh, the refresh interval is doubled (up to MaxRefreshInterval) each time a
+ * trace interest is confirmed, and returns to RefreshInterval when associated with a new AP or
+ * when a trace interest times out; trace interest lifetime is stretched together with the interval.
  */
 class KiteUploadMobile : public Producer {
 public:
@@ -71,13 +76,21 @@ public:
   OnTraceTimeout(); // TI times out, should not happen, and if due to relocation, will send when
                     // associated
 
+  typedef void (*TracingOverheadCallback)(Ptr<App> app, uint64_t messages, uint64_t savedTraces);
+  typedef void (*AssociationCallback)(Ptr<App> app);
+  typedef void (*TraceSentCallback)(Ptr<App> app, uint64_t seq);
+  typedef void (*TraceConfirmedCallback)(Ptr<App> app, uint64_t seq, Time rtt);
+
   // TODO: OnNack()
 
   void
   OnNegotiationTimeout(); // retry negotiation until success
 
-  shared_ptr<Name>
-  MakeTracePrefix();
+  NamePrefixTable::Id
+  GetTracePrefix(); // interned on first use, e.g. /rv/trace/alice/photo
+
+  NamePrefixTable::Id
+  GetUploadPrefix(); // interned on first use, e.g. /server/upload/rv/alice/photo
 
 protected:
   // inherited from Application base class.
@@ -88,22 +101,38 @@ protected:
   StopApplication(); // Called at time specified by Stop
 
 private:
+  void
+  OnTraceTimer(); // refresh the trace, or time out the outstanding TI
+
+  void
+  ScheduleTraceTimer(); // reschedule the timer for the next refresh or timeout
+
+  void
+  CountSavedTraces(uint64_t sentTraces); // TIs saved since the last one, compared to fixed
+                                         // RefreshInterval, sentTraces are sent now
+
   Name m_rvPrefix;     // prefix of RV, /rv
   Name m_serverPrefix; // prefix of stationary server, to which data is uploaded
   Name m_dataPrefix;   // prefix of data to be uploaded, e.g. /alice/photo, is producer prefix in
                        // paper, the full data prefix is m_rvPrefix + m_dataPrefix
 
-  Time m_traceLifetime;   // lifeTime for trace interest
-  Time m_refreshInterval; // interval between trace interests
+  Time m_traceLifetime;      // lifeTime for trace interest
+  Time m_refreshInterval;    // interval between trace interests
+  bool m_adaptiveRefresh;    // stretch refresh interval while traces are confirmed
+  Time m_maxRefreshInterval; // upper bound of the stretched refresh interval
+  Time m_currentInterval;    // current refresh interval, m_refreshInterval unless stretched
 
   Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
 
   uint64_t m_seq; // increments each time new trace interest is sent, initiated after negotiation
   uint64_t m_dataSeq;
+  NamePrefixTable::Id m_tracePrefix;
+  NamePrefixTable::Id m_uploadPrefix;
 
-  EventId m_traceRefreshEvent; // send new trace interest at fixed interval, unless previous trace
-                               // interest fetched invalid data or times out.
-  EventId m_traceTimeoutEvent; // triggered when interest times out, use trace Interest lifetime
+  EventId m_traceEvent;     // send new trace interest after m_currentInterval, or time out the
+                            // outstanding one after m_traceLifetime, whichever comes first
+  Time m_traceSent;         // when the last trace interest was sent
+  bool m_traceOutstanding;  // last trace interest has not been confirmed yet
 
   int m_traceRetryCnt; // retry up to 3 times for sending trace Interest, and then start negotiation
 
@@ -117,6 +146,12 @@ private:
   int m_interestForData; // Interest for Data from consumer
   int m_data;            // data packets sent to the consumer
   bool m_uploadSuccess;  // has the server received the upload request?
+  uint64_t m_savedTraces; // trace interests saved by adaptive refresh
+
+  TracedCallback<Ptr<App>, uint64_t, uint64_t> m_tracingOverhead;
+  TracedCallback<Ptr<App>> m_associationTrace;
+  TracedCallback<Ptr<App>, uint64_t> m_traceSentTrace;
+  TracedCallback<Ptr<App>, uint64_t, Time> m_traceConfirmedTrace;
 };
 
 } // namespace ndn
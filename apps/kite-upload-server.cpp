@@ -83,7 +83,7 @@ KiteUploadServer::StartApplication()
   NS_LOG_FUNCTION_NOARGS();
   App::StartApplication();
 
-  FibHelper::AddRoute(GetNode(), m_serverPrefix, m_face, 0);
+  RegisterPrefix(m_serverPrefix);
 }
 
 void
@@ -94,6 +94,8 @@ KiteUploadServer::StopApplication()
   NS_LOG_UNCOND("Average packet delay: " << m_averagePacketDelay.GetMicroSeconds() / 1000.0);
   NS_LOG_FUNCTION_NOARGS();
 
+  Simulator::Cancel(m_exchangeExpiryEvent);
+
   App::StopApplication();
 }
 
@@ -171,7 +173,7 @@ KiteUploadServer::SendInterest(shared_ptr<const Interest> uploadInterest)
 
   WillSendOutInterest(m_seq);
 
-  m_outstandingExchanges.push_back(std::make_tuple(interest->getName(), Simulator::Now(), m_seq));
+  AddExchange(interest->getName(), m_seq);
   m_seq++;
   m_transmittedInterests(interest, this, m_face);
   m_appLink->onReceiveInterest(*interest);
@@ -205,7 +207,7 @@ KiteUploadServer::SendInterestForData(const Name dataName)
 
   WillSendOutInterest(m_seq);
 
-  m_outstandingExchanges.push_back(std::make_tuple(interest->getName(), Simulator::Now(), m_seq));
+  AddExchange(interest->getName(), m_seq);
   m_seq++;
   m_transmittedInterests(interest, this, m_face);
   m_appLink->onReceiveInterest(*interest);
@@ -236,23 +238,63 @@ KiteUploadServer::OnTimeout(uint32_t sequenceNumber)
                  1); // make sure to disable RTT calculation for this sample
   m_retxSeqs.insert(sequenceNumber);
 
-  for (auto i = m_outstandingExchanges.begin(); i != m_outstandingExchanges.end(); i++) {
-    if (std::get<2>(*i) == sequenceNumber) {
-      shared_ptr<Interest> interest = make_shared<Interest>();
-      interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-      interest->setName(std::get<0>(*i));
-      time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-      interest->setInterestLifetime(interestLifeTime);
-      //WillSendOutInterest(sequenceNumber);
-      //
-      NS_LOG_INFO("> Retransmitting Interest with name=" << interest->getName());
-      //
-      std::get<1>(*i) = Simulator::Now();
-      //
-      m_transmittedInterests(interest, this, m_face);
-      m_appLink->onReceiveInterest(*interest);
-      break;
+  auto exchange = m_outstandingExchanges.find(sequenceNumber);
+  if (exchange != m_outstandingExchanges.end()) {
+    shared_ptr<Interest> interest = make_shared<Interest>();
+    interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+    interest->setName(exchange->second.name);
+    time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
+    interest->setInterestLifetime(interestLifeTime);
+    //WillSendOutInterest(sequenceNumber);
+    //
+    NS_LOG_INFO("> Retransmitting Interest with name=" << interest->getName());
+    //
+    exchange->second.sent = Simulator::Now();
+    //
+    m_transmittedInterests(interest, this, m_face);
+    m_appLink->onReceiveInterest(*interest);
+
+    // the timeout is not rearmed, so the exchange is over when this Interest expires
+    m_exchangeDeadlines.push_back(std::make_pair(Simulator::Now() + m_interestLifeTime,
+                                                 sequenceNumber));
+    if (!m_exchangeExpiryEvent.IsRunning()) {
+      m_exchangeExpiryEvent =
+        Simulator::Schedule(m_interestLifeTime, &KiteUploadServer::ExpireExchanges, this);
+    }
+  }
+}
+
+void
+KiteUploadServer::AddExchange(const Name& name, uint32_t seq)
+{
+  Exchange& exchange = m_outstandingExchanges[seq];
+  exchange.name = name;
+  exchange.sent = Simulator::Now();
+  m_exchangeSeqs[name] = seq;
+}
+
+void
+KiteUploadServer::ExpireExchanges()
+{
+  Time now = Simulator::Now();
+
+  while (!m_exchangeDeadlines.empty() && m_exchangeDeadlines.front().first <= now) {
+    uint32_t seq = m_exchangeDeadlines.front().second;
+    m_exchangeDeadlines.pop_front();
+
+    auto exchange = m_outstandingExchanges.find(seq);
+    if (exchange == m_outstandingExchanges.end()) {
+      continue; // completed
     }
+
+    NS_LOG_DEBUG("Exchange expired: " << exchange->second.name);
+    m_exchangeSeqs.erase(exchange->second.name);
+    m_outstandingExchanges.erase(exchange);
+  }
+
+  if (!m_exchangeDeadlines.empty()) {
+    m_exchangeExpiryEvent = Simulator::Schedule(m_exchangeDeadlines.front().first - now,
+                                                &KiteUploadServer::ExpireExchanges, this);
   }
 }
 
@@ -272,24 +314,13 @@ KiteUploadServer::OnData(shared_ptr<const Data> data)
     return;
   }
   // Get round trip time
-  // bool dup = false;
-  auto i = m_outstandingExchanges.begin();
-  while(i != m_outstandingExchanges.end()) {
-    if (data->getName() == std::get<0>(*i)) {
-      // NS_LOG_UNCOND("Delay for " << i->first << ": " << (Simulator::Now() - i->second).GetSeconds());
-      m_totalPacketDelay += (Simulator::Now() - std::get<1>(*i));
-      m_averagePacketDelay = m_totalPacketDelay / m_dataReceived;
-      i = m_outstandingExchanges.erase(i);
-      break;
-      // if (dup) {
-      //   NS_LOG_UNCOND("Dup found!");
-      // }
-      // else {
-      //   dup = true;
-      // }
-    }
-    else
-      i++;
+  auto seq = m_exchangeSeqs.find(data->getName());
+  if (seq != m_exchangeSeqs.end()) {
+    auto exchange = m_outstandingExchanges.find(seq->second);
+    m_totalPacketDelay += (Simulator::Now() - exchange->second.sent);
+    m_averagePacketDelay = m_totalPacketDelay / m_dataReceived;
+    m_outstandingExchanges.erase(exchange);
+    m_exchangeSeqs.erase(seq);
   }
 
   Consumer::OnData(data);
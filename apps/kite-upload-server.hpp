@@ -24,6 +24,11 @@
 
 #include "ns3/ndnSIM/apps/ndn-consumer.hpp"
 
+#include <boost/functional/hash.hpp>
+
+#include <deque>
+#include <unordered_map>
+
 namespace ns3 {
 namespace ndn {
 
@@ -88,6 +93,22 @@ protected:
   void
   SendInterestForData(const Name dataName);
 
+  /**
+   * @brief Record a new exchange (Interest towards the mobile producer) with the sequence number
+   */
+  void
+  AddExchange(const Name& name, uint32_t seq);
+
+  /**
+   * @brief Remove exchanges, whose retransmitted Interest has expired without Data
+   *
+   * An exchange gets a deadline only when it is retransmitted on timeout, which is the last
+   * attempt of the server, so that an exchange is never removed while a retransmission is due.
+   * Exchanges are checked in the order of their deadlines, by a single timer.
+   */
+  void
+  ExpireExchanges();
+
 protected:
   // m_interestName inherited from Consumer
   Name m_serverPrefix;
@@ -95,7 +116,29 @@ protected:
   int m_interestSent;
   Time m_averagePacketDelay; // average packet delay
   Time m_totalPacketDelay;   // total packet delay
-  std::vector<std::tuple<Name, Time, uint32_t>> m_outstandingExchanges;
+
+  struct Exchange {
+    Name name;
+    Time sent; // time of the last (re)transmission
+  };
+
+  struct NameHash {
+    size_t
+    operator()(const Name& name) const
+    {
+      const Block& wire = name.wireEncode();
+      return boost::hash_range(wire.wire(), wire.wire() + wire.size());
+    }
+  };
+
+  // outstanding exchanges, indexed by sequence number and by name
+  std::unordered_map<uint32_t, Exchange> m_outstandingExchanges;
+  std::unordered_map<Name, uint32_t, NameHash> m_exchangeSeqs;
+  // (deadline, seq) of retransmitted exchanges in the order of deadlines; entries of completed
+  // exchanges are skipped on expiration
+  std::deque<std::pair<Time, uint32_t>> m_exchangeDeadlines;
+  EventId m_exchangeExpiryEvent;
+
   bool m_sendInterestForData;
   bool m_done;
   double m_frequency;
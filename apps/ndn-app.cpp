@@ -21,11 +21,15 @@
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/packet.h"
+#include "ns3/boolean.h"
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-app-link-service.hpp"
+#include "model/ndn-shared-app-link-service.hpp"
 #include "model/null-transport.hpp"
 
+#include "helper/ndn-fib-helper.hpp"
+
 NS_LOG_COMPONENT_DEFINE("ndn.App");
 
 namespace ns3 {
@@ -41,6 +45,13 @@ App::GetTypeId(void)
                         .SetParent<Application>()
                         .AddConstructor<App>()
 
+                        .AddAttribute("SharedFace",
+                                      "Use a single face shared by all applications on the node "
+                                      "that enable this attribute, instead of a private face",
+                                      BooleanValue(false),
+                                      MakeBooleanAccessor(&App::m_useSharedFace),
+                                      MakeBooleanChecker())
+
                         .AddTraceSource("ReceivedInterests", "ReceivedInterests",
                                         MakeTraceSourceAccessor(&App::m_receivedInterests),
                                         "ns3::ndn::App::InterestTraceCallback")
@@ -71,6 +82,7 @@ App::App()
   : m_active(false)
   , m_face(0)
   , m_appId(std::numeric_limits<uint32_t>::max())
+  , m_useSharedFace(false)
 {
 }
 
@@ -145,6 +157,14 @@ App::StartApplication() // Called at time specified by Start
   NS_ASSERT_MSG(GetNode()->GetObject<L3Protocol>() != 0,
                 "Ndn stack should be installed on the node " << GetNode());
 
+  if (m_useSharedFace) {
+    m_face = GetNode()->GetObject<L3Protocol>()->getSharedAppFace();
+    auto sharedLink = static_cast<SharedAppLinkService*>(m_face->getLinkService());
+    m_sharedFaceLink = make_unique<AppLinkService>(this, *sharedLink);
+    m_appLink = m_sharedFaceLink.get();
+    return;
+  }
+
   // step 1. Create a face
   auto appLink = make_unique<AppLinkService>(this);
   auto transport = make_unique<NullTransport>("appFace://", "appFace://",
@@ -168,8 +188,26 @@ App::StopApplication() // Called at time specified by Stop
 
   m_active = false;
 
+  if (m_useSharedFace) {
+    // the shared face stays open, so routes of prefixes no other app serves are removed here
+    auto sharedLink = static_cast<SharedAppLinkService*>(m_face->getLinkService());
+    for (const Name& prefix : sharedLink->removeApp(this)) {
+      FibHelper::RemoveRoute(GetNode(), prefix, m_face);
+    }
+    return;
+  }
+
   m_face->close();
 }
 
+void
+App::RegisterPrefix(const Name& prefix)
+{
+  if (m_useSharedFace) {
+    static_cast<SharedAppLinkService*>(m_face->getLinkService())->registerPrefix(prefix, this);
+  }
+  FibHelper::AddRoute(GetNode(), prefix, m_face, 0);
+}
+
 } // namespace ndn
 } // namespace ns3
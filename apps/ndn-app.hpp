@@ -99,11 +99,23 @@ protected:
   virtual void
   StopApplication(); ///< @brief Called at time specified by Stop
 
+  /**
+   * @brief Register @p prefix in FIB towards the application's face
+   *
+   * When the application uses the node's shared face, Interests under @p prefix are also
+   * delivered to this application by the shared face.
+   */
+  void
+  RegisterPrefix(const Name& prefix);
+
 protected:
   bool m_active; ///< @brief Flag to indicate that application is active (set by StartApplication and StopApplication)
   shared_ptr<Face> m_face;
   AppLinkService* m_appLink;
 
+  bool m_useSharedFace; ///< @brief Whether to use the face shared by applications on the node
+  std::unique_ptr<AppLinkService> m_sharedFaceLink; ///< @brief Link to the shared face, if used
+
   uint32_t m_appId;
 
   TracedCallback<shared_ptr<const Interest>, Ptr<App>, shared_ptr<Face>>
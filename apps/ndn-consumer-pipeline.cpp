@@ -0,0 +1,296 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-pipeline.hpp"
+#include "ns3/ptr.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/integer.h"
+#include "ns3/object-factory.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.ConsumerPipeline");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ConsumerPipeline);
+
+TypeId
+ConsumerPipeline::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ConsumerPipeline")
+      .SetGroupName("Ndn")
+      .SetParent<Consumer>()
+      .AddConstructor<ConsumerPipeline>()
+
+      .AddAttribute("MaxSeq", "Maximum sequence number to request",
+                    IntegerValue(std::numeric_limits<uint32_t>::max()),
+                    MakeIntegerAccessor(&ConsumerPipeline::m_seqMax),
+                    MakeIntegerChecker<uint32_t>())
+
+      .AddAttribute("CongestionControl",
+                    "Type of congestion controller: ns3::ndn::CongestionControlAimd (default), "
+                    "ns3::ndn::CongestionControlCubic, or ns3::ndn::CongestionControlBbr",
+                    StringValue("ns3::ndn::CongestionControlAimd"),
+                    MakeStringAccessor(&ConsumerPipeline::SetCongestionControl,
+                                       &ConsumerPipeline::GetCongestionControl),
+                    MakeStringChecker())
+
+      .AddAttribute("UseCwa", "Decrease the window at most once per RTT "
+                              "(conservative window adaptation)",
+                    BooleanValue(true), MakeBooleanAccessor(&ConsumerPipeline::m_useCwa),
+                    MakeBooleanChecker())
+
+      .AddAttribute("Pacing", "Spread Interests of the window evenly over the smoothed RTT",
+                    BooleanValue(false), MakeBooleanAccessor(&ConsumerPipeline::m_usePacing),
+                    MakeBooleanChecker())
+
+      .AddTraceSource("CongestionWindow", "Congestion window, in Interests",
+                      MakeTraceSourceAccessor(&ConsumerPipeline::m_cwnd),
+                      "ns3::ndn::ConsumerPipeline::WindowTraceCallback")
+
+      .AddTraceSource("SlowStartThreshold", "Slow start threshold, in Interests",
+                      MakeTraceSourceAccessor(&ConsumerPipeline::m_ssthresh),
+                      "ns3::ndn::ConsumerPipeline::WindowTraceCallback")
+
+      .AddTraceSource("PacingRate", "Pacing rate, in Interests per second (0 if not paced)",
+                      MakeTraceSourceAccessor(&ConsumerPipeline::m_rate),
+                      "ns3::ndn::ConsumerPipeline::WindowTraceCallback")
+
+      .AddTraceSource("InFlight", "Current number of outstanding Interests",
+                      MakeTraceSourceAccessor(&ConsumerPipeline::m_inFlight),
+                      "ns3::ndn::ConsumerPipeline::InFlightTraceCallback");
+
+  return tid;
+}
+
+ConsumerPipeline::ConsumerPipeline()
+  : m_useCwa(true)
+  , m_usePacing(false)
+  , m_highSeq(0)
+  , m_recoveryPoint(0)
+  , m_inFlight(0)
+{
+  NS_LOG_FUNCTION_NOARGS();
+  m_seqMax = std::numeric_limits<uint32_t>::max();
+}
+
+void
+ConsumerPipeline::SetCongestionControl(const std::string& type)
+{
+  TypeId tid;
+  if (!TypeId::LookupByNameFailSafe(type, &tid)
+      || !tid.IsChildOf(CongestionControl::GetTypeId())) {
+    NS_FATAL_ERROR("Unknown congestion controller type [" << type << "]");
+  }
+
+  ObjectFactory factory;
+  factory.SetTypeId(tid);
+  m_cc = factory.Create<CongestionControl>();
+}
+
+std::string
+ConsumerPipeline::GetCongestionControl() const
+{
+  return m_cc->GetInstanceTypeId().GetName();
+}
+
+void
+ConsumerPipeline::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  m_cc->Reset();
+  m_srtt = Seconds(0);
+  m_highSeq = m_seq;
+  m_recoveryPoint = m_seq;
+  m_inFlight = 0;
+  UpdateTraces();
+
+  Consumer::StartApplication();
+}
+
+double
+ConsumerPipeline::GetRate() const
+{
+  double rate = m_cc->GetPacingRate();
+  if (rate > 0) {
+    return rate;
+  }
+
+  if (m_usePacing && m_srtt.IsStrictlyPositive()) {
+    return m_cc->GetWindow() / m_srtt.ToDouble(Time::S);
+  }
+  return 0.0;
+}
+
+void
+ConsumerPipeline::ScheduleNextPacket()
+{
+  if (m_retxSeqs.empty() && m_seq >= m_seqMax) {
+    return; // we are totally done
+  }
+
+  uint32_t window = std::max<uint32_t>(1, static_cast<uint32_t>(m_cc->GetWindow()));
+  if (m_inFlight >= window || m_sendEvent.IsRunning()) {
+    return;
+  }
+
+  Time delay = Seconds(0);
+  double rate = GetRate();
+  if (rate > 0) {
+    delay = std::max(Seconds(0), m_lastSendTime + Seconds(1.0 / rate) - Simulator::Now());
+  }
+
+  m_sendEvent = Simulator::Schedule(delay, &Consumer::SendPacket, this);
+}
+
+///////////////////////////////////////////////////
+//          Process incoming packets             //
+///////////////////////////////////////////////////
+
+void
+ConsumerPipeline::OnData(shared_ptr<const Data> data)
+{
+  if (!m_active)
+    return;
+
+  uint32_t seq = data->getName().at(-1).toSequenceNumber();
+
+  // Consumer::OnData discards the state needed to take the RTT sample
+  bool isOutstanding = m_seqTimeouts.find(seq) != m_seqTimeouts.end();
+  Time sample = Seconds(0);
+  auto lastSent = m_seqLastDelay.find(seq);
+  auto retxCount = m_seqRetxCounts.find(seq);
+  if (isOutstanding && lastSent != m_seqLastDelay.end() && retxCount != m_seqRetxCounts.end()
+      && retxCount->second == 1) {
+    sample = Simulator::Now() - lastSent->time;
+  }
+
+  Consumer::OnData(data);
+
+  if (!isOutstanding) {
+    return; // late Data for a timed out or Nack'ed Interest
+  }
+
+  if (m_inFlight > static_cast<uint32_t>(0))
+    m_inFlight--;
+
+  if (sample.IsStrictlyPositive()) {
+    m_srtt = m_srtt.IsZero()
+               ? sample
+               : Seconds(0.875 * m_srtt.ToDouble(Time::S) + 0.125 * sample.ToDouble(Time::S));
+  }
+
+  m_cc->OnData(sample, m_srtt, m_inFlight);
+  UpdateTraces();
+  NS_LOG_DEBUG("Window: " << m_cwnd << ", InFlight: " << m_inFlight << ", RTT: " << m_srtt);
+
+  ScheduleNextPacket();
+}
+
+void
+ConsumerPipeline::OnNack(shared_ptr<const lp::Nack> nack)
+{
+  Consumer::OnNack(nack);
+
+  if (!m_active)
+    return;
+
+  uint32_t seq = nack->getInterest().getName().at(-1).toSequenceNumber();
+  auto entry = m_seqTimeouts.find(seq);
+  if (entry == m_seqTimeouts.end()) {
+    return; // not outstanding
+  }
+
+  if (nack->getReason() == lp::NackReason::NO_ROUTE) {
+    return; // immediate retransmission will not help, leave it to the retransmission timer
+  }
+
+  // fast retransmit
+  m_seqTimeouts.erase(entry);
+  if (m_inFlight > static_cast<uint32_t>(0))
+    m_inFlight--;
+
+  if (nack->getReason() == lp::NackReason::CONGESTION) {
+    OnCongestion(seq, false);
+  }
+
+  m_rtt->SentSeq(SequenceNumber32(seq), 1); // make sure to disable RTT calculation for this sample
+  m_retxSeqs.insert(seq);
+  ScheduleNextPacket();
+}
+
+void
+ConsumerPipeline::OnTimeout(uint32_t sequenceNumber)
+{
+  if (m_inFlight > static_cast<uint32_t>(0))
+    m_inFlight--;
+
+  OnCongestion(sequenceNumber, true);
+
+  Consumer::OnTimeout(sequenceNumber);
+}
+
+void
+ConsumerPipeline::OnCongestion(uint32_t sequenceNumber, bool isTimeout)
+{
+  if (m_useCwa && sequenceNumber < m_recoveryPoint) {
+    NS_LOG_DEBUG("Ignoring congestion signal for " << sequenceNumber << " sent before the last "
+                                                   << "window decrease");
+    return;
+  }
+
+  if (isTimeout) {
+    m_cc->OnTimeout();
+  }
+  else {
+    m_cc->OnCongestion();
+  }
+  m_recoveryPoint = m_highSeq;
+
+  UpdateTraces();
+  NS_LOG_DEBUG("Window: " << m_cwnd << ", Ssthresh: " << m_ssthresh);
+}
+
+void
+ConsumerPipeline::WillSendOutInterest(uint32_t sequenceNumber)
+{
+  m_inFlight++;
+  m_lastSendTime = Simulator::Now();
+  if (sequenceNumber >= m_highSeq) {
+    m_highSeq = sequenceNumber + 1;
+  }
+
+  Consumer::WillSendOutInterest(sequenceNumber);
+}
+
+void
+ConsumerPipeline::UpdateTraces()
+{
+  m_cwnd = m_cc->GetWindow();
+  m_ssthresh = m_cc->GetSsthresh();
+  m_rate = GetRate();
+}
+
+} // namespace ndn
+} // namespace ns3
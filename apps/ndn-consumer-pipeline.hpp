@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONSUMER_PIPELINE_H
+#define NDN_CONSUMER_PIPELINE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-consumer.hpp"
+#include "ns3/traced-value.h"
+
+#include "ns3/ndnSIM/utils/ndn-congestion-control.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * \brief Ndn application that pipelines Interests under control of a congestion controller
+ *
+ * The number of outstanding Interests is limited by the congestion window of the controller,
+ * selected by the CongestionControl attribute (AIMD, CUBIC, or BBR-like pacing, see
+ * CongestionControl).  In addition:
+ *
+ * - Interests Nack'ed by the network are retransmitted right away (fast retransmit), and Nacks
+ *   with Congestion reason are handled as congestion signals;
+ * - with conservative window adaptation (UseCwa), the window is decreased at most once per RTT,
+ *   ignoring congestion signals for Interests sent before the last decrease;
+ * - with Pacing, Interests of each window are spread evenly over the smoothed RTT, while
+ *   rate-based controllers always pace Interests at their own rate.
+ */
+class ConsumerPipeline : public Consumer {
+public:
+  static TypeId
+  GetTypeId();
+
+  ConsumerPipeline();
+
+  // From App
+  virtual void
+  OnData(shared_ptr<const Data> data);
+
+  virtual void
+  OnNack(shared_ptr<const lp::Nack> nack);
+
+  virtual void
+  OnTimeout(uint32_t sequenceNumber);
+
+  virtual void
+  WillSendOutInterest(uint32_t sequenceNumber);
+
+public:
+  typedef void (*WindowTraceCallback)(double oldValue, double newValue);
+  typedef void (*InFlightTraceCallback)(uint32_t oldValue, uint32_t newValue);
+
+protected:
+  // from App
+  virtual void
+  StartApplication();
+
+  virtual void
+  ScheduleNextPacket();
+
+private:
+  void
+  SetCongestionControl(const std::string& type);
+
+  std::string
+  GetCongestionControl() const;
+
+  /**
+   * \brief React to a congestion signal for the Interest with @p sequenceNumber
+   */
+  void
+  OnCongestion(uint32_t sequenceNumber, bool isTimeout);
+
+  /**
+   * \brief Copy the controller's state to the trace sources
+   */
+  void
+  UpdateTraces();
+
+  /**
+   * \brief Get the current pacing rate, in Interests per second (0 if Interests are not paced)
+   */
+  double
+  GetRate() const;
+
+private:
+  Ptr<CongestionControl> m_cc;
+  bool m_useCwa;
+  bool m_usePacing;
+
+  Time m_srtt;
+  uint32_t m_highSeq;       ///< \brief highest sequence number sent so far, plus one
+  uint32_t m_recoveryPoint; ///< \brief signals for sequence numbers below it are ignored (CWA)
+  Time m_lastSendTime;
+
+  TracedValue<double> m_cwnd;
+  TracedValue<double> m_ssthresh;
+  TracedValue<double> m_rate;
+  TracedValue<uint32_t> m_inFlight;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
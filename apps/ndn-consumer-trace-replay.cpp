@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-trace-replay.hpp"
+#include "ns3/ptr.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.ConsumerTraceReplay");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ConsumerTraceReplay);
+
+TypeId
+ConsumerTraceReplay::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ConsumerTraceReplay")
+      .SetGroupName("Ndn")
+      .SetParent<Consumer>()
+      .AddConstructor<ConsumerTraceReplay>()
+
+      .AddAttribute("TraceFile", "Binary request trace to replay (see RequestTraceWriter)",
+                    StringValue(""), MakeStringAccessor(&ConsumerTraceReplay::m_traceFile),
+                    MakeStringChecker());
+
+  return tid;
+}
+
+ConsumerTraceReplay::ConsumerTraceReplay()
+{
+  NS_LOG_FUNCTION_NOARGS();
+}
+
+ConsumerTraceReplay::~ConsumerTraceReplay()
+{
+}
+
+void
+ConsumerTraceReplay::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  try {
+    m_trace.reset(new RequestTraceReader(m_traceFile));
+  }
+  catch (const RequestTrace::Error& error) {
+    NS_FATAL_ERROR(error.what());
+  }
+  NS_LOG_DEBUG("Replaying " << m_trace->getNRecords() << " requests for "
+                            << m_trace->getNNames() << " names");
+
+  m_traceStart = Simulator::Now();
+
+  Consumer::StartApplication();
+}
+
+void
+ConsumerTraceReplay::StopApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  Consumer::StopApplication();
+
+  m_trace.reset();
+}
+
+void
+ConsumerTraceReplay::ScheduleNextPacket()
+{
+  if (!m_retxSeqs.empty()) {
+    Simulator::Remove(m_sendEvent);
+    m_sendEvent = Simulator::ScheduleNow(&ConsumerTraceReplay::SendPacket, this);
+    return;
+  }
+
+  if (m_sendEvent.IsRunning())
+    return;
+
+  RequestTrace::Record record;
+  if (m_trace == nullptr || !m_trace->peek(record))
+    return; // trace is over, only retransmissions remain
+
+  Time delay = m_traceStart + NanoSeconds(record.offset) - Simulator::Now();
+  if (delay.IsNegative())
+    delay = Seconds(0);
+
+  m_sendEvent = Simulator::Schedule(delay, &ConsumerTraceReplay::SendPacket, this);
+}
+
+void
+ConsumerTraceReplay::SendPacket()
+{
+  if (!m_active)
+    return;
+
+  NS_LOG_FUNCTION_NOARGS();
+
+  uint32_t seq = std::numeric_limits<uint32_t>::max(); // invalid
+
+  if (!m_retxSeqs.empty()) {
+    seq = *m_retxSeqs.begin();
+    m_retxSeqs.erase(m_retxSeqs.begin());
+  }
+  else {
+    RequestTrace::Record record;
+    if (!m_trace->peek(record) || m_traceStart + NanoSeconds(record.offset) > Simulator::Now()) {
+      ScheduleNextPacket();
+      return;
+    }
+
+    seq = record.nameId;
+    m_trace->next();
+    m_seq++;
+
+    // a repeated request for the name is a new request, not a retransmission of the previous one
+    m_seqRetxCounts.erase(seq);
+    m_seqFullDelay.erase(seq);
+    m_seqTimeouts.erase(seq);
+    m_retxSeqs.erase(seq);
+  }
+
+  Name interestName(m_interestName);
+  interestName.append(m_trace->getName(seq)).appendSequenceNumber(seq);
+
+  shared_ptr<Interest> interest = make_shared<Interest>();
+  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+  interest->setName(interestName);
+  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
+  interest->setInterestLifetime(interestLifeTime);
+
+  NS_LOG_INFO("> Interest for " << interestName << ", Total: " << m_seq);
+
+  WillSendOutInterest(seq);
+
+  m_transmittedInterests(interest, this, m_face);
+  m_appLink->onReceiveInterest(*interest);
+
+  ScheduleNextPacket();
+}
+
+} // namespace ndn
+} // namespace ns3
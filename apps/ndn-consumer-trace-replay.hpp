@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONSUMER_TRACE_REPLAY_H
+#define NDN_CONSUMER_TRACE_REPLAY_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-consumer.hpp"
+
+#include "ns3/ndnSIM/utils/ndn-request-trace.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Ndn application that replays requests from a binary request trace
+ *
+ * Each trace record is turned into an Interest for Prefix + name from the trace dictionary +
+ * sequence number, where the sequence number is the id of the name in the dictionary.  Repeated
+ * requests for the same name therefore produce the same Interest name, preserving popularity
+ * characteristics of the trace for in-network caching.  A repeated request is traced as a new
+ * request, also when the previous request for the same name is still outstanding.
+ *
+ * The trace is streamed from a memory-mapped file and only the next request is scheduled at any
+ * moment, so memory and event queue usage do not depend on the length of the trace.
+ *
+ * @see RequestTraceWriter::convertText to create the trace from a text request log
+ */
+class ConsumerTraceReplay : public Consumer {
+public:
+  static TypeId
+  GetTypeId();
+
+  ConsumerTraceReplay();
+  virtual ~ConsumerTraceReplay();
+
+  /**
+   * @brief Send retransmission or the next request from the trace, if its time has come
+   */
+  void
+  SendPacket();
+
+protected:
+  // from App
+  virtual void
+  StartApplication();
+
+  virtual void
+  StopApplication();
+
+  virtual void
+  ScheduleNextPacket();
+
+private:
+  std::string m_traceFile;
+  std::unique_ptr<RequestTraceReader> m_trace;
+  Time m_traceStart; ///< @brief simulation time corresponding to zero offset of the trace
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
@@ -28,6 +28,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/integer.h"
 #include "ns3/double.h"
+#include "ns3/object-factory.h"
 
 #include "utils/ndn-ns3-packet-tag.hpp"
 #include "utils/ndn-rtt-mean-deviation.hpp"
@@ -65,6 +66,13 @@ Consumer::GetTypeId(void)
                     MakeTimeAccessor(&Consumer::GetRetxTimer, &Consumer::SetRetxTimer),
                     MakeTimeChecker())
 
+      .AddAttribute("RttEstimator",
+                    "Type of RTT estimator, e.g., ns3::ndn::RttMeanDeviation (default) or "
+                    "ns3::ndn::RttPerInterest",
+                    StringValue("ns3::ndn::RttMeanDeviation"),
+                    MakeStringAccessor(&Consumer::SetRttEstimator, &Consumer::GetRttEstimator),
+                    MakeStringChecker())
+
       .AddTraceSource("LastRetransmittedInterestDataDelay",
                       "Delay between last retransmitted Interest and received Data",
                       MakeTraceSourceAccessor(&Consumer::m_lastRetransmittedInterestDataDelay),
@@ -82,6 +90,7 @@ Consumer::Consumer()
   : m_rand(CreateObject<UniformRandomVariable>())
   , m_seq(0)
   , m_seqMax(0) // don't request anything
+  , m_interestPrefix(NamePrefixTable::INVALID_ID)
 {
   NS_LOG_FUNCTION_NOARGS();
 
@@ -107,6 +116,32 @@ Consumer::GetRetxTimer() const
   return m_retxTimer;
 }
 
+void
+Consumer::SetRttEstimator(const std::string& type)
+{
+  TypeId tid;
+  if (!TypeId::LookupByNameFailSafe(type, &tid) || !tid.IsChildOf(RttEstimator::GetTypeId())) {
+    NS_FATAL_ERROR("Unknown RTT estimator type [" << type << "]");
+  }
+
+  ObjectFactory factory;
+  factory.SetTypeId(tid);
+  m_rtt = factory.Create<RttEstimator>();
+}
+
+std::string
+Consumer::GetRttEstimator() const
+{
+  return m_rtt->GetInstanceTypeId().GetName();
+}
+
+void
+Consumer::SetInterestName(const Name& name)
+{
+  m_interestName = name;
+  m_interestPrefix = NamePrefixTable::get().intern(m_interestName);
+}
+
 void
 Consumer::CheckRetxTimeout()
 {
@@ -140,6 +175,8 @@ Consumer::StartApplication() // Called at time specified by Start
   // do base stuff
   App::StartApplication();
 
+  m_interestPrefix = NamePrefixTable::get().intern(m_interestName);
+
   ScheduleNextPacket();
 }
 
@@ -181,15 +218,9 @@ Consumer::SendPacket()
     seq = m_seq++;
   }
 
-  //
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->appendSequenceNumber(seq);
-  //
-
-  // shared_ptr<Interest> interest = make_shared<Interest> ();
   shared_ptr<Interest> interest = make_shared<Interest>();
   interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
+  interest->setName(NamePrefixTable::get().makeName(m_interestPrefix, seq));
   time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
   interest->setInterestLifetime(interestLifeTime);
 
@@ -241,6 +272,14 @@ Consumer::OnData(shared_ptr<const Data> data)
     m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
   }
 
+  entry = m_seqLastDelay.find(seq);
+  if (entry != m_seqLastDelay.end()) {
+    m_rtt->AckInterest(SequenceNumber32(seq), entry->time, m_seqRetxCounts[seq] > 1);
+  }
+  else {
+    m_rtt->AckSeq(SequenceNumber32(seq));
+  }
+
   m_seqRetxCounts.erase(seq);
   m_seqFullDelay.erase(seq);
   m_seqLastDelay.erase(seq);
@@ -248,8 +287,9 @@ Consumer::OnData(shared_ptr<const Data> data)
   m_seqTimeouts.erase(seq);
   m_retxSeqs.erase(seq);
 
-  m_rtt->AckSeq(SequenceNumber32(seq));
-  m_rtt->Reset();
+  if (m_rtt->KeepsHistory()) {
+    m_rtt->Reset();
+  }
 }
 
 void
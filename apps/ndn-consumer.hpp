@@ -30,6 +30,7 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
+#include "ns3/ndnSIM/utils/ndn-name-prefix-table.hpp"
 
 #include <set>
 #include <map>
@@ -131,6 +132,25 @@ protected:
   Time
   GetRetxTimer() const;
 
+  /**
+   * \brief Replaces the RTT estimator with a new instance of the specified type
+   * \param type TypeId name of an RttEstimator subclass
+   */
+  void
+  SetRttEstimator(const std::string& type);
+
+  /**
+   * \brief Returns the TypeId name of the current RTT estimator
+   */
+  std::string
+  GetRttEstimator() const;
+
+  /**
+   * \brief Changes the prefix of the requested names, e.g., after a new locator is learned
+   */
+  void
+  SetInterestName(const Name& name);
+
 protected:
   Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
 
@@ -144,6 +164,7 @@ protected:
 
   Time m_offTime;          ///< \brief Time interval between packets
   Name m_interestName;     ///< \brief NDN Name of the Interest (use Name)
+  NamePrefixTable::Id m_interestPrefix; ///< \brief m_interestName interned in NamePrefixTable
   Time m_interestLifeTime; ///< \brief LifeTime for interest packet
 
   /// @cond include_hidden
@@ -79,7 +79,21 @@ Producer::StartApplication()
   NS_LOG_FUNCTION_NOARGS();
   App::StartApplication();
 
-  FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
+  RegisterPrefix(m_prefix);
+
+  // payload and signature are the same in all Data packets, so they are created only once
+  m_payload = make_shared< ::ndn::Buffer>(m_virtualPayloadSize);
+
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+
+  if (m_keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(m_keyLocator);
+  }
+  signatureInfo.wireEncode();
+
+  m_dataSignature.setInfo(signatureInfo);
+  m_dataSignature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue,
+                                                              m_signature));
 }
 
 void
@@ -100,27 +114,12 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   if (!m_active)
     return;
 
-  Name dataName(interest->getName());
-  // dataName.append(m_postfix);
-  // dataName.appendVersion();
-
   auto data = make_shared<Data>();
-  data->setName(dataName);
+  data->setName(interest->getName());
   data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
-
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-
-  if (m_keyLocator.size() > 0) {
-    signatureInfo.setKeyLocator(m_keyLocator);
-  }
-
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-
-  data->setSignature(signature);
+  data->setContent(m_payload);
+  data->setSignature(m_dataSignature);
 
   NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
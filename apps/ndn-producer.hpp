@@ -67,6 +67,9 @@ protected:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  shared_ptr<const ::ndn::Buffer> m_payload; ///< @brief virtual payload, shared by all Data packets
+  Signature m_dataSignature; ///< @brief fake signature with pre-encoded SignatureInfo
 };
 
 } // namespace ndn
@@ -16,9 +16,6 @@
 
 #include "ns3/point-to-point-module.h"
 
-#include "ns3/wifi-net-device.h"
-#include "ns3/sta-wifi-mac.h"
-
 #include "ns3/ndnSIM-module.h"
 
 #include "apps/kite-ms-server.hpp"
@@ -27,8 +24,6 @@
 
 #include "ns3/ndnSIM/NFD/daemon/fw/trace-forwarding.hpp"
 
-#include <boost/algorithm/string.hpp>
-
 NS_LOG_COMPONENT_DEFINE("kite.pullmap");
 
 namespace ns3 {
@@ -60,110 +55,14 @@ getNodeInfo(Ptr<Node> pNode)
   }
 }
 
-void
-StaAssoc(string context, Mac48Address maddr)
-{
-  vector<string> tokens;
-  boost::split(tokens, context, boost::is_any_of("/"));
-  int nodeId = atoi(tokens[2].c_str());
-  int deviceId = atoi(tokens[4].c_str());
-
-  Ptr<Node> node = NodeList::GetNode(nodeId);
-
-  Ptr<ns3::WifiNetDevice> wifiDev = node->GetDevice(deviceId)->GetObject<ns3::WifiNetDevice>();
-  if (wifiDev != nullptr) {
-    Ptr<ns3::StaWifiMac> staMac = wifiDev->GetMac()->GetObject<ns3::StaWifiMac>();
-    if (staMac != nullptr) {
-      Address dest = staMac->GetBssid();
-      Ssid ssid = staMac->GetSsid();
-      NS_LOG_INFO("STA Associated: Node "
-                  << nodeId << ", Device " << deviceId << ", MAC: " << staMac->GetAddress()
-                  << ", to MAC: " << maddr << ", Bssid: " << dest << ", Ssid: " << ssid);
-
-      int i, j;
-      Ptr<Node> pNode, pTargetNode;
-      pTargetNode = NULL;
-      for (i = 0; i < NodeList::GetNNodes(); i++) {
-        pNode = NodeList::GetNode(i);
-        for (j = 0; j < pNode->GetNDevices(); j++) {
-          if (Mac48Address::ConvertFrom(pNode->GetDevice(j)->GetAddress()) == maddr) {
-            pTargetNode = pNode;
-            i = NodeList::GetNNodes();
-            break;
-          }
-        }
-      }
-      if (pTargetNode != NULL) {
-        NS_LOG_INFO("Node found: " << pTargetNode->GetId());
-        pTargetNode->GetObject<ndn::L3Protocol>()->getForwarder()->m_gone = false;
-        // Ptr<Node> mobile = NodeList::GetNode(12);
-        // ndn::KiteMsServer* app = dynamic_cast<ndn::KiteMsServer*>(&(*server->GetApplication(0)));
-        std::string prefix = "/router/" + std::to_string(pTargetNode->GetId());
-        // app->SetAttribute("Locator", StringValue(prefix));
-        ndn::KiteMsMobile* app = dynamic_cast<ndn::KiteMsMobile*>(&(*node->GetApplication(0)));
-        app->m_locator = prefix;
-        Simulator::Schedule(Seconds(0), &ndn::KiteMsMobile::UpdateMapping, app);
-      }
-      else {
-        NS_LOG_INFO("Node not found.");
-      }
-    }
-  }
-}
-
-void
-StaDeAssoc(string context, Mac48Address maddr)
-{
-  // purge stale states on deassociation
-  vector<string> tokens;
-  boost::split(tokens, context, boost::is_any_of("/"));
-  int nodeId = atoi(tokens[2].c_str());
-  int deviceId = atoi(tokens[4].c_str());
-
-  Ptr<Node> node = NodeList::GetNode(nodeId);
-
-  Ptr<ns3::WifiNetDevice> wifiDev = node->GetDevice(deviceId)->GetObject<ns3::WifiNetDevice>();
-  if (wifiDev != nullptr) {
-    Ptr<ns3::StaWifiMac> staMac = wifiDev->GetMac()->GetObject<ns3::StaWifiMac>();
-    if (staMac != nullptr) {
-      Address dest = staMac->GetBssid();
-      Ssid ssid = staMac->GetSsid();
-      NS_LOG_INFO("STA Deassociated: Node " << nodeId << ", Device " << deviceId << " MAC"
-                                            << staMac->GetAddress() << ", to MAC: " << maddr
-                                            << ", Bssid: " << dest << ", Ssid: " << ssid);
-
-      int i, j;
-      Ptr<Node> pNode, pTargetNode;
-      pTargetNode = NULL;
-      for (i = 0; i < NodeList::GetNNodes(); i++) {
-        pNode = NodeList::GetNode(i);
-        for (j = 0; j < pNode->GetNDevices(); j++) {
-          if (Mac48Address::ConvertFrom(pNode->GetDevice(j)->GetAddress()) == maddr) {
-            pTargetNode = pNode;
-            i = NodeList::GetNNodes();
-            break;
-          }
-        }
-      }
-      if (pTargetNode != NULL) {
-        NS_LOG_INFO("Node found: " << pTargetNode->GetId());
-        // pTargetNode->GetObject<ndn::L3Protocol>()->getForwarder()->m_gone = true;
-      }
-      else {
-        NS_LOG_INFO("Node not found.");
-      }
-    }
-  }
-}
-
 int rvList[3] = {12, 13, 14};
 
 void
-doMapUpdate(Ptr<ndn::App> app)
+doMapUpdate(Ptr<ndn::App> app, ndn::Name producer)
 {
   ndn::KiteMsServer* mapApp = dynamic_cast<ndn::KiteMsServer*>(&(*app));
 
-  ndn::Name locator = mapApp->m_locator;
+  ndn::Name locator = mapApp->GetMapping(producer);
   NS_LOG_DEBUG("Update locator: " << locator);
 
   Ptr<Node> node;
@@ -173,17 +72,16 @@ doMapUpdate(Ptr<ndn::App> app)
     node = NodeList::GetNode(rvList[i]);
     NS_LOG_DEBUG("Updating node: " << node->GetId());
     mapApp = dynamic_cast<ndn::KiteMsServer*>(&(*node->GetApplication(0)));
-    mapApp->m_locator = locator;
+    mapApp->SetMapping(producer, locator);
   }
 }
 
 void
-MapUpdate(Ptr<ndn::App> app)
+MapUpdate(Ptr<ndn::App> app, const ndn::Name& producer, const ndn::Name& locator)
 {
-  ndn::KiteMsServer* mapApp = dynamic_cast<ndn::KiteMsServer*>(&(*app));
-
-  NS_LOG_DEBUG("Mapping update, delay update for other MSs: " << app->GetNode()->GetId() << " " << mapApp->m_locator);
-  Simulator::Schedule(Seconds(0.1), &doMapUpdate, app);
+  NS_LOG_DEBUG("Mapping update, delay update for other MSs: " << app->GetNode()->GetId() << " "
+                                                               << locator);
+  Simulator::Schedule(Seconds(0.1), &doMapUpdate, app, producer);
 }
 /**
  * This scenario simulates a very simple network topology:
@@ -430,10 +328,18 @@ main(int argc, char* argv[])
   //                              + "map-"
   //                              + "app.txt");
 
-  Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/Assoc",
-                  MakeCallback(&StaAssoc));
-  Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/DeAssoc",
-                  MakeCallback(&StaDeAssoc));
+  // access points are indexed by MAC address, mobile applications are notified on association
+  ndn::KiteHelper kiteHelper;
+  kiteHelper.AddAccessPoints(nodes);
+  kiteHelper.SetAssociationHandler([](Ptr<Node> station, Ptr<Node> accessPoint) {
+    if (accessPoint == nullptr) {
+      return;
+    }
+    Ptr<ndn::KiteMsMobile> app = DynamicCast<ndn::KiteMsMobile>(station->GetApplication(0));
+    app->m_locator = "/router/" + std::to_string(accessPoint->GetId());
+    Simulator::Schedule(Seconds(0), &ndn::KiteMsMobile::UpdateMapping, app);
+  });
+  kiteHelper.InstallStations(mobileNodes);
 
   Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::KiteMsServer/UpdateCallback",
                                 MakeCallback(&MapUpdate));
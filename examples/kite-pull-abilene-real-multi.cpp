@@ -16,9 +16,6 @@
 
 #include "ns3/point-to-point-module.h"
 
-#include "ns3/wifi-net-device.h"
-#include "ns3/sta-wifi-mac.h"
-
 #include "ns3/ndnSIM-module.h"
 
 #include "apps/kite-rv.hpp"
@@ -26,8 +23,6 @@
 
 #include "ns3/ndnSIM/NFD/daemon/fw/trace-forwarding.hpp"
 
-#include <boost/algorithm/string.hpp>
-
 NS_LOG_COMPONENT_DEFINE("kite.pull-real-multi");
 
 namespace ns3 {
@@ -59,138 +54,13 @@ getNodeInfo(Ptr<Node> pNode)
   }
 }
 
-void
-StaAssoc(string context, Mac48Address maddr)
-{
-  vector<string> tokens;
-  boost::split(tokens, context, boost::is_any_of("/"));
-  int nodeId = atoi(tokens[2].c_str());
-  int deviceId = atoi(tokens[4].c_str());
-
-  Ptr<Node> node = NodeList::GetNode(nodeId);
-
-  Ptr<ns3::WifiNetDevice> wifiDev = node->GetDevice(deviceId)->GetObject<ns3::WifiNetDevice>();
-  if (wifiDev != nullptr) {
-    Ptr<ns3::StaWifiMac> staMac = wifiDev->GetMac()->GetObject<ns3::StaWifiMac>();
-    if (staMac != nullptr) {
-      Address dest = staMac->GetBssid();
-      Ssid ssid = staMac->GetSsid();
-      NS_LOG_INFO("STA Associated: Node "
-                  << nodeId << ", Device " << deviceId << ", MAC: " << staMac->GetAddress()
-                  << ", to MAC: " << maddr << ", Bssid: " << dest << ", Ssid: " << ssid);
-
-      int i, j;
-      Ptr<Node> pNode, pTargetNode;
-      pTargetNode = NULL;
-      for (i = 0; i < NodeList::GetNNodes(); i++) {
-        pNode = NodeList::GetNode(i);
-        for (j = 0; j < pNode->GetNDevices(); j++) {
-          if (Mac48Address::ConvertFrom(pNode->GetDevice(j)->GetAddress()) == maddr) {
-            pTargetNode = pNode;
-            i = NodeList::GetNNodes();
-            break;
-          }
-        }
-      }
-      if (pTargetNode != NULL) {
-        NS_LOG_INFO("Node found: " << pTargetNode->GetId());
-        pTargetNode->GetObject<ndn::L3Protocol>()->getForwarder()->m_gone = false;
-      }
-      else {
-        NS_LOG_INFO("Node not found.");
-      }
-
-      ndn::KitePullMobile* mobileApp =
-        dynamic_cast<ndn::KitePullMobile*>(&(*node->GetApplication(0)));
-      mobileApp->OnAssociation();
-      mobileApp->m_current = pTargetNode->GetId();
-    }
-  }
-}
-
-void
-StaDeAssoc(string context, Mac48Address maddr)
-{
-  // purge stale states on deassociation
-  vector<string> tokens;
-  boost::split(tokens, context, boost::is_any_of("/"));
-  int nodeId = atoi(tokens[2].c_str());
-  int deviceId = atoi(tokens[4].c_str());
-
-  Ptr<Node> node = NodeList::GetNode(nodeId);
-
-  Ptr<ns3::WifiNetDevice> wifiDev = node->GetDevice(deviceId)->GetObject<ns3::WifiNetDevice>();
-  if (wifiDev != nullptr) {
-    Ptr<ns3::StaWifiMac> staMac = wifiDev->GetMac()->GetObject<ns3::StaWifiMac>();
-    if (staMac != nullptr) {
-      Address dest = staMac->GetBssid();
-      Ssid ssid = staMac->GetSsid();
-      NS_LOG_INFO("STA Deassociated: Node " << nodeId << ", Device " << deviceId << " MAC"
-                                            << staMac->GetAddress() << ", to MAC: " << maddr
-                                            << ", Bssid: " << dest << ", Ssid: " << ssid);
-
-      int i, j;
-      Ptr<Node> pNode, pTargetNode;
-      pTargetNode = NULL;
-      for (i = 0; i < NodeList::GetNNodes(); i++) {
-        pNode = NodeList::GetNode(i);
-        for (j = 0; j < pNode->GetNDevices(); j++) {
-          if (Mac48Address::ConvertFrom(pNode->GetDevice(j)->GetAddress()) == maddr) {
-            pTargetNode = pNode;
-            i = NodeList::GetNNodes();
-            break;
-          }
-        }
-      }
-      if (pTargetNode != NULL) {
-        NS_LOG_INFO("Node found: " << pTargetNode->GetId());
-        // pTargetNode->GetObject<ndn::L3Protocol>()->getForwarder()->m_gone = true;
-      }
-      else {
-        NS_LOG_INFO("Node not found.");
-      }
-    }
-  }
-}
-
 int rvList[3] = {12, 13, 14};
 
 void
-RvUpdate(Ptr<ndn::App> app)
+TracingOverhead(Ptr<ndn::App> app, uint64_t messages, uint64_t savedTraces)
 {
-  ndn::KiteRv* rvApp = dynamic_cast<ndn::KiteRv*>(&(*app));
-  ndn::Name attachPrefix = rvApp->m_instancePrefix;
-  NS_LOG_DEBUG("MP now attached to: " << attachPrefix);
-  rvApp->m_attached = true;
-  rvApp->m_attachedPrefix = attachPrefix;
-
-  Ptr<Node> node;
-  for (int i = 0; i < sizeof(rvList) / sizeof(int); i++) {
-    if (rvList[i] == app->GetNode()->GetId())
-      continue;
-    node = NodeList::GetNode(rvList[i]);
-    NS_LOG_DEBUG("Updating node: " << node->GetId());
-    rvApp = dynamic_cast<ndn::KiteRv*>(&(*node->GetApplication(0)));
-    rvApp->m_attached = false;
-    rvApp->m_attachedPrefix = attachPrefix;
-    rvApp->sendBuffered();
-  }
-}
-
-void
-RvAttach(Ptr<ndn::App> app)
-{
-  ndn::KiteRv* rvApp = dynamic_cast<ndn::KiteRv*>(&(*app));
-  if (rvApp->m_attachedPrefix == rvApp->m_instancePrefix) {
-    // no need to update
-    return;
-  }
-
-  NS_LOG_DEBUG("Attached to RV, delay update for other RVs: " << app->GetNode()->GetId());
-  rvApp->m_attached = true;
-  rvApp->m_attachedPrefix = rvApp->m_instancePrefix;
-  rvApp->sendBuffered(); // should not be needed
-  Simulator::Schedule(Seconds(0.1), &RvUpdate, app);
+  std::cerr << "Tracing Overhead (number of messages): " << messages << std::endl;
+  std::cerr << "Trace Interests saved by adaptive refresh: " << savedTraces << std::endl;
 }
 
 /**
@@ -236,6 +106,7 @@ main(int argc, char* argv[])
 
   float traceLifeTime = 2;
   float refreshInterval = 2;
+  bool adaptiveRefresh = false;
 
   int consumerNode = 0;
 
@@ -269,6 +140,8 @@ main(int argc, char* argv[])
   cmd.AddValue("refreshInterval", "refresh interval", refreshInterval); // set to 0 to disable
                                                                         // periodic sending, always
                                                                         // send after relocation
+  cmd.AddValue("adaptiveRefresh", "stretch refresh interval while traces are confirmed",
+               adaptiveRefresh);
 
   cmd.AddValue("consumerNode", "", consumerNode);
 
@@ -472,7 +345,6 @@ main(int argc, char* argv[])
   serverHelper.SetAttribute("Prefix", StringValue(rvPrefix + dataPrefix));
   serverHelper.SetAttribute("Frequency", DoubleValue(consumerCbrFreq));
   serverHelper.SetAttribute("LifeTime", StringValue(interestLifetime));
-  serverHelper.SetAttribute("attachNode", IntegerValue(consumerNode));
   // serverHelper.SetAttribute("Window", StringValue(std::to_string(initialWnd)));
   // serverHelper.SetAttribute("InitialWindowOnTimeout", BooleanValue(false));
   ApplicationContainer serverApp = serverHelper.Install(nodes.Get(11)); // consumer
@@ -496,6 +368,7 @@ main(int argc, char* argv[])
   mobileNodeHelper.SetAttribute("PayloadSize", StringValue("1024")); // the same as consumer window
   mobileNodeHelper.SetAttribute("TraceLifetime", StringValue(std::to_string(traceLifeTime)));
   mobileNodeHelper.SetAttribute("RefreshInterval", StringValue(std::to_string(refreshInterval)));
+  mobileNodeHelper.SetAttribute("AdaptiveRefresh", BooleanValue(adaptiveRefresh));
   ApplicationContainer mobileApp =
     mobileNodeHelper.Install(mobileNodes.Get(0)); // first mobile node
   mobileApp.Stop(Seconds(stopTime - 1));
@@ -509,16 +382,23 @@ main(int argc, char* argv[])
   //                              + (doPull ? "pull" : "nopull") + "-"
   //                              + "app.txt");
 
-  Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/Assoc",
-                  MakeCallback(&StaAssoc));
-  Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/DeAssoc",
-                  MakeCallback(&StaDeAssoc));
-  
-  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::KiteRv/AttachedCallback",
-                  MakeCallback(&RvAttach));
+  // access points are indexed by MAC address, mobile applications are notified on association
+  ndn::KiteHelper kiteHelper;
+  kiteHelper.AddAccessPoints(nodes);
+  kiteHelper.InstallStations(mobileNodes);
+
+  // RVs share attachments of the mobile producer, other RVs learn a new attachment after 100ms
+  NodeContainer rvNodes;
+  for (int i = 0; i < sizeof(rvList) / sizeof(int); i++) {
+    rvNodes.Add(nodes.Get(rvList[i]));
+  }
+  kiteHelper.AddRvGroup(rvNodes, Seconds(0.1));
 
   getNodeInfo(NodeList::GetNode(7));
 
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::KitePullMobile/TracingOverhead",
+                                MakeCallback(&TracingOverhead));
+
   Simulator::Stop(Seconds(stopTime));
   Simulator::Run();
 
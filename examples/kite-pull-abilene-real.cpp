@@ -16,17 +16,12 @@
 
 #include "ns3/point-to-point-module.h"
 
-#include "ns3/wifi-net-device.h"
-#include "ns3/sta-wifi-mac.h"
-
 #include "ns3/ndnSIM-module.h"
 
 #include "apps/kite-pull-mobile.hpp"
 
 #include "ns3/ndnSIM/NFD/daemon/fw/trace-forwarding.hpp"
 
-#include <boost/algorithm/string.hpp>
-
 NS_LOG_COMPONENT_DEFINE("kite.pull");
 
 namespace ns3 {
@@ -59,97 +54,10 @@ getNodeInfo(Ptr<Node> pNode)
 }
 
 void
-StaAssoc(string context, Mac48Address maddr)
+TracingOverhead(Ptr<ndn::App> app, uint64_t messages, uint64_t savedTraces)
 {
-  vector<string> tokens;
-  boost::split(tokens, context, boost::is_any_of("/"));
-  int nodeId = atoi(tokens[2].c_str());
-  int deviceId = atoi(tokens[4].c_str());
-
-  Ptr<Node> node = NodeList::GetNode(nodeId);
-
-  Ptr<ns3::WifiNetDevice> wifiDev = node->GetDevice(deviceId)->GetObject<ns3::WifiNetDevice>();
-  if (wifiDev != nullptr) {
-    Ptr<ns3::StaWifiMac> staMac = wifiDev->GetMac()->GetObject<ns3::StaWifiMac>();
-    if (staMac != nullptr) {
-      Address dest = staMac->GetBssid();
-      Ssid ssid = staMac->GetSsid();
-      NS_LOG_INFO("STA Associated: Node "
-                  << nodeId << ", Device " << deviceId << ", MAC: " << staMac->GetAddress()
-                  << ", to MAC: " << maddr << ", Bssid: " << dest << ", Ssid: " << ssid);
-
-      int i, j;
-      Ptr<Node> pNode, pTargetNode;
-      pTargetNode = NULL;
-      for (i = 0; i < NodeList::GetNNodes(); i++) {
-        pNode = NodeList::GetNode(i);
-        for (j = 0; j < pNode->GetNDevices(); j++) {
-          if (Mac48Address::ConvertFrom(pNode->GetDevice(j)->GetAddress()) == maddr) {
-            pTargetNode = pNode;
-            i = NodeList::GetNNodes();
-            break;
-          }
-        }
-      }
-      if (pTargetNode != NULL) {
-        NS_LOG_INFO("Node found: " << pTargetNode->GetId());
-        pTargetNode->GetObject<ndn::L3Protocol>()->getForwarder()->m_gone = false;
-      }
-      else {
-        NS_LOG_INFO("Node not found.");
-      }
-
-      ndn::KitePullMobile* mobileApp =
-        dynamic_cast<ndn::KitePullMobile*>(&(*node->GetApplication(0)));
-      mobileApp->OnAssociation();
-      mobileApp->m_current = pTargetNode->GetId();
-    }
-  }
-}
-
-void
-StaDeAssoc(string context, Mac48Address maddr)
-{
-  // purge stale states on deassociation
-  vector<string> tokens;
-  boost::split(tokens, context, boost::is_any_of("/"));
-  int nodeId = atoi(tokens[2].c_str());
-  int deviceId = atoi(tokens[4].c_str());
-
-  Ptr<Node> node = NodeList::GetNode(nodeId);
-
-  Ptr<ns3::WifiNetDevice> wifiDev = node->GetDevice(deviceId)->GetObject<ns3::WifiNetDevice>();
-  if (wifiDev != nullptr) {
-    Ptr<ns3::StaWifiMac> staMac = wifiDev->GetMac()->GetObject<ns3::StaWifiMac>();
-    if (staMac != nullptr) {
-      Address dest = staMac->GetBssid();
-      Ssid ssid = staMac->GetSsid();
-      NS_LOG_INFO("STA Deassociated: Node " << nodeId << ", Device " << deviceId << " MAC"
-                                            << staMac->GetAddress() << ", to MAC: " << maddr
-                                            << ", Bssid: " << dest << ", Ssid: " << ssid);
-
-      int i, j;
-      Ptr<Node> pNode, pTargetNode;
-      pTargetNode = NULL;
-      for (i = 0; i < NodeList::GetNNodes(); i++) {
-        pNode = NodeList::GetNode(i);
-        for (j = 0; j < pNode->GetNDevices(); j++) {
-          if (Mac48Address::ConvertFrom(pNode->GetDevice(j)->GetAddress()) == maddr) {
-            pTargetNode = pNode;
-            i = NodeList::GetNNodes();
-            break;
-          }
-        }
-      }
-      if (pTargetNode != NULL) {
-        NS_LOG_INFO("Node found: " << pTargetNode->GetId());
-        // pTargetNode->GetObject<ndn::L3Protocol>()->getForwarder()->m_gone = true;
-      }
-      else {
-        NS_LOG_INFO("Node not found.");
-      }
-    }
-  }
+  std::cerr << "Tracing Overhead (number of messages): " << messages << std::endl;
+  std::cerr << "Trace Interests saved by adaptive refresh: " << savedTraces << std::endl;
 }
 
 /**
@@ -195,6 +103,7 @@ main(int argc, char* argv[])
 
   float traceLifeTime = 2;
   float refreshInterval = 2;
+  bool adaptiveRefresh = false;
 
   float consumerCbrFreq = 1.0;
 
@@ -226,6 +135,8 @@ main(int argc, char* argv[])
   cmd.AddValue("refreshInterval", "refresh interval", refreshInterval); // set to 0 to disable
                                                                         // periodic sending, always
                                                                         // send after relocation
+  cmd.AddValue("adaptiveRefresh", "stretch refresh interval while traces are confirmed",
+               adaptiveRefresh);
 
   cmd.AddValue("consumerNode", "", consumerNode);
 
@@ -419,7 +330,6 @@ main(int argc, char* argv[])
   serverHelper.SetAttribute("Prefix", StringValue(rvPrefix + dataPrefix));
   serverHelper.SetAttribute("Frequency", DoubleValue(consumerCbrFreq));
   serverHelper.SetAttribute("LifeTime", StringValue(interestLifetime));
-  serverHelper.SetAttribute("attachNode", IntegerValue(consumerNode));
   // serverHelper.SetAttribute("Window", StringValue(std::to_string(initialWnd)));
   // serverHelper.SetAttribute("InitialWindowOnTimeout", BooleanValue(false));
   ApplicationContainer serverApp = serverHelper.Install(nodes.Get(11)); // consumer
@@ -440,6 +350,7 @@ main(int argc, char* argv[])
   mobileNodeHelper.SetAttribute("PayloadSize", StringValue("1024")); // the same as consumer window
   mobileNodeHelper.SetAttribute("TraceLifetime", StringValue(std::to_string(traceLifeTime)));
   mobileNodeHelper.SetAttribute("RefreshInterval", StringValue(std::to_string(refreshInterval)));
+  mobileNodeHelper.SetAttribute("AdaptiveRefresh", BooleanValue(adaptiveRefresh));
   ApplicationContainer mobileApp =
     mobileNodeHelper.Install(mobileNodes.Get(0)); // first mobile node
   mobileApp.Stop(Seconds(stopTime - 1));
@@ -453,10 +364,13 @@ main(int argc, char* argv[])
   //                              + (doPull ? "pull" : "nopull") + "-"
   //                              + "app.txt");
 
-  Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/Assoc",
-                  MakeCallback(&StaAssoc));
-  Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/DeAssoc",
-                  MakeCallback(&StaDeAssoc));
+  // access points are indexed by MAC address, mobile applications are notified on association
+  ndn::KiteHelper kiteHelper;
+  kiteHelper.AddAccessPoints(nodes);
+  kiteHelper.InstallStations(mobileNodes);
+
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::KitePullMobile/TracingOverhead",
+                                MakeCallback(&TracingOverhead));
 
   Simulator::Stop(Seconds(stopTime));
   Simulator::Run();
@@ -16,9 +16,6 @@
 
 #include "ns3/point-to-point-module.h"
 
-#include "ns3/wifi-net-device.h"
-#include "ns3/sta-wifi-mac.h"
-
 #include "ns3/ndnSIM-module.h"
 
 #include "apps/kite-upload-server.hpp"
@@ -26,8 +23,6 @@
 
 #include "ns3/ndnSIM/NFD/daemon/fw/trace-forwarding.hpp"
 
-#include <boost/algorithm/string.hpp>
-
 NS_LOG_COMPONENT_DEFINE("kite.upload");
 
 namespace ns3 {
@@ -60,31 +55,10 @@ getNodeInfo(Ptr<Node> pNode)
 }
 
 void
-StaAssociation(string context, Mac48Address maddr)
+TracingOverhead(Ptr<ndn::App> app, uint64_t messages, uint64_t savedTraces)
 {
-  vector<string> tokens;
-  boost::split(tokens, context, boost::is_any_of("/"));
-  int nodeId = atoi(tokens[2].c_str());
-  int deviceId = atoi(tokens[4].c_str());
-  NS_LOG_INFO("STA Associated: Node " << nodeId << ", Device "
-                                      << deviceId /* << " MAC" << mac->GetAddress()*/
-                                      << ", to MAC: " << maddr << ", context: " << context);
-
-  Ptr<Node> node = NodeList::GetNode(nodeId);
-
-  Ptr<ns3::WifiNetDevice> wifiDev = node->GetDevice(deviceId)->GetObject<ns3::WifiNetDevice>();
-  if (wifiDev != nullptr) {
-    Ptr<ns3::StaWifiMac> staMac = wifiDev->GetMac()->GetObject<ns3::StaWifiMac>();
-    if (staMac != nullptr) {
-      Address dest = staMac->GetBssid();
-      Ssid ssid = staMac->GetSsid();
-      NS_LOG_INFO("Node " << nodeId << ", Device " << deviceId << ", Mac: " << staMac->GetAddress()
-                          << ", Bssid: " << dest << ", Ssid: " << ssid);
-      ndn::KiteUploadMobile* mobileApp =
-        dynamic_cast<ndn::KiteUploadMobile*>(&(*node->GetApplication(0)));
-      mobileApp->OnAssociation();
-    }
-  }
+  NS_LOG_UNCOND("Tracing Overhead (number of messages): " << messages);
+  NS_LOG_UNCOND("Trace Interests saved by adaptive refresh: " << savedTraces);
 }
 
 /**
@@ -123,6 +97,7 @@ main(int argc, char* argv[])
 
   float traceLifetime = 1;
   float refreshInterval = 1;
+  bool adaptiveRefresh = false;
 
   bool doPull = false;
   bool prolongTrace = false;
@@ -143,6 +118,8 @@ main(int argc, char* argv[])
   cmd.AddValue("refreshInterval", "refresh interval", refreshInterval); // set to 0 to disable
                                                                         // periodic sending, always
                                                                         // send after relocation
+  cmd.AddValue("adaptiveRefresh", "stretch refresh interval while traces are confirmed",
+               adaptiveRefresh);
 
   cmd.AddValue("doPull", "enable pulling", doPull);
   cmd.AddValue("prolongTrace", "extend trace lifetime on dataflow", prolongTrace);
@@ -318,6 +295,7 @@ main(int argc, char* argv[])
   mobileNodeHelper.SetAttribute("PayloadSize", StringValue("1024"));
   mobileNodeHelper.SetAttribute("TraceLifetime", StringValue(std::to_string(traceLifetime)));
   mobileNodeHelper.SetAttribute("RefreshInterval", StringValue(std::to_string(refreshInterval)));
+  mobileNodeHelper.SetAttribute("AdaptiveRefresh", BooleanValue(adaptiveRefresh));
   ApplicationContainer mobileApp =
     mobileNodeHelper.Install(mobileNodes.Get(0)); // first mobile node
   mobileApp.Stop(Seconds(stopTime - 1));
@@ -328,8 +306,13 @@ main(int argc, char* argv[])
   ndn::L3RateTracer::Install(nodes.Get(11), "rate-trace.txt");
   ndn::AppDelayTracer::Install(nodes.Get(11), "app-delays-trace.txt");
 
-  Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/Assoc",
-                  MakeCallback(&StaAssociation));
+  // access points are indexed by MAC address, mobile applications are notified on association
+  ndn::KiteHelper kiteHelper;
+  kiteHelper.AddAccessPoints(nodes);
+  kiteHelper.InstallStations(mobileNodes);
+
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::KiteUploadMobile/TracingOverhead",
+                                MakeCallback(&TracingOverhead));
 
   Simulator::Stop(Seconds(stopTime));
   Simulator::Run();
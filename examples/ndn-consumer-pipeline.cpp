@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-consumer-pipeline.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+namespace ns3 {
+
+/**
+ * This scenario transfers a large amount of data over a long fat link:
+ *
+ *
+ *      +----------+     1Gbps      +--------+    100Mbps     +----------+
+ *      | consumer | <------------> | router | <------------> | producer |
+ *      +----------+         1ms    +--------+          50ms  +----------+
+ *
+ *
+ * Consumer pipelines Interests under control of the selected congestion controller
+ * (Aimd, Cubic, or Bbr).  The router signals congestion with Nacks when its queue overflows.
+ * Congestion window and pacing rate of the consumer are printed as they change.
+ *
+ * To run scenario and see what is happening, use the following command:
+ *
+ *     ./waf --run="ndn-consumer-pipeline --cc=Cubic"
+ */
+
+static void
+PrintValue(std::string name, double oldValue, double newValue)
+{
+  std::cout << Simulator::Now().ToDouble(Time::S) << "\t" << name << "\t" << newValue << "\n";
+}
+
+int
+main(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("100"));
+
+  std::string cc = "Aimd";
+  bool pacing = false;
+
+  CommandLine cmd;
+  cmd.AddValue("cc", "Congestion controller: Aimd, Cubic, or Bbr", cc);
+  cmd.AddValue("pacing", "Pace Interests of window-based controllers over RTT", pacing);
+  cmd.Parse(argc, argv);
+
+  // Creating nodes
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+  p2p.SetChannelAttribute("Delay", StringValue("1ms"));
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  p2p.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+  p2p.SetChannelAttribute("Delay", StringValue("50ms"));
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+
+  // Install NDN stack on all nodes
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.setCsSize(1);
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/prefix", "/localhost/nfd/strategy/best-route");
+
+  // Consumer
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerPipeline");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("CongestionControl", StringValue("ns3::ndn::CongestionControl" + cc));
+  consumerHelper.SetAttribute("Pacing", BooleanValue(pacing));
+  ApplicationContainer consumer = consumerHelper.Install(nodes.Get(0));
+
+  consumer.Get(0)->TraceConnectWithoutContext("CongestionWindow",
+                                              MakeBoundCallback(&PrintValue, "cwnd"));
+  consumer.Get(0)->TraceConnectWithoutContext("PacingRate", MakeBoundCallback(&PrintValue, "rate"));
+
+  // Producer
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(nodes.Get(2));
+
+  ndn::L3RateTracer::InstallAll("consumer-pipeline-rate-trace.txt", Seconds(1.0));
+
+  Simulator::Stop(Seconds(20.0));
+
+  Simulator::Run();
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
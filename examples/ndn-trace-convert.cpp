@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-trace-convert.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <fstream>
+
+namespace ns3 {
+
+/**
+ * This program converts a trace written in the binary format by one of the tracers, e.g.,
+ *
+ *     L3RateTracer::InstallAll("rate-trace.bin", Seconds(1.0), ndn::TraceSink::BINARY);
+ *
+ * to the tab-separated values, the same as the tracer would write in the text format:
+ *
+ *     ./waf --run="ndn-trace-convert --input=rate-trace.bin --output=rate-trace.txt"
+ *
+ * If output is not specified, the values are written to the standard output.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string input;
+  std::string output = "-";
+
+  CommandLine cmd;
+  cmd.AddValue("input", "Binary trace file", input);
+  cmd.AddValue("output", "Text trace file, - for the standard output", output);
+  cmd.Parse(argc, argv);
+
+  std::ifstream is(input.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    std::cerr << "Cannot open " << input << std::endl;
+    return 1;
+  }
+
+  std::ofstream file;
+  if (output != "-") {
+    file.open(output.c_str(), std::ios_base::out | std::ios_base::trunc);
+    if (!file.is_open()) {
+      std::cerr << "Cannot open " << output << " for writing" << std::endl;
+      return 1;
+    }
+  }
+  std::ostream& os = output != "-" ? file : std::cout;
+
+  try {
+    ndn::BinaryTraceReader reader(is);
+    reader.ConvertToText(os);
+  }
+  catch (const ndn::BinaryTraceReader::Error& e) {
+    std::cerr << "Cannot convert " << input << ": " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-trace-replay.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/ndn-request-trace.hpp"
+
+#include <fstream>
+
+namespace ns3 {
+
+/**
+ * This scenario replays a recorded request log over a very simple network topology:
+ *
+ *
+ *      +----------+     1Mbps      +--------+     1Mbps      +----------+
+ *      | consumer | <------------> | router | <------------> | producer |
+ *      +----------+         10ms   +--------+          10ms  +----------+
+ *
+ *
+ * Consumer replays requests from the binary request trace, expressing Interests for
+ * /prefix/<name from the trace>/<name id> at the recorded times.  The router caches the
+ * Data packets, so repeated requests for popular names are satisfied from the router's
+ * content store.
+ *
+ * A text request log (lines "<time-in-seconds> <name> [<size>]") can be converted to the binary
+ * trace before the simulation starts:
+ *
+ *     ./waf --run="ndn-trace-replay --textTrace=requests.log --trace=requests.bin"
+ *
+ * Once converted, the binary trace can be replayed directly:
+ *
+ *     NS_LOG=ndn.ConsumerTraceReplay ./waf --run="ndn-trace-replay --trace=requests.bin"
+ */
+
+int
+main(int argc, char* argv[])
+{
+  // setting default parameters for PointToPoint links and channels
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  std::string trace = "requests.bin";
+  std::string textTrace;
+  double duration = 100.0;
+
+  CommandLine cmd;
+  cmd.AddValue("trace", "Binary request trace to replay", trace);
+  cmd.AddValue("textTrace", "Text request log to convert into the binary trace first", textTrace);
+  cmd.AddValue("duration", "Simulation duration in seconds", duration);
+  cmd.Parse(argc, argv);
+
+  if (!textTrace.empty()) {
+    std::ifstream is(textTrace.c_str());
+    if (!is.is_open()) {
+      NS_FATAL_ERROR("Cannot open request log [" << textTrace << "]");
+    }
+    try {
+      uint64_t nRecords = ndn::RequestTraceWriter::convertText(is, trace);
+      std::cout << "Converted " << nRecords << " requests into " << trace << std::endl;
+    }
+    catch (const ndn::RequestTrace::Error& error) {
+      NS_FATAL_ERROR(error.what());
+    }
+  }
+
+  // Creating nodes
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  // Connecting nodes using two links
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+
+  // Install NDN stack on all nodes
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.setCsSize(1000);
+  ndnHelper.InstallAll();
+
+  // Choosing forwarding strategy
+  ndn::StrategyChoiceHelper::InstallAll("/prefix", "/localhost/nfd/strategy/best-route");
+
+  // Installing applications
+
+  // Consumer
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerTraceReplay");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("TraceFile", StringValue(trace));
+  consumerHelper.Install(nodes.Get(0)); // first node
+
+  // Producer
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  // Producer will reply to all requests starting with /prefix
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(nodes.Get(2)); // last node
+
+  Simulator::Stop(Seconds(duration));
+
+  Simulator::Run();
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,269 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-kite-helper.hpp"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include "ns3/log.h"
+#include "ns3/config.h"
+#include "ns3/callback.h"
+#include "ns3/simulator.h"
+
+#include <boost/lexical_cast.hpp>
+
+NS_LOG_COMPONENT_DEFINE("ndn.KiteHelper");
+
+namespace ns3 {
+namespace ndn {
+
+KiteHelper::KiteHelper()
+{
+}
+
+uint64_t
+KiteHelper::MacKey(const Mac48Address& address)
+{
+  uint8_t buffer[6];
+  address.CopyTo(buffer);
+
+  uint64_t key = 0;
+  for (uint8_t byte : buffer) {
+    key = (key << 8) | byte;
+  }
+  return key;
+}
+
+void
+KiteHelper::AddAccessPoints(const NodeContainer& accessPoints)
+{
+  for (NodeContainer::Iterator node = accessPoints.Begin(); node != accessPoints.End(); node++) {
+    Ptr<L3Protocol> l3 = (*node)->GetObject<L3Protocol>();
+
+    for (uint32_t deviceId = 0; deviceId < (*node)->GetNDevices(); deviceId++) {
+      Ptr<NetDevice> device = (*node)->GetDevice(deviceId);
+      if (!Mac48Address::IsMatchingType(device->GetAddress())) {
+        continue;
+      }
+
+      Mac48Address address = Mac48Address::ConvertFrom(device->GetAddress());
+      AccessPoint& accessPoint = m_accessPoints[MacKey(address)];
+      accessPoint.node = *node;
+      accessPoint.device = device;
+      accessPoint.face = l3 != nullptr ? l3->getFaceByNetDevice(device) : nullptr;
+    }
+  }
+}
+
+void
+KiteHelper::InstallStations(const NodeContainer& stations)
+{
+  for (NodeContainer::Iterator node = stations.Begin(); node != stations.End(); node++) {
+    auto entry = m_stations.emplace((*node)->GetId(), Station());
+    Station& station = entry.first->second;
+    station.node = *node;
+    station.pullMobiles.clear();
+    station.uploadMobiles.clear();
+
+    for (uint32_t appId = 0; appId < (*node)->GetNApplications(); appId++) {
+      Ptr<Application> app = (*node)->GetApplication(appId);
+      if (Ptr<KitePullMobile> pullMobile = DynamicCast<KitePullMobile>(app)) {
+        station.pullMobiles.push_back(pullMobile);
+      }
+      else if (Ptr<KiteUploadMobile> uploadMobile = DynamicCast<KiteUploadMobile>(app)) {
+        station.uploadMobiles.push_back(uploadMobile);
+      }
+    }
+
+    if (!entry.second) {
+      // callbacks are already connected, connecting them again would notify the mobiles twice
+      NS_LOG_DEBUG("Station " << (*node)->GetId() << " already installed, refreshed applications");
+      continue;
+    }
+
+    // paths resolve to nothing for devices other than StaWifiMac ones
+    for (uint32_t deviceId = 0; deviceId < (*node)->GetNDevices(); deviceId++) {
+      std::string path = "/NodeList/" + boost::lexical_cast<std::string>((*node)->GetId())
+                         + "/DeviceList/" + boost::lexical_cast<std::string>(deviceId)
+                         + "/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/";
+
+      Config::ConnectWithoutContext(path + "Assoc",
+                                    MakeBoundCallback(&KiteHelper::StaAssoc, this, &station));
+      Config::ConnectWithoutContext(path + "DeAssoc",
+                                    MakeBoundCallback(&KiteHelper::StaDeAssoc, this, &station));
+    }
+  }
+}
+
+void
+KiteHelper::SetAssociationHandler(AssociationHandler handler)
+{
+  m_associationHandler = handler;
+}
+
+void
+KiteHelper::SetDeassociationHandler(AssociationHandler handler)
+{
+  m_deassociationHandler = handler;
+}
+
+const KiteHelper::AccessPoint*
+KiteHelper::findAccessPoint(const Mac48Address& address) const
+{
+  auto entry = m_accessPoints.find(MacKey(address));
+  if (entry == m_accessPoints.end()) {
+    return nullptr;
+  }
+  return &entry->second;
+}
+
+Ptr<Node>
+KiteHelper::GetAccessPoint(const Mac48Address& address) const
+{
+  const AccessPoint* accessPoint = findAccessPoint(address);
+  return accessPoint != nullptr ? accessPoint->node : nullptr;
+}
+
+shared_ptr<Face>
+KiteHelper::GetAccessPointFace(const Mac48Address& address) const
+{
+  const AccessPoint* accessPoint = findAccessPoint(address);
+  return accessPoint != nullptr ? accessPoint->face : nullptr;
+}
+
+Ptr<Node>
+KiteHelper::GetCurrentAccessPoint(Ptr<Node> station) const
+{
+  auto entry = m_stations.find(station->GetId());
+  if (entry == m_stations.end()) {
+    return nullptr;
+  }
+  return entry->second.accessPoint;
+}
+
+void
+KiteHelper::StaAssoc(KiteHelper* helper, Station* station, Mac48Address address)
+{
+  const AccessPoint* accessPoint = helper->findAccessPoint(address);
+  if (accessPoint != nullptr) {
+    NS_LOG_INFO("STA Associated: Node " << station->node->GetId() << " to Node "
+                                        << accessPoint->node->GetId() << ", MAC: " << address);
+    accessPoint->node->GetObject<L3Protocol>()->getForwarder()->m_gone = false;
+    station->accessPoint = accessPoint->node;
+  }
+  else {
+    NS_LOG_INFO("STA Associated: Node " << station->node->GetId() << " to unknown MAC: "
+                                        << address);
+    station->accessPoint = nullptr;
+  }
+
+  for (const auto& mobile : station->pullMobiles) {
+    mobile->OnAssociation();
+    if (station->accessPoint != nullptr) {
+      mobile->m_current = station->accessPoint->GetId();
+    }
+  }
+  for (const auto& mobile : station->uploadMobiles) {
+    mobile->OnAssociation();
+  }
+
+  if (helper->m_associationHandler) {
+    helper->m_associationHandler(station->node, station->accessPoint);
+  }
+}
+
+void
+KiteHelper::StaDeAssoc(KiteHelper* helper, Station* station, Mac48Address address)
+{
+  NS_LOG_INFO("STA Deassociated: Node " << station->node->GetId() << " from MAC: " << address);
+
+  Ptr<Node> accessPoint = helper->GetAccessPoint(address);
+  station->accessPoint = nullptr;
+
+  if (helper->m_deassociationHandler) {
+    helper->m_deassociationHandler(station->node, accessPoint);
+  }
+}
+
+size_t
+KiteHelper::AddRvGroup(const NodeContainer& rvNodes, Time updateDelay /* = Seconds(0.1)*/)
+{
+  size_t group = m_rvGroups.size();
+  m_rvGroups.push_back(RvGroup());
+  m_rvGroups.back().updateDelay = updateDelay;
+
+  for (NodeContainer::Iterator node = rvNodes.Begin(); node != rvNodes.End(); node++) {
+    for (uint32_t appId = 0; appId < (*node)->GetNApplications(); appId++) {
+      Ptr<KiteRv> rv = DynamicCast<KiteRv>((*node)->GetApplication(appId));
+      if (rv == nullptr) {
+        continue;
+      }
+
+      m_rvGroups.back().members.push_back(rv);
+      rv->TraceConnectWithoutContext("AttachedCallback",
+                                     MakeBoundCallback(&KiteHelper::RvAttached, this, group));
+    }
+  }
+
+  NS_ASSERT_MSG(!m_rvGroups.back().members.empty(), "KiteRv should be installed on the RV nodes");
+  return group;
+}
+
+const std::vector<Ptr<KiteRv>>&
+KiteHelper::GetRvGroup(size_t group) const
+{
+  return m_rvGroups.at(group).members;
+}
+
+void
+KiteHelper::RvAttached(KiteHelper* helper, size_t group, Ptr<App> app, const Name& producer)
+{
+  Ptr<KiteRv> rv = DynamicCast<KiteRv>(app);
+  if (rv->GetAttachment(producer) == rv->m_instancePrefix) {
+    // no need to update
+    return;
+  }
+
+  NS_LOG_DEBUG("MP " << producer << " attached to " << rv->m_instancePrefix
+                     << ", delay update for other RVs");
+  rv->SetAttachment(producer, rv->m_instancePrefix);
+  rv->sendBuffered(producer);
+
+  Simulator::Schedule(helper->m_rvGroups[group].updateDelay, &KiteHelper::RvUpdate, helper, group,
+                      rv, producer, rv->m_instancePrefix);
+}
+
+void
+KiteHelper::RvUpdate(size_t group, Ptr<KiteRv> origin, Name producer, Name attachedPrefix)
+{
+  for (const auto& rv : m_rvGroups[group].members) {
+    if (rv == origin) {
+      continue;
+    }
+
+    NS_LOG_DEBUG("Updating node " << rv->GetNode()->GetId() << ": MP " << producer
+                                  << " now attached to " << attachedPrefix);
+    rv->SetAttachment(producer, attachedPrefix);
+    rv->sendBuffered(producer);
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_HELPER_NDN_KITE_HELPER_HPP
+#define NDNSIM_HELPER_NDN_KITE_HELPER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ndnSIM/apps/kite-rv.hpp"
+#include "ns3/ndnSIM/apps/kite-pull-mobile.hpp"
+#include "ns3/ndnSIM/apps/kite-upload-mobile.hpp"
+
+#include "ns3/node-container.h"
+#include "ns3/net-device.h"
+#include "ns3/mac48-address.h"
+#include "ns3/nstime.h"
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to wire mobility of KITE mobile producers
+ *
+ * The helper indexes NetDevices of access points by MAC address once, and connects Assoc and
+ * DeAssoc trace sources of every station (StaWifiMac) with callbacks bound to the station, so an
+ * association event costs O(1) regardless of the number of nodes and devices.  On association,
+ * the AP forwarder is marked as not gone, and KitePullMobile and KiteUploadMobile applications of
+ * the station are notified.  Scenario-specific actions can be added with
+ * SetAssociationHandler/SetDeassociationHandler.
+ *
+ * The helper also keeps groups of KiteRv instances that share attachment information: when a
+ * mobile producer attaches to one RV of a group, the other members are updated after a delay.
+ *
+ * The helper must outlive the simulation, as the connected callbacks refer to it.
+ */
+class KiteHelper
+{
+public:
+  /**
+   * @brief Scenario-specific action on (de)association of a station
+   * @param station station node
+   * @param accessPoint AP node, nullptr if the AP has not been indexed
+   */
+  typedef std::function<void(Ptr<Node> station, Ptr<Node> accessPoint)> AssociationHandler;
+
+  KiteHelper();
+
+  /**
+   * @brief Index NetDevices of access points by their MAC addresses
+   *
+   * NDN stack should be installed on the nodes beforehand for AP faces to be indexed.
+   */
+  void
+  AddAccessPoints(const NodeContainer& accessPoints);
+
+  /**
+   * @brief Connect Assoc and DeAssoc of all StaWifiMac devices of the stations
+   *
+   * KITE mobile applications should be installed on the stations beforehand.  Installing a
+   * station again only refreshes the list of its applications.
+   */
+  void
+  InstallStations(const NodeContainer& stations);
+
+  void
+  SetAssociationHandler(AssociationHandler handler);
+
+  void
+  SetDeassociationHandler(AssociationHandler handler);
+
+  /**
+   * @brief Get AP node owning a device with the MAC address, nullptr if not indexed
+   */
+  Ptr<Node>
+  GetAccessPoint(const Mac48Address& address) const;
+
+  /**
+   * @brief Get face of the AP device with the MAC address, nullptr if not indexed
+   */
+  shared_ptr<Face>
+  GetAccessPointFace(const Mac48Address& address) const;
+
+  /**
+   * @brief Get AP node, to which the station is currently associated, nullptr if none
+   */
+  Ptr<Node>
+  GetCurrentAccessPoint(Ptr<Node> station) const;
+
+  /**
+   * @brief Make KiteRv instances on the nodes share attachments of mobile producers
+   * @param rvNodes nodes with KiteRv installed
+   * @param updateDelay delay before other members of the group learn a new attachment
+   * @return index of the group
+   */
+  size_t
+  AddRvGroup(const NodeContainer& rvNodes, Time updateDelay = Seconds(0.1));
+
+  const std::vector<Ptr<KiteRv>>&
+  GetRvGroup(size_t group) const;
+
+private:
+  struct AccessPoint {
+    Ptr<Node> node;
+    Ptr<NetDevice> device;
+    shared_ptr<Face> face;
+  };
+
+  struct Station {
+    Ptr<Node> node;
+    Ptr<Node> accessPoint;
+    std::vector<Ptr<KitePullMobile>> pullMobiles;
+    std::vector<Ptr<KiteUploadMobile>> uploadMobiles;
+  };
+
+  struct RvGroup {
+    std::vector<Ptr<KiteRv>> members;
+    Time updateDelay;
+  };
+
+  static uint64_t
+  MacKey(const Mac48Address& address);
+
+  const AccessPoint*
+  findAccessPoint(const Mac48Address& address) const;
+
+  static void
+  StaAssoc(KiteHelper* helper, Station* station, Mac48Address address);
+
+  static void
+  StaDeAssoc(KiteHelper* helper, Station* station, Mac48Address address);
+
+  static void
+  RvAttached(KiteHelper* helper, size_t group, Ptr<App> app, const Name& producer);
+
+  void
+  RvUpdate(size_t group, Ptr<KiteRv> origin, Name producer, Name attachedPrefix);
+
+private:
+  std::unordered_map<uint64_t, AccessPoint> m_accessPoints; // by MAC address
+  std::unordered_map<uint32_t, Station> m_stations; // by node id, references stay valid
+  std::vector<RvGroup> m_rvGroups;
+
+  AssociationHandler m_associationHandler;
+  AssociationHandler m_deassociationHandler;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_HELPER_NDN_KITE_HELPER_HPP
@@ -18,6 +18,7 @@
  **/
 
 #include "ndn-app-link-service.hpp"
+#include "ndn-shared-app-link-service.hpp"
 
 #include "ns3/log.h"
 #include "ns3/packet.h"
@@ -35,6 +36,17 @@ namespace ndn {
 AppLinkService::AppLinkService(Ptr<App> app)
   : m_node(app->GetNode())
   , m_app(app)
+  , m_shared(nullptr)
+{
+  NS_LOG_FUNCTION(this << app);
+
+  NS_ASSERT(m_app != 0);
+}
+
+AppLinkService::AppLinkService(Ptr<App> app, SharedAppLinkService& shared)
+  : m_node(app->GetNode())
+  , m_app(app)
+  , m_shared(&shared)
 {
   NS_LOG_FUNCTION(this << app);
 
@@ -78,18 +90,30 @@ AppLinkService::doSendNack(const lp::Nack& nack)
 void
 AppLinkService::onReceiveInterest(const Interest& interest)
 {
+  if (m_shared != nullptr) {
+    m_shared->onReceiveInterest(m_app, interest);
+    return;
+  }
   this->receiveInterest(interest);
 }
 
 void
 AppLinkService::onReceiveData(const Data& data)
 {
+  if (m_shared != nullptr) {
+    m_shared->onReceiveData(m_app, data);
+    return;
+  }
   this->receiveData(data);
 }
 
 void
 AppLinkService::onReceiveNack(const lp::Nack& nack)
 {
+  if (m_shared != nullptr) {
+    m_shared->onReceiveNack(m_app, nack);
+    return;
+  }
   this->receiveNack(nack);
 }
 
@@ -31,6 +31,7 @@ class Node;
 namespace ndn {
 
 class App;
+class SharedAppLinkService;
 
 /**
  * \ingroup ndn-face
@@ -46,6 +47,15 @@ public:
    */
   AppLinkService(Ptr<App> app);
 
+  /**
+   * \brief Create link service that passes packets of the application through the node's
+   *        shared application face
+   *
+   * The created link service is not attached to any face.  All packets received from the
+   * application are handed over to \p shared, on behalf of \p app.
+   */
+  AppLinkService(Ptr<App> app, SharedAppLinkService& shared);
+
   virtual ~AppLinkService();
 
 public:
@@ -78,6 +88,7 @@ private:
 private:
   Ptr<Node> m_node;
   Ptr<App> m_app;
+  SharedAppLinkService* m_shared;
 };
 
 } // namespace ndn
@@ -32,6 +32,8 @@
 #include "ns3/boolean.h"
 
 #include "ndn-net-device-transport.hpp"
+#include "ndn-shared-app-link-service.hpp"
+#include "null-transport.hpp"
 
 #include "../helper/ndn-stack-helper.hpp"
 #include "cs/ndn-content-store.hpp"
@@ -56,6 +58,8 @@
 
 #include "ns3/ndnSIM/NFD/core/config-file.hpp"
 
+#include "ns3/ndnSIM/NFD/daemon/table/pit-entry.hpp"
+
 #include <ndn-cxx/mgmt/dispatcher.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.L3Protocol");
@@ -112,7 +116,28 @@ L3Protocol::GetTypeId(void)
       .AddAttribute("ProlongTrace", "Extend trace lifetime on dataflow", BooleanValue(false),
                     MakeBooleanAccessor(&L3Protocol::m_prolongTrace), MakeBooleanChecker())
       .AddAttribute("RemoveTrace", "Remove trace on NACK", BooleanValue(false),
-                    MakeBooleanAccessor(&L3Protocol::m_removeTraceOnNack), MakeBooleanChecker());
+                    MakeBooleanAccessor(&L3Protocol::m_removeTraceOnNack), MakeBooleanChecker())
+
+      .AddAttribute("TraceAccounting",
+                    "Count creations, expirations, and other events of trace entries",
+                    BooleanValue(false), MakeBooleanAccessor(&L3Protocol::m_traceAccounting),
+                    MakeBooleanChecker())
+
+      .AddAttribute("CsTracing", "Fire trace sources of the NFD content store",
+                    BooleanValue(false), MakeBooleanAccessor(&L3Protocol::m_csTracing),
+                    MakeBooleanChecker())
+      .AddTraceSource("CsHits", "Interest satisfied by the NFD content store (if CsTracing)",
+                      MakeTraceSourceAccessor(&L3Protocol::m_csHits),
+                      "ns3::ndn::L3Protocol::CsHitsCallback")
+      .AddTraceSource("CsMisses", "Interest not found in the NFD content store (if CsTracing)",
+                      MakeTraceSourceAccessor(&L3Protocol::m_csMisses),
+                      "ns3::ndn::L3Protocol::CsMissesCallback")
+      .AddTraceSource("CsInserts", "Data inserted into the NFD content store (if CsTracing)",
+                      MakeTraceSourceAccessor(&L3Protocol::m_csInserts),
+                      "ns3::ndn::L3Protocol::CsEntryCallback")
+      .AddTraceSource("CsEvictions", "Data evicted from the NFD content store (if CsTracing)",
+                      MakeTraceSourceAccessor(&L3Protocol::m_csEvictions),
+                      "ns3::ndn::L3Protocol::CsEntryCallback");
   return tid;
 }
 
@@ -181,6 +206,8 @@ private:
   std::shared_ptr<::ndn::Face> m_internalClientFace;
   std::shared_ptr<nfd::CommandAuthenticator> m_authenticator;
 
+  std::shared_ptr<nfd::Face> m_sharedAppFace;
+
   std::shared_ptr<nfd::Face> m_internalRibFace;
   std::shared_ptr<::ndn::Face> m_internalRibClientFace;
 
@@ -196,10 +223,17 @@ private:
 
   Ptr<ContentStore> m_csFromNdnSim;
   PolicyCreationCallback m_policy;
+  size_t m_csSize; // size of NFD content store after the last insertion or eviction
+  bool m_isCsLookup = false; // whether the forwarder looks up the CS for the current Interest
 };
 
 L3Protocol::L3Protocol()
   : m_impl(new Impl())
+  , m_nTracesCreated(0)
+  , m_nTracesSatisfied(0)
+  , m_nTracesExpired(0)
+  , m_nTracesProlonged(0)
+  , m_nTracesRemovedOnNack(0)
 {
   NS_LOG_FUNCTION(this);
 }
@@ -225,8 +259,29 @@ L3Protocol::initialize()
   }
 
   m_impl->m_forwarder->beforeSatisfyInterest.connect(std::ref(m_satisfiedInterests));
+  m_impl->m_forwarder->beforeSatisfyInterest.connect(
+    [this] (const nfd::pit::Entry& pitEntry, const Face& inFace, const Data& data) {
+      // ContentStore of ndnSIM has its own CacheHits
+      if (m_csTracing && inFace.getId() == nfd::face::FACEID_CONTENT_STORE
+          && m_impl->m_csFromNdnSim == nullptr) {
+        m_csHits(pitEntry.getInterest(), data);
+      }
+    });
   m_impl->m_forwarder->beforeExpirePendingInterest.connect(std::ref(m_timedOutInterests));
 
+  m_impl->m_forwarder->beforeSatisfyInterest.connect(
+    [this] (const nfd::pit::Entry& pitEntry, const Face&, const Data&) {
+      if (m_traceAccounting) {
+        onTraceEnd(pitEntry, m_nTracesSatisfied);
+      }
+    });
+  m_impl->m_forwarder->beforeExpirePendingInterest.connect(
+    [this] (const nfd::pit::Entry& pitEntry) {
+      if (m_traceAccounting) {
+        onTraceEnd(pitEntry, m_nTracesExpired);
+      }
+    });
+
   m_impl->m_forwarder->m_doPull = m_doPull;
   m_impl->m_forwarder->m_prolongTrace = m_prolongTrace;
   m_impl->m_forwarder->m_removeTraceOnNack = m_removeTraceOnNack;
@@ -327,6 +382,17 @@ L3Protocol::initializeManagement()
 
   tablesConfig.ensureConfigured();
 
+  // the policy evicts entries, and CS erases them, upon the signal
+  m_impl->m_csSize = forwarder->getCs().size();
+  if (m_impl->m_csFromNdnSim == nullptr) {
+    forwarder->getCs().getPolicy()->beforeEvict.connect([this] (nfd::cs::Policy::iterator entry) {
+        m_impl->m_csSize--;
+        if (m_csTracing) {
+          m_csEvictions(entry->getData());
+        }
+      });
+  }
+
   // add FIB entry for NFD Management Protocol
   Name topPrefix("/localhost/nfd");
   auto entry = forwarder->getFib().insert(topPrefix).first;
@@ -435,6 +501,13 @@ L3Protocol::addFace(shared_ptr<Face> face)
 {
   NS_LOG_FUNCTION(this << face.get());
 
+  // connected before the forwarder, so that it sees the PIT before the Interest is processed
+  face->afterReceiveInterest.connect([this](const Interest& interest) {
+      if (m_csTracing) {
+        this->beforeCsInterest(interest);
+      }
+    });
+
   m_impl->m_forwarder->addFace(face);
 
   std::weak_ptr<Face> weakFace = face;
@@ -444,6 +517,12 @@ L3Protocol::addFace(shared_ptr<Face> face)
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
         this->m_inInterests(interest, *face);
+        if (m_traceAccounting) {
+          this->onTraceInterest(interest, *face);
+        }
+        if (m_csTracing) {
+          this->onCsInterest(interest, *face);
+        }
       }
     });
 
@@ -451,6 +530,10 @@ L3Protocol::addFace(shared_ptr<Face> face)
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
         this->m_inData(data, *face);
+        if (m_traceAccounting) {
+          this->onTraceData(data);
+        }
+        this->onCsData(data);
       }
     });
 
@@ -458,6 +541,9 @@ L3Protocol::addFace(shared_ptr<Face> face)
       shared_ptr<Face> face = weakFace.lock();
       if (face != nullptr) {
         this->m_inNack(nack, *face);
+        if (m_traceAccounting) {
+          this->onTraceNack(nack);
+        }
       }
     });
 
@@ -487,6 +573,21 @@ L3Protocol::addFace(shared_ptr<Face> face)
   return face->getId();
 }
 
+shared_ptr<Face>
+L3Protocol::getSharedAppFace()
+{
+  if (m_impl->m_sharedAppFace == nullptr) {
+    auto appLink = make_unique<SharedAppLinkService>();
+    auto transport = make_unique<NullTransport>("appFace://shared", "appFace://shared",
+                                                ::ndn::nfd::FACE_SCOPE_LOCAL);
+    m_impl->m_sharedAppFace = std::make_shared<Face>(std::move(appLink), std::move(transport));
+    m_impl->m_sharedAppFace->setMetric(1);
+
+    addFace(m_impl->m_sharedAppFace);
+  }
+  return m_impl->m_sharedAppFace;
+}
+
 shared_ptr<Face>
 L3Protocol::getFaceById(nfd::FaceId id) const
 {
@@ -507,6 +608,147 @@ L3Protocol::getFaceByNetDevice(Ptr<NetDevice> netDevice) const
   return nullptr;
 }
 
+static const name::Component TRACE_MARKER("trace");
+
+bool
+L3Protocol::isTraceName(const Name& name)
+{
+  // trace Interest: /<rv>/trace/<producer>/<seq>
+  for (size_t i = 0; i + 1 < name.size(); i++) {
+    if (name[i] == TRACE_MARKER) {
+      return true;
+    }
+  }
+  return false;
+}
+
+L3Protocol::TraceEntryCounters
+L3Protocol::getTraceEntryCounters() const
+{
+  TraceEntryCounters counters = {0, 0, m_nTracesCreated, m_nTracesSatisfied, m_nTracesExpired,
+                                 m_nTracesProlonged, m_nTracesRemovedOnNack, m_traceLifespan};
+
+  for (const nfd::pit::Entry& entry : m_impl->m_forwarder->getPit()) {
+    if (!isTraceName(entry.getName())) {
+      continue;
+    }
+    counters.entries++;
+    counters.bytes += sizeof(nfd::pit::Entry) + entry.getInterest().wireEncode().size()
+                      + entry.getInRecords().size() * sizeof(nfd::pit::InRecord)
+                      + entry.getOutRecords().size() * sizeof(nfd::pit::OutRecord);
+  }
+  return counters;
+}
+
+void
+L3Protocol::onTraceInterest(const Interest& interest, const Face& inFace)
+{
+  if (!isTraceName(interest.getName())) {
+    return;
+  }
+
+  // the forwarder has already processed the Interest: accepted trace Interests leave an
+  // in-record with their nonce, while duplicates and looping ones do not
+  shared_ptr<nfd::pit::Entry> pitEntry = m_impl->m_forwarder->getPit().find(interest);
+  if (pitEntry == nullptr) {
+    return;
+  }
+  auto inRecord = pitEntry->getInRecord(inFace);
+  if (inRecord != pitEntry->in_end() && inRecord->getLastNonce() == interest.getNonce()) {
+    m_nTracesCreated++;
+  }
+}
+
+void
+L3Protocol::onTraceEnd(const nfd::pit::Entry& pitEntry, uint64_t& counter)
+{
+  if (!isTraceName(pitEntry.getName()) || pitEntry.getInRecords().empty()) {
+    return;
+  }
+
+  // the entry has lived at least since its earliest in-record was renewed
+  ::ndn::time::steady_clock::TimePoint created = pitEntry.getInRecords().front().getLastRenewed();
+  for (const nfd::pit::InRecord& inRecord : pitEntry.getInRecords()) {
+    created = std::min(created, inRecord.getLastRenewed());
+  }
+
+  counter++;
+  m_traceLifespan += NanoSeconds(::ndn::time::duration_cast<::ndn::time::nanoseconds>(
+                                   ::ndn::time::steady_clock::now() - created).count());
+}
+
+bool
+L3Protocol::hasPendingTraces() const
+{
+  return m_nTracesCreated > m_nTracesSatisfied + m_nTracesExpired;
+}
+
+void
+L3Protocol::onTraceData(const Data& data)
+{
+  if (m_prolongTrace && hasPendingTraces()) {
+    m_nTracesProlonged++;
+  }
+}
+
+void
+L3Protocol::onTraceNack(const lp::Nack& nack)
+{
+  if (m_removeTraceOnNack && hasPendingTraces()) {
+    m_nTracesRemovedOnNack++;
+  }
+}
+
+void
+L3Protocol::beforeCsInterest(const Interest& interest)
+{
+  // the forwarder looks up the CS only if no Interest is pending in the PIT entry, aggregated
+  // Interests and retransmissions go straight to the strategy
+  shared_ptr<nfd::pit::Entry> pitEntry = m_impl->m_forwarder->getPit().find(interest);
+  m_impl->m_isCsLookup = pitEntry == nullptr || pitEntry->getInRecords().empty();
+}
+
+void
+L3Protocol::onCsInterest(const Interest& interest, const Face& inFace)
+{
+  if (m_impl->m_csFromNdnSim != nullptr) {
+    return; // ContentStore has its own CacheMisses
+  }
+
+  bool isCsLookup = m_impl->m_isCsLookup;
+  m_impl->m_isCsLookup = false;
+  if (!isCsLookup) {
+    return;
+  }
+
+  // Interests not satisfied by CS leave an in-record with their nonce, while looping Interests
+  // and CS hits do not
+  shared_ptr<nfd::pit::Entry> pitEntry = m_impl->m_forwarder->getPit().find(interest);
+  if (pitEntry == nullptr) {
+    return;
+  }
+  auto inRecord = pitEntry->getInRecord(inFace);
+  if (inRecord != pitEntry->in_end() && inRecord->getLastNonce() == interest.getNonce()) {
+    m_csMisses(interest);
+  }
+}
+
+void
+L3Protocol::onCsData(const Data& data)
+{
+  if (m_impl->m_csFromNdnSim != nullptr) {
+    return;
+  }
+
+  // CS has grown unless an insertion was balanced by an eviction, which already decremented
+  // m_csSize
+  size_t size = m_impl->m_forwarder->getCs().size();
+  if (m_csTracing && size > m_impl->m_csSize) {
+    m_csInserts(data);
+  }
+  m_impl->m_csSize = size;
+}
+
 Ptr<L3Protocol>
 L3Protocol::getL3Protocol(Ptr<Object> node)
 {
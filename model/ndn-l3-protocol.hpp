@@ -124,6 +124,14 @@ public:
   nfd::FaceId
   addFace(shared_ptr<Face> face);
 
+  /**
+   * \brief Get face shared by applications on the node, creating it on first use
+   *
+   * \see SharedAppLinkService
+   */
+  shared_ptr<Face>
+  getSharedAppFace();
+
   /**
    * \brief Get face by face ID
    * \param face The face ID number
@@ -164,6 +172,39 @@ public:
   void
   setCsReplacementPolicy(const PolicyCreationCallback& policy);
 
+  /**
+   * \brief Counters of KITE trace entries held by the forwarder
+   *
+   * Trace entries are the PIT entries of trace Interests /<rv>/trace/<producer>/<seq>.  The
+   * current number of entries and their memory are measured by walking the PIT on each call.
+   *
+   * Other counters are kept only if TraceAccounting attribute is enabled.  Creations (trace
+   * Interests accepted into the PIT), satisfactions, expirations, and the lifespan of entries are
+   * taken from the forwarder.  The forwarder does not report when it prolongs or removes trace
+   * state, so prolonged and removedOnNack are estimates: Data and Nacks received with
+   * ProlongTrace or RemoveTrace enabled, while trace entries are pending.
+   */
+  struct TraceEntryCounters {
+    uint32_t entries;       ///< current number of trace entries
+    uint64_t bytes;         ///< approximate memory held by the trace entries
+    uint64_t created;       ///< trace Interests accepted into the PIT so far
+    uint64_t satisfied;     ///< entries satisfied by Data so far
+    uint64_t expired;       ///< entries expired so far
+    uint64_t prolonged;     ///< Data, which could have prolonged trace entries (estimate)
+    uint64_t removedOnNack; ///< Nacks, which could have removed trace entries (estimate)
+    Time lifespan;          ///< total lifespan of entries satisfied or expired so far
+  };
+
+  TraceEntryCounters
+  getTraceEntryCounters() const;
+
+  /**
+   * \brief Check whether the name is a name of trace Interest, i.e., has the trace marker
+   *        before its last component
+   */
+  static bool
+  isTraceName(const Name& name);
+
 public: // Workaround for python bindings
   static Ptr<L3Protocol>
   getL3Protocol(Ptr<Object> node);
@@ -175,6 +216,10 @@ public:
   typedef void (*SatisfiedInterestsCallback)(const nfd::pit::Entry& pitEntry, const Face& inFace, const Data& data);
   typedef void (*TimedOutInterestsCallback)(const nfd::pit::Entry& pitEntry);
 
+  typedef void (*CsHitsCallback)(const Interest& interest, const Data& data);
+  typedef void (*CsMissesCallback)(const Interest& interest);
+  typedef void (*CsEntryCallback)(const Data& data);
+
 protected:
   virtual void
   DoDispose(void); ///< @brief Do cleanup
@@ -198,6 +243,30 @@ private:
   void
   initializeRibManager();
 
+  void
+  onTraceInterest(const Interest& interest, const Face& inFace);
+
+  void
+  onTraceEnd(const nfd::pit::Entry& pitEntry, uint64_t& counter);
+
+  bool
+  hasPendingTraces() const; // trace Interests accepted, but not yet satisfied or expired
+
+  void
+  onTraceData(const Data& data);
+
+  void
+  onTraceNack(const lp::Nack& nack);
+
+  void
+  beforeCsInterest(const Interest& interest); // called before the forwarder processes Interest
+
+  void
+  onCsInterest(const Interest& interest, const Face& inFace);
+
+  void
+  onCsData(const Data& data);
+
 private:
   class Impl;
   std::unique_ptr<Impl> m_impl;
@@ -227,6 +296,20 @@ private:
   bool m_prolongTrace;     // keep trace alive on dataflow
 
   bool m_removeTraceOnNack;
+
+  bool m_traceAccounting;
+  uint64_t m_nTracesCreated;
+  uint64_t m_nTracesSatisfied;
+  uint64_t m_nTracesExpired;
+  uint64_t m_nTracesProlonged;
+  uint64_t m_nTracesRemovedOnNack;
+  Time m_traceLifespan;
+
+  bool m_csTracing;
+  TracedCallback<const Interest&, const Data&> m_csHits; ///< @brief NFD content store hits
+  TracedCallback<const Interest&> m_csMisses;            ///< @brief NFD content store misses
+  TracedCallback<const Data&> m_csInserts;   ///< @brief Data inserted into NFD content store
+  TracedCallback<const Data&> m_csEvictions; ///< @brief Data evicted from NFD content store
 };
 
 } // namespace ndn
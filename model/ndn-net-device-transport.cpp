@@ -93,6 +93,7 @@ NetDeviceTransport::doSend(Packet&& packet)
 
   Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
   ns3Packet->AddHeader(header);
+  this->beforeSendPacket(ns3Packet);
 
   // send the NS3 packet
   m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
@@ -117,7 +118,9 @@ NetDeviceTransport::receiveFromNetDevice(Ptr<NetDevice> device,
 
   auto nfdPacket = Packet(std::move(header.getBlock()));
 
+  this->beforeReceivePacket(p);
   this->receive(std::move(nfdPacket));
+  this->afterReceivePacket(p);
 }
 
 Ptr<NetDevice>
@@ -32,6 +32,8 @@
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
 
+#include <ndn-cxx/util/signal.hpp>
+
 namespace ns3 {
 namespace ndn {
 
@@ -54,6 +56,25 @@ public:
   Ptr<NetDevice>
   GetNetDevice() const;
 
+public:
+  /**
+   * \brief Signals the ns-3 packet just before it is passed to the NetDevice
+   *
+   * Handlers can attach packet tags to carry simulation metadata to the receiving transport.
+   */
+  ::ndn::util::signal::Signal<NetDeviceTransport, Ptr<const ns3::Packet>> beforeSendPacket;
+
+  /**
+   * \brief Signals the ns-3 packet received from the NetDevice before it is decoded
+   */
+  ::ndn::util::signal::Signal<NetDeviceTransport, Ptr<const ns3::Packet>> beforeReceivePacket;
+
+  /**
+   * \brief Signals the ns-3 packet received from the NetDevice after the face and the forwarder
+   *        have processed it
+   */
+  ::ndn::util::signal::Signal<NetDeviceTransport, Ptr<const ns3::Packet>> afterReceivePacket;
+
 private:
   virtual void
   beforeChangePersistency(::ndn::nfd::FacePersistency newPersistency) override;
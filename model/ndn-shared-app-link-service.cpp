@@ -0,0 +1,250 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-shared-app-link-service.hpp"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+
+#include "apps/ndn-app.hpp"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.SharedAppLinkService");
+
+namespace ns3 {
+namespace ndn {
+
+// minimum number of pending Interests before expired ones are swept
+static const size_t MIN_SWEEP_THRESHOLD = 1024;
+
+SharedAppLinkService::SharedAppLinkService()
+  : m_nPending(0)
+  , m_sweepThreshold(MIN_SWEEP_THRESHOLD)
+{
+  NS_LOG_FUNCTION(this);
+}
+
+SharedAppLinkService::~SharedAppLinkService()
+{
+  NS_LOG_FUNCTION_NOARGS();
+}
+
+void
+SharedAppLinkService::registerPrefix(const Name& prefix, Ptr<App> app)
+{
+  NS_LOG_FUNCTION(this << prefix << app);
+
+  Registration& registration = m_prefixes[makeKey(prefix)];
+  registration.prefix = prefix;
+  std::vector<Ptr<App>>& apps = registration.apps;
+  if (std::find(apps.begin(), apps.end(), app) == apps.end()) {
+    apps.push_back(app);
+  }
+}
+
+std::vector<Name>
+SharedAppLinkService::removeApp(Ptr<App> app)
+{
+  NS_LOG_FUNCTION(this << app);
+
+  std::vector<Name> unregistered;
+  for (auto entry = m_prefixes.begin(); entry != m_prefixes.end();) {
+    std::vector<Ptr<App>>& apps = entry->second.apps;
+    apps.erase(std::remove(apps.begin(), apps.end(), app), apps.end());
+    if (apps.empty()) {
+      unregistered.push_back(entry->second.prefix);
+      entry = m_prefixes.erase(entry);
+    }
+    else {
+      ++entry;
+    }
+  }
+
+  for (auto entry = m_pending.begin(); entry != m_pending.end();) {
+    std::vector<PendingInterest>& owners = entry->second;
+    size_t size = owners.size();
+    owners.erase(std::remove_if(owners.begin(), owners.end(),
+                                [app](const PendingInterest& pi) { return pi.app == app; }),
+                 owners.end());
+    m_nPending -= size - owners.size();
+    if (owners.empty()) {
+      entry = m_pending.erase(entry);
+    }
+    else {
+      ++entry;
+    }
+  }
+
+  return unregistered;
+}
+
+size_t
+SharedAppLinkService::getNPendingInterests() const
+{
+  return m_nPending;
+}
+
+void
+SharedAppLinkService::onReceiveInterest(Ptr<App> app, const Interest& interest)
+{
+  time::milliseconds lifetime = interest.getInterestLifetime();
+  if (lifetime < time::milliseconds::zero()) {
+    lifetime = ::ndn::DEFAULT_INTEREST_LIFETIME;
+  }
+  Time expiry = Simulator::Now() + MilliSeconds(lifetime.count());
+
+  std::vector<PendingInterest>& owners = m_pending[makeKey(interest.getName())];
+  auto owner = std::find_if(owners.begin(), owners.end(),
+                            [app](const PendingInterest& pi) { return pi.app == app; });
+  if (owner != owners.end()) {
+    owner->expiry = expiry; // retransmission
+  }
+  else {
+    owners.push_back(PendingInterest{app, expiry});
+    m_nPending++;
+    removeExpired();
+  }
+
+  this->receiveInterest(interest);
+}
+
+void
+SharedAppLinkService::onReceiveData(Ptr<App> app, const Data& data)
+{
+  this->receiveData(data);
+}
+
+void
+SharedAppLinkService::onReceiveNack(Ptr<App> app, const lp::Nack& nack)
+{
+  this->receiveNack(nack);
+}
+
+void
+SharedAppLinkService::doSendInterest(const Interest& interest)
+{
+  NS_LOG_FUNCTION(this << &interest);
+
+  // longest prefix first, the key is shortened by one component for each shorter prefix
+  const Name& name = interest.getName();
+  makeKey(name);
+  for (int prefixLen = name.size(); prefixLen >= 0; --prefixLen) {
+    if (prefixLen < static_cast<int>(name.size())) {
+      m_key.resize(m_key.size() - name[prefixLen].size());
+    }
+
+    auto entry = m_prefixes.find(m_key);
+    if (entry == m_prefixes.end())
+      continue;
+
+    for (const Ptr<App>& app : entry->second.apps) {
+      // to decouple callbacks
+      Simulator::ScheduleNow(&App::OnInterest, app, interest.shared_from_this());
+    }
+    return;
+  }
+
+  NS_LOG_DEBUG("No application registered prefix for " << name);
+}
+
+void
+SharedAppLinkService::doSendData(const Data& data)
+{
+  NS_LOG_FUNCTION(this << &data);
+
+  const Name& name = data.getName();
+  makeKey(name);
+  for (int prefixLen = name.size(); prefixLen >= 0; --prefixLen) {
+    if (prefixLen < static_cast<int>(name.size())) {
+      m_key.resize(m_key.size() - name[prefixLen].size());
+    }
+
+    auto entry = m_pending.find(m_key);
+    if (entry == m_pending.end())
+      continue;
+
+    for (const PendingInterest& owner : entry->second) {
+      if (owner.expiry >= Simulator::Now()) {
+        // to decouple callbacks
+        Simulator::ScheduleNow(&App::OnData, owner.app, data.shared_from_this());
+      }
+    }
+    m_nPending -= entry->second.size();
+    m_pending.erase(entry);
+  }
+}
+
+void
+SharedAppLinkService::doSendNack(const lp::Nack& nack)
+{
+  NS_LOG_FUNCTION(this << &nack);
+
+  auto entry = m_pending.find(makeKey(nack.getInterest().getName()));
+  if (entry == m_pending.end())
+    return;
+
+  auto nackCopy = make_shared<lp::Nack>(nack);
+  for (const PendingInterest& owner : entry->second) {
+    // to decouple callbacks
+    Simulator::ScheduleNow(&App::OnNack, owner.app, nackCopy);
+  }
+  m_nPending -= entry->second.size();
+  m_pending.erase(entry);
+}
+
+void
+SharedAppLinkService::removeExpired()
+{
+  if (m_nPending < m_sweepThreshold)
+    return;
+
+  Time now = Simulator::Now();
+  for (auto entry = m_pending.begin(); entry != m_pending.end();) {
+    std::vector<PendingInterest>& owners = entry->second;
+    size_t size = owners.size();
+    owners.erase(std::remove_if(owners.begin(), owners.end(),
+                                [now](const PendingInterest& pi) { return pi.expiry < now; }),
+                 owners.end());
+    m_nPending -= size - owners.size();
+    if (owners.empty()) {
+      entry = m_pending.erase(entry);
+    }
+    else {
+      ++entry;
+    }
+  }
+
+  // amortize the cost of the sweep over the following insertions
+  m_sweepThreshold = std::max(MIN_SWEEP_THRESHOLD, 2 * m_nPending);
+}
+
+const std::string&
+SharedAppLinkService::makeKey(const Name& name)
+{
+  m_key.clear();
+  for (const auto& component : name) {
+    m_key.append(reinterpret_cast<const char*>(component.wire()), component.size());
+  }
+  return m_key;
+}
+
+} // namespace ndn
+} // namespace ns3
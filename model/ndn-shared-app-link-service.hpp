@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_SHARED_APP_LINK_SERVICE_HPP
+#define NDN_SHARED_APP_LINK_SERVICE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/link-service.hpp"
+
+#include "ns3/ptr.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class App;
+
+/**
+ * \ingroup ndn-face
+ * \brief Implementation of LinkService for a face shared by many applications on one node
+ *
+ * Instead of creating a face per application, applications that enable the SharedFace
+ * attribute send and receive packets through a single face per node (see
+ * L3Protocol::getSharedAppFace), which reduces the number of entries in the face table, FIB
+ * nexthops, and PIT in-records.
+ *
+ * Packets coming from the forwarder are demultiplexed as follows:
+ *  - Interests are delivered to applications that registered the longest prefix matching the
+ *    Interest name (see registerPrefix);
+ *  - Data is delivered to every application with an unexpired pending Interest, whose name is a
+ *    prefix of the Data name;
+ *  - Nack is delivered to every application with a pending Interest for the Nack'ed name.
+ *
+ * \note Applications on the same node that exchange packets with each other should not both
+ *       use the shared face, as the forwarder never returns packets to the face they came from.
+ *
+ * \see AppLinkService
+ */
+class SharedAppLinkService : public nfd::face::LinkService
+{
+public:
+  SharedAppLinkService();
+
+  virtual ~SharedAppLinkService();
+
+  /**
+   * \brief Deliver Interests under \p prefix to \p app
+   */
+  void
+  registerPrefix(const Name& prefix, Ptr<App> app);
+
+  /**
+   * \brief Remove all prefix registrations and pending Interests of \p app
+   * \return prefixes that no application is registered for anymore
+   */
+  std::vector<Name>
+  removeApp(Ptr<App> app);
+
+  /**
+   * \brief Get number of Interests, sent by the applications, that await Data or Nack
+   */
+  size_t
+  getNPendingInterests() const;
+
+public:
+  void
+  onReceiveInterest(Ptr<App> app, const Interest& interest);
+
+  void
+  onReceiveData(Ptr<App> app, const Data& data);
+
+  void
+  onReceiveNack(Ptr<App> app, const lp::Nack& nack);
+
+private:
+  virtual void
+  doSendInterest(const Interest& interest) override;
+
+  virtual void
+  doSendData(const Data& data) override;
+
+  virtual void
+  doSendNack(const lp::Nack& nack) override;
+
+  virtual void
+  doReceivePacket(nfd::face::Transport::Packet&& packet) override
+  {
+    // does nothing (all operations for now handled by LinkService)
+    BOOST_ASSERT(false);
+  }
+
+  /**
+   * \brief Remove expired pending Interests, if the table has grown enough since the last sweep
+   */
+  void
+  removeExpired();
+
+  /**
+   * \brief Put encoded components of \p name into the reusable key buffer
+   */
+  const std::string&
+  makeKey(const Name& name);
+
+private:
+  struct PendingInterest {
+    Ptr<App> app;
+    Time expiry;
+  };
+
+  struct Registration {
+    Name prefix;
+    std::vector<Ptr<App>> apps;
+  };
+
+  // tables are keyed by the encoded components of the name
+  std::unordered_map<std::string, std::vector<PendingInterest>> m_pending;
+  size_t m_nPending;
+  size_t m_sweepThreshold;
+
+  std::unordered_map<std::string, Registration> m_prefixes;
+  std::string m_key; // reusable buffer for table keys
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SHARED_APP_LINK_SERVICE_HPP
@@ -24,6 +24,7 @@
 #include "ns3/ndnSIM/helper/ndn-app-helper.hpp"
 #include "ns3/ndnSIM/helper/ndn-global-routing-helper.hpp"
 #include "ns3/ndnSIM/helper/ndn-network-region-table-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-kite-helper.hpp"
 // #include "ns3/ndnSIM/helper/ndn-ip-faces-helper.hpp"
 // #include "ns3/ndnSIM/helper/ndn-link-control-helper.hpp"
 
@@ -33,7 +34,15 @@
 #include "ns3/ndnSIM/utils/tracers/l2-rate-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-cs-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-hop-delay-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-kite-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-log-linear-histogram.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-table-size-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-entry-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-filter.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-sink.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-tracer-registry.hpp"
 
 // #include "ns3/ndnSIM/model/ndn-app-face.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// kite-ms-lookup.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/apps/kite-ms-server.hpp"
+
+#include <chrono>
+
+namespace ns3 {
+
+/**
+ * This scenario measures lookup throughput of a KITE mapping server with many registered mobile
+ * producers:
+ *
+ *
+ *      +----------+     10Gbps     +----------------+
+ *      |  driver  | <------------> | mapping server |
+ *      +----------+        1ms     +----------------+
+ *
+ *
+ * During the first second, the driver application registers mobile producers /p/<i> with
+ * batched updates of the given size.  Afterwards, it looks up locators of randomly chosen
+ * producers at the given rate.  At the end, the number of registered producers and the number
+ * of lookups answered per second of wall-clock time are printed.
+ *
+ *     ./waf --run="kite-ms-lookup --producers=100000 --batch=100 --rate=100000 --sim-time=10"
+ */
+
+class KiteMsLookupDriver : public ndn::App {
+public:
+  KiteMsLookupDriver(uint32_t nProducers, uint32_t batchSize, double rate)
+    : m_nProducers(nProducers)
+    , m_batchSize(batchSize)
+    , m_rate(rate)
+    , m_seq(0)
+    , m_nLookups(0)
+    , m_rand(CreateObject<UniformRandomVariable>())
+  {
+  }
+
+  uint64_t
+  GetNLookups() const
+  {
+    return m_nLookups;
+  }
+
+protected:
+  virtual void
+  StartApplication()
+  {
+    App::StartApplication();
+
+    std::vector<std::pair<ndn::Name, ndn::Name>> mappings;
+    for (uint32_t i = 0; i < m_nProducers; i++) {
+      mappings.push_back(std::make_pair(ndn::Name("/p").appendNumber(i),
+                                        ndn::Name("/router").appendNumber(i % 11)));
+      if (mappings.size() == m_batchSize || i + 1 == m_nProducers) {
+        ndn::Name name("/map/batch");
+        name.append(ndn::KiteMsServer::EncodeMappings(mappings));
+        send(name.appendSequenceNumber(m_seq++));
+        mappings.clear();
+      }
+    }
+    Simulator::Schedule(Seconds(1), &KiteMsLookupDriver::SendLookup, this);
+  }
+
+  virtual void
+  OnData(shared_ptr<const ndn::Data> data)
+  {
+    App::OnData(data);
+
+    if (data->getName().get(1) != ndn::name::Component("batch")) {
+      m_nLookups++;
+    }
+  }
+
+private:
+  void
+  SendLookup()
+  {
+    uint32_t producer = m_rand->GetInteger(0, m_nProducers - 1);
+    send(ndn::Name("/map/p").appendNumber(producer).appendSequenceNumber(m_seq++));
+    Simulator::Schedule(Seconds(1.0 / m_rate), &KiteMsLookupDriver::SendLookup, this);
+  }
+
+  void
+  send(const ndn::Name& name)
+  {
+    auto interest = make_shared<ndn::Interest>(name);
+    interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+    interest->setInterestLifetime(ndn::time::seconds(1));
+    interest->wireEncode();
+
+    m_transmittedInterests(interest, this, m_face);
+    m_appLink->onReceiveInterest(*interest);
+  }
+
+private:
+  uint32_t m_nProducers;
+  uint32_t m_batchSize;
+  double m_rate;
+  uint64_t m_seq;
+  uint64_t m_nLookups;
+  Ptr<UniformRandomVariable> m_rand;
+};
+
+int
+main(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("100000"));
+
+  uint32_t nProducers = 100000;
+  uint32_t batchSize = 100;
+  double rate = 100000;
+  Time freshness = Seconds(0);
+  Time simulationTime = Seconds(10);
+
+  CommandLine cmd;
+  cmd.AddValue("producers", "Number of registered mobile producers", nProducers);
+  cmd.AddValue("batch", "Number of mappings in one batched update", batchSize);
+  cmd.AddValue("rate", "Rate of lookups", rate);
+  cmd.AddValue("freshness", "Freshness of mapping responses", freshness);
+  cmd.AddValue("sim-time", "Simulation time", simulationTime);
+  cmd.Parse(argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::FibHelper::AddRoute(nodes.Get(0), "/map", nodes.Get(1), 1);
+
+  ndn::AppHelper serverHelper("ns3::ndn::KiteMsServer");
+  serverHelper.SetAttribute("Prefix", StringValue("/map"));
+  serverHelper.SetAttribute("Freshness", TimeValue(freshness));
+  ApplicationContainer server = serverHelper.Install(nodes.Get(1));
+
+  Ptr<KiteMsLookupDriver> driver = CreateObject<KiteMsLookupDriver>(nProducers, batchSize, rate);
+  nodes.Get(0)->AddApplication(driver);
+
+  // registration
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+
+  // lookups
+  Simulator::Stop(simulationTime - Seconds(1));
+
+  auto start = std::chrono::steady_clock::now();
+  Simulator::Run();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  Ptr<ndn::KiteMsServer> serverApp = DynamicCast<ndn::KiteMsServer>(server.Get(0));
+  std::cout << "Mappings"
+            << "\t"
+            << "Lookups"
+            << "\t"
+            << "WallSeconds"
+            << "\t"
+            << "LookupsPerSecond"
+            << "\n";
+  std::cout << serverApp->GetNMappings() << "\t" << driver->GetNLookups() << "\t"
+            << elapsed.count() << "\t" << driver->GetNLookups() / elapsed.count() << "\n";
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
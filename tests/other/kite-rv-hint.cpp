@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// kite-rv-hint.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/apps/kite-rv.hpp"
+
+#include <chrono>
+
+namespace ns3 {
+
+/**
+ * This scenario measures how fast a rendezvous point (RV) redirects consumer Interests with
+ * forwarding hints to the RV, to which the mobile producer is currently attached:
+ *
+ *
+ *      +----------+     10Gbps     +--------+     10Gbps     +-------------------+
+ *      | consumer | <------------> |  RV1   | <------------> | RV2 and producer  |
+ *      +----------+        1ms     +--------+        1ms     | (region /rv2)     |
+ *                                                            +-------------------+
+ *
+ *
+ * Consumer requests /rv/alice/<seq> at the given rate.  Each Interest is redirected by RV1 with
+ * a forwarding hint to /rv2.  At the end, the number of Interests processed by RV1 per second of
+ * wall-clock time is printed.
+ *
+ *     ./waf --run="kite-rv-hint --rate=10000 --sim-time=10"
+ */
+
+static uint64_t g_rvInterests = 0;
+
+static void
+OnRvInterest(shared_ptr<const ndn::Interest>, Ptr<ndn::App>, shared_ptr<ndn::Face>)
+{
+  g_rvInterests++;
+}
+
+int
+main(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("100000"));
+
+  double rate = 10000;
+  Time simulationTime = Seconds(10);
+
+  CommandLine cmd;
+  cmd.AddValue("rate", "Interest rate of the consumer", rate);
+  cmd.AddValue("sim-time", "Simulation time", simulationTime);
+  cmd.Parse(argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::FibHelper::AddRoute(nodes.Get(0), "/rv", nodes.Get(1), 1);
+  ndn::FibHelper::AddRoute(nodes.Get(1), "/rv2", nodes.Get(2), 1);
+  ndn::NetworkRegionTableHelper::AddRegionName(nodes.Get(2), ndn::Name("/rv2"));
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/rv/alice");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(rate));
+  consumerHelper.Install(nodes.Get(0));
+
+  ndn::AppHelper rvHelper("ns3::ndn::KiteRv");
+  rvHelper.SetAttribute("RvPrefix", StringValue("/rv"));
+  rvHelper.SetAttribute("InstancePrefix", StringValue("/rv1"));
+  ApplicationContainer rv = rvHelper.Install(nodes.Get(1));
+  rv.Get(0)->TraceConnectWithoutContext("ReceivedInterests", MakeCallback(&OnRvInterest));
+
+  // the mobile producer is attached to RV2, so RV1 redirects all consumer Interests
+  Ptr<ndn::KiteRv> rvApp = DynamicCast<ndn::KiteRv>(rv.Get(0));
+  rvApp->SetAttachment("/alice", "/rv2");
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/rv");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(nodes.Get(2));
+
+  Simulator::Stop(simulationTime);
+
+  auto start = std::chrono::steady_clock::now();
+  Simulator::Run();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::cout << "RvInterests"
+            << "\t"
+            << "WallSeconds"
+            << "\t"
+            << "RvInterestsPerSecond"
+            << "\n";
+  std::cout << g_rvInterests << "\t" << elapsed.count() << "\t" << g_rvInterests / elapsed.count()
+            << "\n";
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,244 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// kite-rv-scale.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/apps/kite-rv.hpp"
+
+#include <chrono>
+#include <fstream>
+
+namespace ns3 {
+
+/**
+ * This scenario measures a rendezvous point (RV) serving many mobile producers at once:
+ *
+ *
+ *      +----------+     10Gbps     +--------------------+
+ *      |  driver  | <------------> |        RV1         |
+ *      +----------+        1ms     |   (region /rv1)    |
+ *                                  +--------------------+
+ *
+ *
+ * The driver application plays all mobile producers /p/<i> and their consumers.  Each producer
+ * negotiates an ISN with RV1 and sends a trace Interest every second.  Even producers are
+ * attached to RV1, so consumer Interests for them, hinted to /rv1, are queued until the next
+ * trace; odd producers are attached to /rv2, so consumer Interests for them are redirected with
+ * a forwarding hint (and dropped by the driver node).  At the end, the number of producers known
+ * to RV1, the number of Interests processed per second of wall-clock time, and the resident
+ * memory of the process are printed.
+ *
+ *     ./waf --run="kite-rv-scale --producers=5000 --rate=10000 --sim-time=10"
+ */
+
+class KiteRvScaleDriver : public ndn::App {
+public:
+  KiteRvScaleDriver(uint32_t nProducers, double rate)
+    : m_nProducers(nProducers)
+    , m_rate(rate)
+    , m_isn(nProducers, 0)
+    , m_next(0)
+    , m_seq(0)
+    , m_rand(CreateObject<UniformRandomVariable>())
+  {
+  }
+
+protected:
+  virtual void
+  StartApplication()
+  {
+    App::StartApplication();
+
+    ::ndn::Link link;
+    link.addDelegation(1, "/rv1");
+    ndn::StackHelper::getKeyChain().sign(link, ::ndn::security::SigningInfo(
+                                                 ::ndn::security::SigningInfo::SIGNER_TYPE_SHA256));
+    m_link = link.wireEncode();
+
+    for (uint32_t i = 0; i < m_nProducers; i++) {
+      send(ndn::Name("/rv/negotiate/p").appendNumber(i), false);
+    }
+    Simulator::Schedule(Seconds(1), &KiteRvScaleDriver::SendTraces, this);
+    Simulator::Schedule(Seconds(1), &KiteRvScaleDriver::SendConsumerInterest, this);
+  }
+
+  virtual void
+  OnData(shared_ptr<const ndn::Data> data)
+  {
+    App::OnData(data);
+
+    const ndn::Name& name = data->getName();
+    if (name.size() == 4 && name.get(1) == ndn::name::Component("negotiate")) {
+      uint64_t isn = 0;
+      std::memcpy(&isn, data->getContent().value(), sizeof(isn));
+      m_isn[name.at(-1).toNumber()] = isn;
+    }
+  }
+
+private:
+  void
+  SendTraces()
+  {
+    for (uint32_t i = 0; i < m_nProducers; i++) {
+      if (m_isn[i] != 0) {
+        send(ndn::Name("/rv/trace/p").appendNumber(i).appendSequenceNumber(m_isn[i]++), false);
+      }
+    }
+    Simulator::Schedule(Seconds(1), &KiteRvScaleDriver::SendTraces, this);
+  }
+
+  void
+  SendConsumerInterest()
+  {
+    uint32_t producer = m_next;
+    m_next = (m_next + 1) % m_nProducers;
+
+    // Interests for producers attached to RV1 carry a hint to RV1, as if redirected by another RV
+    send(ndn::Name("/rv/p").appendNumber(producer).appendSequenceNumber(m_seq++),
+         producer % 2 == 0);
+    Simulator::Schedule(Seconds(1.0 / m_rate), &KiteRvScaleDriver::SendConsumerInterest, this);
+  }
+
+  void
+  send(const ndn::Name& name, bool withLink)
+  {
+    auto interest = make_shared<ndn::Interest>(name);
+    interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+    interest->setInterestLifetime(ndn::time::seconds(1));
+    if (withLink) {
+      interest->setLink(m_link);
+    }
+    interest->wireEncode();
+
+    m_transmittedInterests(interest, this, m_face);
+    m_appLink->onReceiveInterest(*interest);
+  }
+
+private:
+  uint32_t m_nProducers;
+  double m_rate;
+  std::vector<uint64_t> m_isn;
+  uint32_t m_next;
+  uint64_t m_seq;
+  Ptr<UniformRandomVariable> m_rand;
+  Block m_link;
+};
+
+static uint64_t g_rvInterests = 0;
+
+static void
+OnRvInterest(shared_ptr<const ndn::Interest>, Ptr<ndn::App>, shared_ptr<ndn::Face>)
+{
+  g_rvInterests++;
+}
+
+static std::string
+GetMemUsage()
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 6, "VmRSS:") == 0) {
+      return line.substr(6);
+    }
+  }
+  return "unknown";
+}
+
+int
+main(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("100000"));
+
+  uint32_t nProducers = 5000;
+  double rate = 10000;
+  Time simulationTime = Seconds(10);
+
+  CommandLine cmd;
+  cmd.AddValue("producers", "Number of mobile producers served by the RV", nProducers);
+  cmd.AddValue("rate", "Total rate of consumer Interests", rate);
+  cmd.AddValue("sim-time", "Simulation time", simulationTime);
+  cmd.Parse(argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::FibHelper::AddRoute(nodes.Get(0), "/rv", nodes.Get(1), 1);
+  ndn::FibHelper::AddRoute(nodes.Get(0), "/rv1", nodes.Get(1), 1);
+  ndn::FibHelper::AddRoute(nodes.Get(1), "/rv2", nodes.Get(0), 1);
+  ndn::NetworkRegionTableHelper::AddRegionName(nodes.Get(1), ndn::Name("/rv1"));
+
+  ndn::AppHelper rvHelper("ns3::ndn::KiteRv");
+  rvHelper.SetAttribute("RvPrefix", StringValue("/rv"));
+  rvHelper.SetAttribute("InstancePrefix", StringValue("/rv1"));
+  ApplicationContainer rv = rvHelper.Install(nodes.Get(1));
+  rv.Get(0)->TraceConnectWithoutContext("ReceivedInterests", MakeCallback(&OnRvInterest));
+
+  Ptr<ndn::KiteRv> rvApp = DynamicCast<ndn::KiteRv>(rv.Get(0));
+  for (uint32_t i = 0; i < nProducers; i++) {
+    rvApp->SetAttachment(ndn::Name("/p").appendNumber(i), i % 2 == 0 ? "/rv1" : "/rv2");
+  }
+
+  Ptr<KiteRvScaleDriver> driver = CreateObject<KiteRvScaleDriver>(nProducers, rate);
+  nodes.Get(0)->AddApplication(driver);
+
+  Simulator::Stop(simulationTime);
+
+  auto start = std::chrono::steady_clock::now();
+  Simulator::Run();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::cout << "Producers"
+            << "\t"
+            << "RvInterests"
+            << "\t"
+            << "WallSeconds"
+            << "\t"
+            << "RvInterestsPerSecond"
+            << "\t"
+            << "MemUsage"
+            << "\n";
+  std::cout << rvApp->GetNProducers() << "\t" << g_rvInterests << "\t" << elapsed.count() << "\t"
+            << g_rvInterests / elapsed.count() << "\t" << GetMemUsage() << "\n";
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
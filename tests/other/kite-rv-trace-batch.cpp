@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// kite-rv-trace-batch.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/apps/kite-rv.hpp"
+
+#include <ctime>
+
+namespace ns3 {
+
+/**
+ * This scenario measures the cost of trace Interests at a rendezvous point (RV), e.g., when a
+ * train full of mobile producers hands off at once:
+ *
+ *
+ *      +----------+     10Gbps     +--------+
+ *      |  driver  | <------------> |  RV1   |
+ *      +----------+        1ms     +--------+
+ *
+ *
+ * The driver application plays the mobile producers /p/<i>, which send trace Interests
+ * /rv/trace/p/<i>/<seq> to RV1 in a round-robin fashion at the given total rate (10k trace
+ * Interests per second by default).  The scenario is run three times in the same process:
+ *
+ * - baseline: RV1 is never started, so trace Interests are dropped at its node with a Nack
+ * - no batching: RV1 answers each trace Interest at once
+ * - batching: RV1 answers trace Interests arriving within --batch-window together
+ *
+ * For each run, the number of trace Interests sent and answered by RV1, the number of attachment
+ * announcements, the process CPU time, and RvCpuMicrosecondsPerTrace are printed.  The latter is
+ * the CPU time above the baseline per trace Interest sent, i.e., the cost of the RV application
+ * and of its reply, excluding the driver and the forwarding of the trace Interest to RV1.
+ *
+ *     ./waf --run="kite-rv-trace-batch --producers=1000 --rate=10000 --batch-window=10ms"
+ */
+
+class KiteRvTraceDriver : public ndn::App {
+public:
+  KiteRvTraceDriver(uint32_t nProducers, double rate)
+    : m_nProducers(nProducers)
+    , m_rate(rate)
+    , m_next(0)
+    , m_seq(nProducers, 0)
+    , m_rand(CreateObject<UniformRandomVariable>())
+    , m_nSent(0)
+  {
+  }
+
+  uint64_t
+  GetNSent() const
+  {
+    return m_nSent;
+  }
+
+protected:
+  virtual void
+  StartApplication()
+  {
+    App::StartApplication();
+
+    SendTrace();
+  }
+
+private:
+  void
+  SendTrace()
+  {
+    uint32_t producer = m_next;
+    m_next = (m_next + 1) % m_nProducers;
+
+    auto interest =
+      make_shared<ndn::Interest>(ndn::Name("/rv/trace/p").appendNumber(producer)
+                                   .appendSequenceNumber(m_seq[producer]++));
+    interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+    interest->setInterestLifetime(ndn::time::seconds(1));
+    interest->wireEncode();
+
+    m_transmittedInterests(interest, this, m_face);
+    m_appLink->onReceiveInterest(*interest);
+    m_nSent++;
+
+    Simulator::Schedule(Seconds(1.0 / m_rate), &KiteRvTraceDriver::SendTrace, this);
+  }
+
+private:
+  uint32_t m_nProducers;
+  double m_rate;
+  uint32_t m_next;
+  std::vector<uint64_t> m_seq;
+  Ptr<UniformRandomVariable> m_rand;
+  uint64_t m_nSent;
+};
+
+static uint64_t g_traceReplies = 0;
+static uint64_t g_announcements = 0;
+
+static void
+OnRvData(shared_ptr<const ndn::Data>, Ptr<ndn::App>, shared_ptr<ndn::Face>)
+{
+  g_traceReplies++;
+}
+
+static void
+OnAttached(Ptr<ndn::App>, const ndn::Name&)
+{
+  g_announcements++;
+}
+
+struct RunResult {
+  uint64_t traces;
+  double cpuSeconds;
+};
+
+static RunResult
+Run(uint32_t nProducers, double rate, bool rvStarted, Time batchWindow, Time simulationTime)
+{
+  g_traceReplies = 0;
+  g_announcements = 0;
+
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::FibHelper::AddRoute(nodes.Get(0), "/rv", nodes.Get(1), 1);
+
+  ndn::AppHelper rvHelper("ns3::ndn::KiteRv");
+  rvHelper.SetAttribute("RvPrefix", StringValue("/rv"));
+  rvHelper.SetAttribute("InstancePrefix", StringValue("/rv1"));
+  rvHelper.SetAttribute("TraceBatchWindow", TimeValue(batchWindow));
+  ApplicationContainer rv = rvHelper.Install(nodes.Get(1));
+  rv.Get(0)->TraceConnectWithoutContext("TransmittedDatas", MakeCallback(&OnRvData));
+  rv.Get(0)->TraceConnectWithoutContext("AttachedCallback", MakeCallback(&OnAttached));
+  if (!rvStarted) {
+    rv.Start(simulationTime + Seconds(1));
+  }
+
+  Ptr<KiteRvTraceDriver> driver = CreateObject<KiteRvTraceDriver>(nProducers, rate);
+  nodes.Get(0)->AddApplication(driver);
+
+  Simulator::Stop(simulationTime);
+
+  std::clock_t start = std::clock();
+  Simulator::Run();
+  RunResult result = {driver->GetNSent(),
+                      static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC};
+
+  Simulator::Destroy();
+
+  return result;
+}
+
+int
+main(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("100000"));
+
+  uint32_t nProducers = 1000;
+  double rate = 10000;
+  Time batchWindow = MilliSeconds(10);
+  Time simulationTime = Seconds(10);
+
+  CommandLine cmd;
+  cmd.AddValue("producers", "Number of mobile producers sending trace Interests", nProducers);
+  cmd.AddValue("rate", "Total rate of trace Interests", rate);
+  cmd.AddValue("batch-window", "TraceBatchWindow of the RV in the batching run", batchWindow);
+  cmd.AddValue("sim-time", "Simulation time", simulationTime);
+  cmd.Parse(argc, argv);
+
+  std::cout << "Run"
+            << "\t"
+            << "BatchWindow"
+            << "\t"
+            << "TracesSent"
+            << "\t"
+            << "TraceReplies"
+            << "\t"
+            << "Announcements"
+            << "\t"
+            << "CpuSeconds"
+            << "\t"
+            << "RvCpuMicrosecondsPerTrace"
+            << "\n";
+
+  RunResult baseline = Run(nProducers, rate, false, Seconds(0), simulationTime);
+  std::cout << "baseline"
+            << "\t" << 0 << "\t" << baseline.traces << "\t" << g_traceReplies << "\t"
+            << g_announcements << "\t" << baseline.cpuSeconds << "\t" << 0 << "\n";
+
+  const std::pair<const char*, Time> runs[] = {{"no-batching", Seconds(0)},
+                                               {"batching", batchWindow}};
+  for (const auto& run : runs) {
+    RunResult result = Run(nProducers, rate, true, run.second, simulationTime);
+    std::cout << run.first << "\t" << run.second.GetSeconds() << "\t" << result.traces << "\t"
+              << g_traceReplies << "\t" << g_announcements << "\t" << result.cpuSeconds << "\t"
+              << (result.cpuSeconds - baseline.cpuSeconds) * 1e6 / result.traces << "\n";
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
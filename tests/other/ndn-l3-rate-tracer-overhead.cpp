@@ -0,0 +1,390 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-l3-rate-tracer-overhead.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/ndn-global-router.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-l3-tracer.hpp"
+
+#include "daemon/table/pit-entry.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <ctime>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * This program measures the per-packet overhead of L3RateTracer on a grid of nodes (32x32 by
+ * default).  Consumers on all nodes of the first column request /prefix/<row>/<seq> from the
+ * producer in the opposite corner.
+ *
+ * Every node has a tracer that only counts the traced events.  The scenario is run once for each
+ * mode in the same process, with one more tracer installed on each node:
+ *
+ * - none: nothing, the baseline
+ * - map: replica of the counters used by L3RateTracer before the dense per-face slots, i.e., a
+ *   std::map from face id to statistics and a lookup of the face description on every event
+ * - dense: L3RateTracer
+ *
+ * For each mode, the process CPU time per traced event and the overhead of the tracer, i.e., the
+ * difference from the baseline per traced event, are printed:
+ *
+ *     ./waf --run="ndn-l3-rate-tracer-overhead --rows=32 --columns=32"
+ *
+ * --mode runs only the baseline and the given mode.  By default, rates are written only once at
+ * the end, so the printing does not dominate.
+ */
+
+static uint64_t g_nEvents = 0;
+
+class CountingTracer : public L3Tracer {
+public:
+  CountingTracer(Ptr<Node> node)
+    : L3Tracer(node)
+  {
+  }
+
+  virtual void
+  PrintHeader(std::ostream& os) const
+  {
+  }
+
+  virtual void
+  Print(std::ostream& os) const
+  {
+  }
+
+protected:
+  virtual void
+  OutInterests(const Interest&, const Face&)
+  {
+    g_nEvents++;
+  }
+
+  virtual void
+  InInterests(const Interest&, const Face&)
+  {
+    g_nEvents++;
+  }
+
+  virtual void
+  OutData(const Data&, const Face&)
+  {
+    g_nEvents++;
+  }
+
+  virtual void
+  InData(const Data&, const Face&)
+  {
+    g_nEvents++;
+  }
+
+  virtual void
+  OutNack(const lp::Nack&, const Face&)
+  {
+    g_nEvents++;
+  }
+
+  virtual void
+  InNack(const lp::Nack&, const Face&)
+  {
+    g_nEvents++;
+  }
+
+  virtual void
+  SatisfiedInterests(const nfd::pit::Entry&, const Face&, const Data&)
+  {
+    g_nEvents++;
+  }
+
+  virtual void
+  TimedOutInterests(const nfd::pit::Entry&)
+  {
+    g_nEvents++;
+  }
+};
+
+class MapRateTracer : public L3Tracer {
+public:
+  MapRateTracer(Ptr<Node> node)
+    : L3Tracer(node)
+  {
+  }
+
+  virtual void
+  PrintHeader(std::ostream& os) const
+  {
+  }
+
+  virtual void
+  Print(std::ostream& os) const
+  {
+  }
+
+protected:
+  virtual void
+  OutInterests(const Interest& interest, const Face& face)
+  {
+    AddInfo(face);
+    std::get<0>(m_stats[face.getId()]).m_outInterests++;
+    if (interest.hasWire()) {
+      std::get<1>(m_stats[face.getId()]).m_outInterests += interest.wireEncode().size();
+    }
+  }
+
+  virtual void
+  InInterests(const Interest& interest, const Face& face)
+  {
+    AddInfo(face);
+    std::get<0>(m_stats[face.getId()]).m_inInterests++;
+    if (interest.hasWire()) {
+      std::get<1>(m_stats[face.getId()]).m_inInterests += interest.wireEncode().size();
+    }
+  }
+
+  virtual void
+  OutData(const Data& data, const Face& face)
+  {
+    AddInfo(face);
+    std::get<0>(m_stats[face.getId()]).m_outData++;
+    if (data.hasWire()) {
+      std::get<1>(m_stats[face.getId()]).m_outData += data.wireEncode().size();
+    }
+  }
+
+  virtual void
+  InData(const Data& data, const Face& face)
+  {
+    AddInfo(face);
+    std::get<0>(m_stats[face.getId()]).m_inData++;
+    if (data.hasWire()) {
+      std::get<1>(m_stats[face.getId()]).m_inData += data.wireEncode().size();
+    }
+  }
+
+  virtual void
+  OutNack(const lp::Nack& nack, const Face& face)
+  {
+    AddInfo(face);
+    std::get<0>(m_stats[face.getId()]).m_outNack++;
+  }
+
+  virtual void
+  InNack(const lp::Nack& nack, const Face& face)
+  {
+    AddInfo(face);
+    std::get<0>(m_stats[face.getId()]).m_inNack++;
+  }
+
+  virtual void
+  SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
+  {
+    std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_satisfiedInterests++;
+
+    for (const auto& in : entry.getInRecords()) {
+      AddInfo(in.getFace());
+      std::get<0>(m_stats[(in.getFace()).getId()]).m_satisfiedInterests++;
+    }
+
+    for (const auto& out : entry.getOutRecords()) {
+      AddInfo(out.getFace());
+      std::get<0>(m_stats[(out.getFace()).getId()]).m_outSatisfiedInterests++;
+    }
+  }
+
+  virtual void
+  TimedOutInterests(const nfd::pit::Entry& entry)
+  {
+    std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_timedOutInterests++;
+
+    for (const auto& in : entry.getInRecords()) {
+      AddInfo(in.getFace());
+      std::get<0>(m_stats[(in.getFace()).getId()]).m_timedOutInterests++;
+    }
+
+    for (const auto& out : entry.getOutRecords()) {
+      AddInfo(out.getFace());
+      std::get<0>(m_stats[(out.getFace()).getId()]).m_outTimedOutInterests++;
+    }
+  }
+
+private:
+  void
+  AddInfo(const Face& face)
+  {
+    if (m_faceInfos.find(face.getId()) == m_faceInfos.end()) {
+      m_faceInfos.insert(make_pair(face.getId(),
+                                   boost::lexical_cast<std::string>(face.getLocalUri())));
+    }
+  }
+
+private:
+  std::map<nfd::FaceId, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
+  std::map<nfd::FaceId, std::string> m_faceInfos;
+};
+
+struct RunResult {
+  uint64_t events;
+  double cpuSeconds;
+};
+
+static RunResult
+Run(const std::string& mode, uint32_t rows, uint32_t columns, double rate,
+    const std::string& file, Time simulationTime, Time period)
+{
+  g_nEvents = 0;
+
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(rows, columns, p2p);
+  grid.BoundingBox(100, 100, 200, 200);
+
+  StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  for (uint32_t row = 0; row < rows; row++) {
+    AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix/" + boost::lexical_cast<std::string>(row));
+    consumerHelper.SetAttribute("Frequency", DoubleValue(rate));
+    consumerHelper.Install(grid.GetNode(row, 0));
+  }
+
+  Ptr<Node> producer = grid.GetNode(rows - 1, columns - 1);
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(producer);
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", producer);
+  GlobalRoutingHelper::CalculateRoutes();
+
+  std::list<Ptr<L3Tracer>> tracers;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    tracers.push_back(Create<CountingTracer>(*node));
+    if (mode == "map") {
+      tracers.push_back(Create<MapRateTracer>(*node));
+    }
+  }
+  if (mode == "dense") {
+    L3RateTracer::InstallAll(file, period);
+  }
+
+  Simulator::Stop(simulationTime);
+
+  std::clock_t start = std::clock();
+  Simulator::Run();
+  RunResult result = {g_nEvents, static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC};
+
+  L3RateTracer::Destroy();
+  tracers.clear();
+  Simulator::Destroy();
+  GlobalRouter::clear();
+
+  return result;
+}
+
+int
+main(int argc, char* argv[])
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("1000"));
+
+  uint32_t rows = 32;
+  uint32_t columns = 32;
+  double rate = 100;
+  std::string mode;
+  std::string file = "l3-rate-trace.txt";
+  Time simulationTime = Seconds(10);
+  Time period;
+
+  CommandLine cmd;
+  cmd.AddValue("rows", "Number of rows of the grid", rows);
+  cmd.AddValue("columns", "Number of columns of the grid", columns);
+  cmd.AddValue("rate", "Interest rate of each consumer", rate);
+  cmd.AddValue("mode", "Tracer to measure: map or dense (default, both)", mode);
+  cmd.AddValue("file", "Trace file of L3RateTracer in the dense mode", file);
+  cmd.AddValue("sim-time", "Simulation time", simulationTime);
+  cmd.AddValue("period", "Averaging period of L3RateTracer (default, simulation time)", period);
+  cmd.Parse(argc, argv);
+
+  if (period.IsZero()) {
+    period = simulationTime;
+  }
+
+  std::vector<std::string> modes = {"none"};
+  if (mode.empty()) {
+    modes.push_back("map");
+    modes.push_back("dense");
+  }
+  else if (mode != "none") {
+    modes.push_back(mode);
+  }
+
+  std::cout << "Mode"
+            << "\t"
+            << "Nodes"
+            << "\t"
+            << "TracedEvents"
+            << "\t"
+            << "CpuSeconds"
+            << "\t"
+            << "CpuNsPerEvent"
+            << "\t"
+            << "OverheadNsPerEvent"
+            << "\n";
+
+  double baselineNsPerEvent = 0;
+  for (const std::string& run : modes) {
+    RunResult result = Run(run, rows, columns, rate, file, simulationTime, period);
+
+    double nsPerEvent = result.cpuSeconds * 1e9 / result.events;
+    if (run == "none") {
+      baselineNsPerEvent = nsPerEvent;
+    }
+    std::cout << run << "\t" << rows * columns << "\t" << result.events << "\t"
+              << result.cpuSeconds << "\t" << nsPerEvent << "\t"
+              << nsPerEvent - baselineNsPerEvent << "\n";
+  }
+
+  return 0;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::ndn::main(argc, argv);
+}
@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-name-interning.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/ndn-name-prefix-table.hpp"
+
+#include <cstdlib>
+#include <new>
+
+static uint64_t g_nAllocations = 0;
+
+void*
+operator new(std::size_t size)
+{
+  g_nAllocations++;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * This program reports the number of heap allocations needed to build one Interest in Consumer
+ * and one Data in Producer, with and without interned prefixes:
+ *
+ *     ./waf --run="ndn-name-interning --prefix=/catalog/video/movies/2018/hd --n=100000"
+ *
+ * "before" replicates the code that was used by the applications before NamePrefixTable was
+ * introduced: a copy of the prefix with an appended sequence number for each Interest, and a new
+ * payload buffer and signature for each Data.
+ */
+class Tester {
+public:
+  Tester(const Name& prefix, uint32_t payloadSize, const Name& keyLocator)
+    : m_prefix(prefix)
+    , m_payloadSize(payloadSize)
+    , m_keyLocator(keyLocator)
+  {
+    m_prefixId = NamePrefixTable::get().intern(m_prefix);
+
+    m_payload = make_shared< ::ndn::Buffer>(m_payloadSize);
+    m_signature = makeSignature();
+    m_signature.getInfo().wireEncode();
+  }
+
+  shared_ptr<Interest>
+  makeInterestBefore(uint32_t seq) const
+  {
+    shared_ptr<Name> nameWithSequence = make_shared<Name>(m_prefix);
+    nameWithSequence->appendSequenceNumber(seq);
+
+    shared_ptr<Interest> interest = make_shared<Interest>();
+    interest->setNonce(seq);
+    interest->setName(*nameWithSequence);
+    interest->setInterestLifetime(time::seconds(2));
+    interest->wireEncode();
+    return interest;
+  }
+
+  shared_ptr<Interest>
+  makeInterestAfter(uint32_t seq) const
+  {
+    shared_ptr<Interest> interest = make_shared<Interest>();
+    interest->setNonce(seq);
+    interest->setName(NamePrefixTable::get().makeName(m_prefixId, seq));
+    interest->setInterestLifetime(time::seconds(2));
+    interest->wireEncode();
+    return interest;
+  }
+
+  shared_ptr<Data>
+  makeDataBefore(const Interest& interest) const
+  {
+    Name dataName(interest.getName());
+
+    auto data = make_shared<Data>();
+    data->setName(dataName);
+    data->setContent(make_shared< ::ndn::Buffer>(m_payloadSize));
+    data->setSignature(makeSignature());
+    data->wireEncode();
+    return data;
+  }
+
+  shared_ptr<Data>
+  makeDataAfter(const Interest& interest) const
+  {
+    auto data = make_shared<Data>();
+    data->setName(interest.getName());
+    data->setContent(m_payload);
+    data->setSignature(m_signature);
+    data->wireEncode();
+    return data;
+  }
+
+private:
+  Signature
+  makeSignature() const
+  {
+    Signature signature;
+    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    if (m_keyLocator.size() > 0) {
+      signatureInfo.setKeyLocator(m_keyLocator);
+    }
+    signature.setInfo(signatureInfo);
+    signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    return signature;
+  }
+
+private:
+  Name m_prefix;
+  uint32_t m_payloadSize;
+  Name m_keyLocator;
+
+  NamePrefixTable::Id m_prefixId;
+  shared_ptr<const ::ndn::Buffer> m_payload;
+  Signature m_signature;
+};
+
+template<class Function>
+static double
+countAllocations(uint32_t n, const Function& function)
+{
+  uint64_t before = g_nAllocations;
+  for (uint32_t seq = 0; seq < n; seq++) {
+    function(seq);
+  }
+  return static_cast<double>(g_nAllocations - before) / n;
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::string prefix = "/catalog/video/movies/2018/hd";
+  std::string keyLocator = "/catalog/KEY";
+  uint32_t payloadSize = 1024;
+  uint32_t n = 100000;
+
+  CommandLine cmd;
+  cmd.AddValue("prefix", "Prefix of requested names", prefix);
+  cmd.AddValue("keyLocator", "Key locator of Data packets", keyLocator);
+  cmd.AddValue("payloadSize", "Size of Data payload", payloadSize);
+  cmd.AddValue("n", "Number of packets to build", n);
+  cmd.Parse(argc, argv);
+
+  Tester tester(prefix, payloadSize, keyLocator);
+  shared_ptr<Interest> interest = tester.makeInterestAfter(0);
+
+  double interestBefore =
+    countAllocations(n, [&](uint32_t seq) { tester.makeInterestBefore(seq); });
+  double interestAfter =
+    countAllocations(n, [&](uint32_t seq) { tester.makeInterestAfter(seq); });
+  double dataBefore = countAllocations(n, [&](uint32_t) { tester.makeDataBefore(*interest); });
+  double dataAfter = countAllocations(n, [&](uint32_t) { tester.makeDataAfter(*interest); });
+
+  std::cout << "Allocations per packet, prefix " << prefix << " (" << Name(prefix).size()
+            << " components)\n"
+            << "Packet\tBefore\tAfter\n"
+            << "Interest\t" << interestBefore << "\t" << interestAfter << "\n"
+            << "Data\t" << dataBefore << "\t" << dataAfter << "\n";
+
+  return 0;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::ndn::main(argc, argv);
+}
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-shared-app-face.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+
+namespace ns3 {
+
+/**
+ * This scenario compares per-node overhead of private application faces and the face shared by
+ * all applications on the node (App's SharedFace attribute):
+ *
+ *
+ *      +-----------+     10Gbps     +--------+     10Gbps     +----------+
+ *      | host with | <------------> | router | <------------> | producer |
+ *      | N apps    |       10ms     +--------+       10ms     +----------+
+ *      +-----------+
+ *
+ *
+ * Each of the N consumers on the host requests /prefix/<seq> at the given rate, so consumers
+ * request the same names, as in an access network aggregating many users.  At the end of the
+ * simulation, the number of faces, PIT entries, and PIT in-records on the host, and resident
+ * memory of the process are printed.
+ *
+ *     ./waf --run="ndn-shared-app-face --apps=1000 --shared=0"
+ *     ./waf --run="ndn-shared-app-face --apps=1000 --shared=1"
+ */
+
+class Tester {
+public:
+  Tester()
+    : m_nApps(1000)
+    , m_useSharedFace(false)
+    , m_interestRate(10)
+    , m_simulationTime(Seconds(2))
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+  void
+  printStats(std::ostream& os, Ptr<Node> host, double initialMemory);
+
+private:
+  uint32_t m_nApps;
+  bool m_useSharedFace;
+  double m_interestRate;
+  Time m_simulationTime;
+};
+
+void
+Tester::printStats(std::ostream& os, Ptr<Node> host, double initialMemory)
+{
+  auto forwarder = host->GetObject<ndn::L3Protocol>()->getForwarder();
+
+  uint64_t nInRecords = 0;
+  for (const auto& pitEntry : forwarder->getPit()) {
+    nInRecords += pitEntry.getInRecords().size();
+  }
+
+  os << "Mode"
+     << "\t"
+     << "Apps"
+     << "\t"
+     << "Faces"
+     << "\t"
+     << "PitEntries"
+     << "\t"
+     << "PitInRecords"
+     << "\t"
+     << "MemoryMiB"
+     << "\n";
+
+  os << (m_useSharedFace ? "shared" : "private") << "\t" << m_nApps << "\t"
+     << forwarder->getFaceTable().size() << "\t" << forwarder->getPit().size() << "\t"
+     << nInRecords << "\t" << (MemUsage::Get() / 1024.0 / 1024.0 - initialMemory) << "\n";
+}
+
+int
+Tester::run(int argc, char* argv[])
+{
+  // setting default parameters for PointToPoint links and channels
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("10000"));
+
+  CommandLine cmd;
+  cmd.AddValue("apps", "Number of consumer applications on the host", m_nApps);
+  cmd.AddValue("shared", "Use the face shared by all applications on the host", m_useSharedFace);
+  cmd.AddValue("rate", "Interest rate of each consumer", m_interestRate);
+  cmd.AddValue("sim-time", "Simulation time", m_simulationTime);
+  cmd.Parse(argc, argv);
+
+  double initialMemory = MemUsage::Get() / 1024.0 / 1024.0;
+
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.InstallAll();
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(m_interestRate));
+  consumerHelper.SetAttribute("SharedFace", BooleanValue(m_useSharedFace));
+  for (uint32_t i = 0; i < m_nApps; i++) {
+    consumerHelper.Install(nodes.Get(0));
+  }
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(nodes.Get(2));
+
+  // collect statistics while Interests of the last round are still pending
+  Simulator::Schedule(m_simulationTime - MilliSeconds(1), &Tester::printStats, this,
+                      std::ref(std::cout), nodes.Get(0), initialMemory);
+
+  Simulator::Stop(m_simulationTime);
+  Simulator::Run();
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::Tester tester;
+  return tester.run(argc, argv);
+}
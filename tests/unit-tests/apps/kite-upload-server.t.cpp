@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/kite-upload-server.hpp"
+
+#include <map>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class KiteUploadServerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  KiteUploadServerFixture()
+  {
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/producer", 1},
+        {"2", "1", "/server", 1},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::KiteUploadServer",
+            {{"ServerPrefix", "/server"}, {"LifeTime", "1s"}},
+            "0s", "100s"},
+        // an upload Interest, asking the server to fetch /producer/data, which nobody serves
+        {"2", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/server/upload/producer/data"}, {"MaxSeq", "1"}},
+            "0s", "100s"}
+      });
+
+    getNode("1")->GetApplication(0)->TraceConnectWithoutContext("TransmittedInterests",
+      MakeCallback(&KiteUploadServerFixture::onTransmittedInterest, this));
+  }
+
+  void
+  onTransmittedInterest(shared_ptr<const Interest> interest, Ptr<App>, shared_ptr<Face>)
+  {
+    sentTimes[interest->getName()].push_back(Simulator::Now());
+  }
+
+public:
+  std::map<Name, std::vector<Time>> sentTimes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsKiteUploadServer, KiteUploadServerFixture)
+
+BOOST_AUTO_TEST_CASE(RetransmissionAfterTimeout)
+{
+  Simulator::Stop(Seconds(3.0));
+  Simulator::Run();
+
+  // the initial RTO of 1s is not shorter than the Interest lifetime, yet the exchange is
+  // retransmitted once on timeout
+  Name first = Name("/producer/data").appendSequenceNumber(0);
+  BOOST_REQUIRE_EQUAL(sentTimes[first].size(), 2);
+  BOOST_CHECK_GE(sentTimes[first][1] - sentTimes[first][0], Seconds(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-kite-helper.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class KiteHelperFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  KiteHelperFixture()
+  {
+    createTopology({
+        {"1", "2"},
+        {"2", "3"},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::KiteRv",
+            {{"RvPrefix", "/rv"}, {"InstancePrefix", "/rv1"}},
+            "0s", "100s"},
+        {"2", "ns3::ndn::KiteRv",
+            {{"RvPrefix", "/rv"}, {"InstancePrefix", "/rv2"}},
+            "0s", "100s"},
+        {"3", "ns3::ndn::KiteRv",
+            {{"RvPrefix", "/rv"}, {"InstancePrefix", "/rv3"}},
+            "0s", "100s"},
+        // a single trace Interest of /alice/photo, answered by the local RV of node 1
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/rv/trace/alice/photo"}, {"MaxSeq", "1"}},
+            "1s", "100s"}
+      });
+
+    NodeContainer rvNodes;
+    rvNodes.Add(getNode("1"));
+    rvNodes.Add(getNode("2"));
+    rvNodes.Add(getNode("3"));
+    group = helper.AddRvGroup(rvNodes, Seconds(0.2));
+  }
+
+  std::vector<Name>
+  getAttachments()
+  {
+    std::vector<Name> attachments;
+    for (const auto& rv : helper.GetRvGroup(group)) {
+      attachments.push_back(rv->GetAttachment("/alice/photo"));
+    }
+    return attachments;
+  }
+
+public:
+  KiteHelper helper;
+  size_t group;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnKiteHelper, KiteHelperFixture)
+
+BOOST_AUTO_TEST_CASE(RvGroup)
+{
+  BOOST_REQUIRE_EQUAL(helper.GetRvGroup(group).size(), 3);
+
+  std::vector<Name> attached, updated;
+  Simulator::Schedule(Seconds(1.1), [&] { attached = getAttachments(); });
+  Simulator::Schedule(Seconds(1.5), [&] { updated = getAttachments(); });
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+
+  // the RV answering the trace learns the attachment at once, others after the update delay
+  std::vector<Name> expectedAttached = {"/rv1", "/", "/"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(attached.begin(), attached.end(),
+                                expectedAttached.begin(), expectedAttached.end());
+
+  std::vector<Name> expectedUpdated = {"/rv1", "/rv1", "/rv1"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(updated.begin(), updated.end(),
+                                expectedUpdated.begin(), expectedUpdated.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
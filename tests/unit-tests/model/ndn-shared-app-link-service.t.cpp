@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-shared-app-link-service.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "apps/ndn-app.hpp"
+#include "helper/ndn-app-helper.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class SharedAppFaceFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  SharedAppFaceFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+  }
+
+  ApplicationContainer
+  installConsumers(size_t nConsumers)
+  {
+    AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix");
+    consumerHelper.SetAttribute("Frequency", StringValue("10"));
+    consumerHelper.SetAttribute("SharedFace", BooleanValue(true));
+
+    ApplicationContainer apps;
+    for (size_t i = 0; i < nConsumers; ++i) {
+      apps.Add(consumerHelper.Install(getNode("1")));
+    }
+    for (ApplicationContainer::Iterator app = apps.Begin(); app != apps.End(); ++app) {
+      (*app)->TraceConnectWithoutContext("ReceivedDatas",
+                                         MakeCallback(&SharedAppFaceFixture::onData, this));
+    }
+    apps.Stop(Seconds(0.95));
+    return apps;
+  }
+
+  void
+  onData(shared_ptr<const Data> data, Ptr<App> app, shared_ptr<Face> face)
+  {
+    nData[app]++;
+  }
+
+  size_t
+  countAppFaces(const std::string& node)
+  {
+    size_t nAppFaces = 0;
+    for (const auto& face : getNode(node)->GetObject<L3Protocol>()->getForwarder()->getFaceTable()) {
+      if (face.getLocalUri().getScheme() == "appFace") {
+        nAppFaces++;
+      }
+    }
+    return nAppFaces;
+  }
+
+  bool
+  hasSharedFaceRoute(const std::string& node, const Name& prefix)
+  {
+    Ptr<L3Protocol> l3 = getNode(node)->GetObject<L3Protocol>();
+    const nfd::fib::Entry* entry = l3->getForwarder()->getFib().findExactMatch(prefix);
+    return entry != nullptr && entry->hasNextHop(*l3->getSharedAppFace());
+  }
+
+public:
+  std::map<Ptr<App>, size_t> nData;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnSharedAppLinkService, SharedAppFaceFixture)
+
+BOOST_AUTO_TEST_CASE(ConsumersAndProducer)
+{
+  ApplicationContainer consumers = installConsumers(3);
+
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("SharedFace", BooleanValue(true));
+  producerHelper.Install(getNode("2"));
+
+  Simulator::Stop(Seconds(1.0));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(countAppFaces("1"), 1);
+  BOOST_CHECK_EQUAL(countAppFaces("2"), 1);
+
+  // every consumer receives Data for each of its 10 Interests
+  BOOST_REQUIRE_EQUAL(nData.size(), 3);
+  for (const auto& entry : nData) {
+    BOOST_CHECK_EQUAL(entry.second, 10);
+  }
+
+  auto sharedLink = static_cast<SharedAppLinkService*>(
+    getNode("1")->GetObject<L3Protocol>()->getSharedAppFace()->getLinkService());
+  BOOST_CHECK_EQUAL(sharedLink->getNPendingInterests(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AggregatedPitInRecords)
+{
+  installConsumers(5);
+
+  // no producer, so that Interests remain pending
+  Simulator::Stop(Seconds(0.005));
+  Simulator::Run();
+
+  const nfd::Pit& pit = getNode("1")->GetObject<L3Protocol>()->getForwarder()->getPit();
+  BOOST_CHECK_EQUAL(pit.size(), 1);
+  for (const auto& entry : pit) {
+    BOOST_CHECK_EQUAL(entry.getInRecords().size(), 1);
+  }
+
+  auto sharedLink = static_cast<SharedAppLinkService*>(
+    getNode("1")->GetObject<L3Protocol>()->getSharedAppFace()->getLinkService());
+  BOOST_CHECK_EQUAL(sharedLink->getNPendingInterests(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(RoutesOfStoppedProducers)
+{
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("SharedFace", BooleanValue(true));
+  ApplicationContainer producers;
+  producers.Add(producerHelper.Install(getNode("2")));
+  producers.Add(producerHelper.Install(getNode("2")));
+  producers.Get(0)->SetStopTime(Seconds(1.0));
+  producers.Get(1)->SetStopTime(Seconds(2.0));
+
+  bool hasRouteWithOne = false;
+  Simulator::Schedule(Seconds(1.5), [&] { hasRouteWithOne = hasSharedFaceRoute("2", "/prefix"); });
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  // the route stays while any producer serves the prefix
+  BOOST_CHECK(hasRouteWithOne);
+  BOOST_CHECK(!hasSharedFaceRoute("2", "/prefix"));
+  BOOST_CHECK_EQUAL(countAppFaces("2"), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
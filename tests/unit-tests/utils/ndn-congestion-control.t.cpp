@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-congestion-control.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnCongestionControl, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Aimd)
+{
+  Ptr<CongestionControl> cc = CreateObject<CongestionControlAimd>();
+  cc->Reset();
+  BOOST_CHECK_EQUAL(cc->GetWindow(), 2.0);
+  BOOST_CHECK_EQUAL(cc->GetPacingRate(), 0.0);
+
+  // slow start
+  for (int i = 0; i < 3; i++) {
+    cc->OnData(MilliSeconds(100), MilliSeconds(100), 1);
+  }
+  BOOST_CHECK_EQUAL(cc->GetWindow(), 5.0);
+
+  cc->OnCongestion();
+  BOOST_CHECK_EQUAL(cc->GetWindow(), 2.5);
+  BOOST_CHECK_EQUAL(cc->GetSsthresh(), 2.5);
+
+  // congestion avoidance
+  cc->OnData(MilliSeconds(100), MilliSeconds(100), 1);
+  BOOST_CHECK_CLOSE(cc->GetWindow(), 2.9, 0.0001);
+
+  cc->OnTimeout();
+  BOOST_CHECK_CLOSE(cc->GetWindow(), 1.45, 0.0001);
+
+  cc->OnCongestion();
+  BOOST_CHECK_EQUAL(cc->GetWindow(), 1.0); // MinWindow
+}
+
+BOOST_AUTO_TEST_CASE(Cubic)
+{
+  Ptr<CongestionControl> cc = CreateObject<CongestionControlCubic>();
+  cc->SetAttribute("InitialWindow", DoubleValue(10.0));
+  cc->Reset();
+  BOOST_CHECK_EQUAL(cc->GetWindow(), 10.0);
+
+  cc->OnCongestion();
+  BOOST_CHECK_CLOSE(cc->GetWindow(), 7.0, 0.0001);
+  BOOST_CHECK_CLOSE(cc->GetSsthresh(), 7.0, 0.0001);
+
+  // fast convergence: the second reduction happens below the previous maximum
+  cc->OnCongestion();
+  BOOST_CHECK_CLOSE(cc->GetWindow(), 4.9, 0.0001);
+
+  // the window grows, but never by more than one Interest per Data
+  double window = cc->GetWindow();
+  for (int i = 0; i < 10; i++) {
+    cc->OnData(MilliSeconds(100), MilliSeconds(100), 1);
+    BOOST_CHECK_GE(cc->GetWindow(), window);
+    BOOST_CHECK_LE(cc->GetWindow(), window + 1.0);
+    window = cc->GetWindow();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Bbr)
+{
+  Ptr<CongestionControl> cc = CreateObject<CongestionControlBbr>();
+  cc->Reset();
+  BOOST_CHECK_EQUAL(cc->GetPacingRate(), 0.0); // no bandwidth estimate yet
+
+  cc->OnData(MilliSeconds(100), MilliSeconds(100), 1);
+  BOOST_CHECK_EQUAL(cc->GetWindow(), 3.0);
+
+  // congestion signals are ignored, timeouts are not
+  cc->OnCongestion();
+  BOOST_CHECK_EQUAL(cc->GetWindow(), 3.0);
+  cc->OnTimeout();
+  BOOST_CHECK_EQUAL(cc->GetWindow(), 1.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-hop-distance-oracle.hpp"
+#include "helper/ndn-global-routing-helper.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class HopDistanceOracleFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  HopDistanceOracleFixture()
+  {
+    // 1 - 2 - 3 - 4
+    //  \         /
+    //   5 ----- 6     7
+    createTopology({
+        {"1", "2"}, {"2", "3"}, {"3", "4"},
+        {"1", "5"}, {"5", "6"}, {"6", "4"},
+        {"7"}
+      });
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnHopDistanceOracle, HopDistanceOracleFixture)
+
+BOOST_AUTO_TEST_CASE(PointToPointChannels)
+{
+  HopDistanceOracle& oracle = HopDistanceOracle::get();
+  BOOST_CHECK_EQUAL(oracle.size(), 0);
+
+  BOOST_CHECK_EQUAL(oracle.getDistance(getNode("1"), getNode("1")), 0);
+  BOOST_CHECK_EQUAL(oracle.getDistance(getNode("1"), getNode("2")), 1);
+  BOOST_CHECK_EQUAL(oracle.getDistance(getNode("1"), getNode("4")), 3);
+  BOOST_CHECK_EQUAL(oracle.getDistance(getNode("1"), getNode("6")), 2);
+  BOOST_CHECK_EQUAL(oracle.getDistance(getNode("2"), getNode("6")), 3);
+  BOOST_CHECK_EQUAL(oracle.getDistance(getNode("1"), getNode("7")), HopDistanceOracle::UNREACHABLE);
+
+  // one BFS per queried source
+  BOOST_CHECK_EQUAL(oracle.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(GlobalRouterIncidencies)
+{
+  GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  HopDistanceOracle& oracle = HopDistanceOracle::get();
+  BOOST_CHECK_EQUAL(oracle.getDistance(getNode("4"), getNode("1")), 3);
+  BOOST_CHECK_EQUAL(oracle.getDistance(getNode("4"), getNode("5")), 2);
+  BOOST_CHECK_EQUAL(oracle.getDistance(getNode("7"), getNode("4")), HopDistanceOracle::UNREACHABLE);
+}
+
+BOOST_AUTO_TEST_CASE(Clear)
+{
+  HopDistanceOracle& oracle = HopDistanceOracle::get();
+  BOOST_CHECK_EQUAL(oracle.getDistance(getNode("3"), getNode("5")), 3);
+  BOOST_CHECK_EQUAL(oracle.size(), 1);
+
+  // nodes created after the row has been computed are not reachable until cleared
+  Ptr<Node> node = CreateObject<Node>();
+  BOOST_CHECK_EQUAL(oracle.getDistance(getNode("3"), node), HopDistanceOracle::UNREACHABLE);
+
+  oracle.clear();
+  BOOST_CHECK_EQUAL(oracle.size(), 0);
+  BOOST_CHECK_EQUAL(oracle.getDistance(getNode("3"), getNode("5")), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-name-prefix-table.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnNamePrefixTable, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Intern)
+{
+  NamePrefixTable& table = NamePrefixTable::get();
+  size_t nPrefixes = table.size();
+
+  NamePrefixTable::Id id = table.intern("/test/name-prefix-table/intern");
+  BOOST_CHECK_EQUAL(table.size(), nPrefixes + 1);
+  BOOST_CHECK_EQUAL(table.getPrefix(id), Name("/test/name-prefix-table/intern"));
+
+  BOOST_CHECK_EQUAL(table.intern("/test/name-prefix-table/intern"), id);
+  BOOST_CHECK_EQUAL(table.size(), nPrefixes + 1);
+
+  BOOST_CHECK_NE(table.intern("/test/name-prefix-table/other"), id);
+  BOOST_CHECK_EQUAL(table.size(), nPrefixes + 2);
+}
+
+BOOST_AUTO_TEST_CASE(MakeName)
+{
+  NamePrefixTable& table = NamePrefixTable::get();
+  NamePrefixTable::Id id = table.intern("/test/name-prefix-table/make-name");
+
+  Name expected("/test/name-prefix-table/make-name");
+  expected.appendSequenceNumber(42);
+
+  Name name = table.makeName(id, 42);
+  BOOST_CHECK_EQUAL(name, expected);
+  BOOST_CHECK_EQUAL(name.at(-1).toSequenceNumber(), 42);
+  BOOST_CHECK(name.wireEncode() == expected.wireEncode());
+
+  BOOST_CHECK_EQUAL(table.makeName(id, name::Component("last")),
+                    Name("/test/name-prefix-table/make-name/last"));
+
+  // root prefix
+  NamePrefixTable::Id root = table.intern("/");
+  BOOST_CHECK_EQUAL(table.makeName(root, name::Component("first")), Name("/first"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-request-trace.hpp"
+#include "apps/ndn-app.hpp"
+#include "helper/ndn-app-helper.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.bin";
+
+class RequestTraceFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  RequestTraceFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~RequestTraceFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+  }
+
+  void
+  onTransmittedInterest(shared_ptr<const Interest> interest, Ptr<App>, shared_ptr<Face>)
+  {
+    sent.push_back(std::make_pair(Simulator::Now(), interest->getName()));
+  }
+
+  void
+  onFirstInterestDataDelay(Ptr<App>, uint32_t seq, Time delay, uint32_t retxCount, int32_t)
+  {
+    retxCounts.push_back(retxCount);
+  }
+
+public:
+  std::vector<std::pair<Time, Name>> sent;
+  std::vector<uint32_t> retxCounts;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnRequestTrace, RequestTraceFixture)
+
+BOOST_AUTO_TEST_CASE(ConvertText)
+{
+  std::istringstream log("# time name size\n"
+                         "10.5 /a/b 100\n"
+                         "\n"
+                         "10.75 /c 200\n"
+                         "11.5 /a/b 300\n");
+
+  BOOST_CHECK_EQUAL(RequestTraceWriter::convertText(log, TEST_TRACE.string()), 3);
+
+  RequestTraceReader reader(TEST_TRACE.string());
+  BOOST_CHECK_EQUAL(reader.getNRecords(), 3);
+  BOOST_CHECK_EQUAL(reader.getNNames(), 2);
+  BOOST_CHECK_EQUAL(reader.hasSize(), true);
+
+  RequestTrace::Record record;
+  BOOST_REQUIRE(reader.peek(record));
+  BOOST_CHECK_EQUAL(record.offset, 0);
+  BOOST_CHECK_EQUAL(reader.getName(record.nameId), Name("/a/b"));
+  BOOST_CHECK_EQUAL(record.size, 100);
+  reader.next();
+
+  BOOST_REQUIRE(reader.peek(record));
+  BOOST_CHECK_EQUAL(record.offset, 250000000);
+  BOOST_CHECK_EQUAL(reader.getName(record.nameId), Name("/c"));
+  BOOST_CHECK_EQUAL(record.size, 200);
+  reader.next();
+
+  BOOST_REQUIRE(reader.peek(record));
+  BOOST_CHECK_EQUAL(record.offset, 1000000000);
+  BOOST_CHECK_EQUAL(record.nameId, 0);
+  BOOST_CHECK_EQUAL(record.size, 300);
+  reader.next();
+
+  BOOST_CHECK_EQUAL(reader.peek(record), false);
+
+  reader.rewind();
+  BOOST_REQUIRE(reader.peek(record));
+  BOOST_CHECK_EQUAL(reader.getName(record.nameId), Name("/a/b"));
+
+  BOOST_CHECK_THROW(reader.getName(2), RequestTrace::Error);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidInput)
+{
+  std::istringstream unordered("2 /a\n1 /b\n");
+  BOOST_CHECK_THROW(RequestTraceWriter::convertText(unordered, TEST_TRACE.string()),
+                    RequestTrace::Error);
+
+  std::istringstream mixedSize("1 /a 10\n2 /b\n");
+  BOOST_CHECK_THROW(RequestTraceWriter::convertText(mixedSize, TEST_TRACE.string()),
+                    RequestTrace::Error);
+
+  std::ofstream os(TEST_TRACE.string().c_str());
+  os << "this is not a request trace, but it is long enough to have a header";
+  os.close();
+  BOOST_CHECK_THROW(RequestTraceReader(TEST_TRACE.string()), RequestTrace::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Replay)
+{
+  {
+    RequestTraceWriter writer(TEST_TRACE.string(), false);
+    writer.add(0, "/a");
+    writer.add(500000000, "/b");
+    writer.add(500000000, "/a");
+    writer.add(2000000000, "/c");
+  }
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerTraceReplay");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("TraceFile", StringValue(TEST_TRACE.string()));
+  ApplicationContainer apps = consumerHelper.Install(getNode("1"));
+  apps.Start(Seconds(1.0));
+
+  apps.Get(0)->TraceConnectWithoutContext("TransmittedInterests",
+    MakeCallback(&RequestTraceFixture::onTransmittedInterest, this));
+
+  Simulator::Stop(Seconds(1.9)); // before the retransmission timer fires for any Interest
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(sent.size(), 3);
+  BOOST_CHECK_EQUAL(sent[0].first, Seconds(1.0));
+  BOOST_CHECK_EQUAL(sent[0].second, Name("/prefix/a").appendSequenceNumber(0));
+  BOOST_CHECK_EQUAL(sent[1].first, Seconds(1.5));
+  BOOST_CHECK_EQUAL(sent[1].second, Name("/prefix/b").appendSequenceNumber(1));
+  BOOST_CHECK_EQUAL(sent[2].first, Seconds(1.5));
+  BOOST_CHECK_EQUAL(sent[2].second, Name("/prefix/a").appendSequenceNumber(0));
+}
+
+BOOST_AUTO_TEST_CASE(RepeatedRequests)
+{
+  {
+    RequestTraceWriter writer(TEST_TRACE.string(), false);
+    writer.add(0, "/a");
+    writer.add(1000000000, "/a");
+  }
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"2", "ns3::ndn::Producer", {{"Prefix", "/prefix"}}, "0s", "100s"}
+    });
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerTraceReplay");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("TraceFile", StringValue(TEST_TRACE.string()));
+  ApplicationContainer apps = consumerHelper.Install(getNode("1"));
+
+  apps.Get(0)->TraceConnectWithoutContext("FirstInterestDataDelay",
+    MakeCallback(&RequestTraceFixture::onFirstInterestDataDelay, this));
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+
+  // the second request for /a is not a retransmission of the first one
+  BOOST_REQUIRE_EQUAL(retxCounts.size(), 2);
+  BOOST_CHECK_EQUAL(retxCounts[0], 1);
+  BOOST_CHECK_EQUAL(retxCounts[1], 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-rtt-per-interest.hpp"
+#include "helper/ndn-app-helper.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief RttPerInterest recording its samples and the RTO of every sent Interest
+ */
+class RttPerInterestRecorder : public RttPerInterest {
+public:
+  static TypeId
+  GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::ndn::RttPerInterestRecorder")
+                          .SetParent<RttPerInterest>()
+                          .AddConstructor<RttPerInterestRecorder>();
+    return tid;
+  }
+
+  virtual TypeId
+  GetInstanceTypeId() const
+  {
+    return GetTypeId();
+  }
+
+  void
+  SentSeq(SequenceNumber32 seq, uint32_t size)
+  {
+    rtos.push_back(RetransmitTimeout());
+    RttPerInterest::SentSeq(seq, size);
+  }
+
+  Time
+  AckInterest(SequenceNumber32 ackSeq, Time sentTime, bool isRetransmitted)
+  {
+    Time sample = RttPerInterest::AckInterest(ackSeq, sentTime, isRetransmitted);
+    acks.push_back(std::make_tuple(ackSeq.GetValue(), isRetransmitted, sample));
+    return sample;
+  }
+
+public:
+  static std::vector<Time> rtos;
+  static std::vector<std::tuple<uint32_t, bool, Time>> acks;
+};
+
+std::vector<Time> RttPerInterestRecorder::rtos;
+std::vector<std::tuple<uint32_t, bool, Time>> RttPerInterestRecorder::acks;
+
+NS_OBJECT_ENSURE_REGISTERED(RttPerInterestRecorder);
+
+class RttPerInterestFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  RttPerInterestFixture()
+  {
+    RttPerInterestRecorder::rtos.clear();
+    RttPerInterestRecorder::acks.clear();
+  }
+
+  ~RttPerInterestFixture()
+  {
+    Config::SetDefault("ns3::ndn::RttEstimator::InitialEstimation", StringValue("1s"));
+  }
+
+  void
+  createScenario(const std::string& delay, const std::string& maxSeq)
+  {
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue(delay));
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"MaxSeq", maxSeq},
+             {"RttEstimator", "ns3::ndn::RttPerInterestRecorder"}},
+            "0s", "100s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}},
+            "0s", "100s"}
+      });
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnRttPerInterest, RttPerInterestFixture)
+
+BOOST_AUTO_TEST_CASE(Samples)
+{
+  Ptr<RttPerInterest> rtt = CreateObject<RttPerInterest>();
+  BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), Seconds(1));
+
+  // sequence numbers are not tracked, only the send times
+  rtt->SentSeq(SequenceNumber32(5), 1);
+  Simulator::Schedule(MilliSeconds(100), [rtt] {
+      BOOST_CHECK_EQUAL(rtt->AckInterest(SequenceNumber32(7), Seconds(0), false),
+                        MilliSeconds(100));
+      BOOST_CHECK_EQUAL(rtt->AckSeq(SequenceNumber32(5)), Seconds(0));
+    });
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), MilliSeconds(100));
+  BOOST_CHECK_EQUAL(rtt->RetransmitTimeout(), MilliSeconds(300)); // 100ms + 4 * 50ms
+}
+
+BOOST_AUTO_TEST_CASE(KarnsAlgorithm)
+{
+  Ptr<RttPerInterest> rtt = CreateObject<RttPerInterest>();
+
+  Simulator::Schedule(MilliSeconds(100), [rtt] {
+      BOOST_CHECK_EQUAL(rtt->AckInterest(SequenceNumber32(1), Seconds(0), true), Seconds(0));
+    });
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), Seconds(1));
+}
+
+BOOST_AUTO_TEST_CASE(KeepsHistory)
+{
+  // consumers keep resetting the history-based estimators after every Data
+  BOOST_CHECK_EQUAL(CreateObject<RttMeanDeviation>()->KeepsHistory(), true);
+  BOOST_CHECK_EQUAL(CreateObject<RttPerInterest>()->KeepsHistory(), false);
+}
+
+BOOST_AUTO_TEST_CASE(ConsumerSamples)
+{
+  createScenario("10ms", "10");
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(RttPerInterestRecorder::acks.size(), 10);
+  for (const auto& ack : RttPerInterestRecorder::acks) {
+    BOOST_CHECK_EQUAL(std::get<1>(ack), false);
+    BOOST_CHECK_GT(std::get<2>(ack), MilliSeconds(20));
+  }
+
+  // the estimate is kept from one Data to the next, so the RTO drops below the initial 1s
+  BOOST_REQUIRE_EQUAL(RttPerInterestRecorder::rtos.size(), 10);
+  BOOST_CHECK_EQUAL(RttPerInterestRecorder::rtos.front(), Seconds(1));
+  BOOST_CHECK_LT(RttPerInterestRecorder::rtos.back(), Seconds(1));
+}
+
+BOOST_AUTO_TEST_CASE(ConsumerRetransmission)
+{
+  // RTT above the minimum RTO of 200ms, which applies until the first sample
+  Config::SetDefault("ns3::ndn::RttEstimator::InitialEstimation", StringValue("10ms"));
+  createScenario("150ms", "1");
+
+  Simulator::Stop(Seconds(1.0));
+  Simulator::Run();
+
+  // the only Interest is retransmitted before its Data arrives, so its Data is not sampled
+  BOOST_REQUIRE_EQUAL(RttPerInterestRecorder::acks.size(), 1);
+  BOOST_CHECK_EQUAL(std::get<0>(RttPerInterestRecorder::acks[0]), 0);
+  BOOST_CHECK_EQUAL(std::get<1>(RttPerInterestRecorder::acks[0]), true);
+  BOOST_CHECK_EQUAL(std::get<2>(RttPerInterestRecorder::acks[0]), Seconds(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/l2-rate-tracer.hpp"
+
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/queue.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class L2RateTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  L2RateTracerFixture()
+  {
+    createTopology({
+        {"1", "2"},
+      });
+
+    // Data packets from the producer overflow the slow link
+    auto device = DynamicCast<PointToPointNetDevice>(getNode("2")->GetDevice(0));
+    device->SetAttribute("DataRate", StringValue("1Mbps"));
+    device->GetQueue()->SetAttribute("MaxPackets", UintegerValue(5));
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "1000"}},
+            "0s", "0.5s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~L2RateTracerFixture()
+  {
+    L2RateTracer::Destroy(); // additional cleanup
+  }
+
+  std::vector<std::string>
+  getRow(const std::string& output, const std::string& type)
+  {
+    std::istringstream is(output);
+    for (std::string line; std::getline(is, line);) {
+      std::vector<std::string> row;
+      std::istringstream fields(line);
+      for (std::string field; std::getline(fields, field, '\t');) {
+        row.push_back(field);
+      }
+      if (row.size() == 9 && row[1] == "2" && row[4] == type) {
+        return row;
+      }
+    }
+    BOOST_ERROR("No " << type << " row");
+    return std::vector<std::string>(9, "0");
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersL2RateTracer, L2RateTracerFixture)
+
+BOOST_AUTO_TEST_CASE(DropsAndQueue)
+{
+  auto output = make_shared<std::ostringstream>();
+  Ptr<L2RateTracer> tracer = Create<L2RateTracer>(output, getNode("2"));
+  tracer->SetAveragingPeriod(Seconds(1));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  std::vector<std::string> drop = getRow(output->str(), "Drop");
+  BOOST_CHECK_EQUAL(drop[0], "1");
+  BOOST_CHECK_EQUAL(drop[2], "0");
+  BOOST_CHECK_GT(boost::lexical_cast<int64_t>(drop[3]), 0); // face on top of the device
+  BOOST_CHECK_GT(boost::lexical_cast<double>(drop[7]), 0);
+
+  std::vector<std::string> queueMax = getRow(output->str(), "QueueMax");
+  BOOST_CHECK_EQUAL(queueMax[3], drop[3]);
+  BOOST_CHECK_EQUAL(boost::lexical_cast<double>(queueMax[5]), 5);
+  BOOST_CHECK_GT(boost::lexical_cast<double>(queueMax[6]), 5);
+
+  std::vector<std::string> queueAvg = getRow(output->str(), "QueueAvg");
+  BOOST_CHECK_GT(boost::lexical_cast<double>(queueAvg[5]), 0);
+  BOOST_CHECK_LT(boost::lexical_cast<double>(queueAvg[5]), 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -157,6 +157,59 @@ BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
     "3.02089	2	0	1	FullDelay	0.0208856	20885.6	1	1\n"));
 }
 
+BOOST_AUTO_TEST_CASE(InstallAllHistograms)
+{
+  // period is longer than the simulation, so histograms are written only by Destroy
+  AppDelayTracer::InstallAllHistograms(TEST_TRACE.string(), Seconds(10));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	Prefix	Type	Count	P50	P90	P99	P99.9	Max\n"
+    "4	1	0	/prefix	FullDelay	1	0.041771	0.041771	0.041771	0.041771	0.041771\n"
+    "4	1	0	/prefix	LastDelay	1	0.041771	0.041771	0.041771	0.041771	0.041771\n"
+    "4	1	0	/prefix	RetxCount	1	1	1	1	1	1\n"
+    "4	1	0	/prefix	HopCount	1	2	2	2	2	2\n"
+    "4	2	0	/prefix	FullDelay	2	0	0.020885	0.020885	0.020885	0.020885\n"
+    "4	2	0	/prefix	LastDelay	2	0	0.020885	0.020885	0.020885	0.020885\n"
+    "4	2	0	/prefix	RetxCount	2	1	1	1	1	1\n"
+    "4	2	0	/prefix	HopCount	2	0	1	1	1	1\n");
+}
+
+BOOST_AUTO_TEST_CASE(InstallHistogramsPerPrefix)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+  nodes.Add(getNode("2"));
+
+  AppDelayTracer::InstallHistograms(nodes, TEST_TRACE.string(), Seconds(10),
+                                    AppDelayTracer::PER_PREFIX);
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  // 20.885 ms is reported as the highest value of its bucket
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	Prefix	Type	Count	P50	P90	P99	P99.9	Max\n"
+    "4	all	-1	/prefix	FullDelay	3	0.020991	0.041771	0.041771	0.041771	0.041771\n"
+    "4	all	-1	/prefix	LastDelay	3	0.020991	0.041771	0.041771	0.041771	0.041771\n"
+    "4	all	-1	/prefix	RetxCount	3	1	1	1	1	1\n"
+    "4	all	-1	/prefix	HopCount	3	1	2	2	2	2\n");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-cs-tracer.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class CsTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  CsTracerFixture()
+  {
+    getStackHelper().setCsSize(5);
+  }
+
+  void
+  createScenario()
+  {
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "0.95s"}, // requests /prefix/0 ... /prefix/9
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"StartSeq", "5"}},
+            "1s", "1.45s"}, // requests /prefix/5 ... /prefix/9 again
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  void
+  createAggregationScenario()
+  {
+    createTopology({
+        {"1", "2"},
+        {"3", "2"},
+        {"2", "4"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"3", "2", "/prefix", 1},
+        {"2", "4", "/prefix", 1},
+      });
+
+    // both consumers request /prefix/0 ... /prefix/4 at the same time, so node 2 aggregates
+    // the Interests of one consumer into the PIT entries of the other
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "1s", "1.45s"},
+        {"3", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "1s", "1.45s"},
+        {"4", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~CsTracerFixture()
+  {
+    CsTracer::Destroy(); // additional cleanup
+  }
+
+  double
+  getValue(const std::string& output, const std::string& time, const std::string& type,
+           const std::string& node = "1")
+  {
+    std::istringstream is(output);
+    for (std::string line; std::getline(is, line);) {
+      std::string prefix = time + "\t" + node + "\t" + type + "\t";
+      if (line.compare(0, prefix.size(), prefix) == 0) {
+        return boost::lexical_cast<double>(line.substr(prefix.size()));
+      }
+    }
+    BOOST_ERROR("No " << type << " row at " << time);
+    return -1;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnCsTracer, CsTracerFixture)
+
+BOOST_AUTO_TEST_CASE(NfdContentStore)
+{
+  createScenario();
+  auto output = make_shared<std::ostringstream>();
+  Ptr<CsTracer> tracer = CsTracer::Install(getNode("1"), output, Seconds(1));
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+
+  // management commands at the start of the simulation may add to the first period
+  BOOST_CHECK_EQUAL(getValue(output->str(), "1", "CacheHits"), 0);
+  BOOST_CHECK_GE(getValue(output->str(), "1", "CacheMisses"), 10);
+  BOOST_CHECK_GE(getValue(output->str(), "1", "CacheInserts"), 10);
+  BOOST_CHECK_GE(getValue(output->str(), "1", "CacheEvictions"), 5);
+
+  // the last five Data packets are still in the content store
+  BOOST_CHECK_EQUAL(getValue(output->str(), "2", "CacheHits"), 5);
+  BOOST_CHECK_EQUAL(getValue(output->str(), "2", "CacheMisses"), 0);
+  BOOST_CHECK_EQUAL(getValue(output->str(), "2", "CacheInserts"), 0);
+  BOOST_CHECK_EQUAL(getValue(output->str(), "2", "CacheEvictions"), 0);
+}
+
+BOOST_AUTO_TEST_CASE(NfdContentStoreAggregation)
+{
+  createAggregationScenario();
+
+  auto output = make_shared<std::ostringstream>();
+  Ptr<CsTracer> tracer = CsTracer::Install(getNode("2"), output, Seconds(1));
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+
+  // the CS is looked up only for the first Interest of each name, aggregated ones are not misses
+  BOOST_CHECK_EQUAL(getValue(output->str(), "2", "CacheHits", "2"), 0);
+  BOOST_CHECK_EQUAL(getValue(output->str(), "2", "CacheMisses", "2"), 5);
+  BOOST_CHECK_EQUAL(getValue(output->str(), "2", "CacheInserts", "2"), 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
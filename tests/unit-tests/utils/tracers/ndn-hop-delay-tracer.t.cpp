@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-hop-delay-tracer.hpp"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+#include <set>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+
+class HopDelayTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  HopDelayTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    // setting default parameters for PointToPoint links and channels
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"2", "3", "/prefix", 1}
+      });
+  }
+
+  ~HopDelayTracerFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+    HopDelayTracer::Destroy(); // additional cleanup
+  }
+
+  std::vector<std::vector<std::string>>
+  readTrace()
+  {
+    std::vector<std::vector<std::string>> rows;
+    std::ifstream is(TEST_TRACE.string());
+    for (std::string line; std::getline(is, line);) {
+      rows.push_back({});
+      boost::split(rows.back(), line, boost::is_any_of("\t"));
+    }
+    return rows;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnHopDelayTracer, HopDelayTracerFixture)
+
+BOOST_AUTO_TEST_CASE(Decomposition)
+{
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+          "0s", "0.9s"}, // send just one packet
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  HopDelayTracer::InstallAll(TEST_TRACE.string());
+
+  Simulator::Stop(Seconds(1.0));
+  Simulator::Run();
+
+  HopDelayTracer::Destroy(); // to force log to be written
+
+  auto rows = readTrace();
+  BOOST_REQUIRE_EQUAL(rows.size(), 5u);
+  BOOST_CHECK_EQUAL(boost::join(rows[0], " "),
+                    "Time Node PathId Hop HopNode FaceId Type Residence Queueing Transmission "
+                    "Propagation");
+
+  const char* hopNodes[] = {"1", "2", "3", "2"};
+  const char* types[] = {"Interest", "Interest", "Data", "Data"};
+  for (size_t hop = 0; hop < 4; hop++) {
+    const auto& row = rows[hop + 1];
+    BOOST_REQUIRE_EQUAL(row.size(), 11u);
+    BOOST_CHECK_EQUAL(row[1], "1");
+    BOOST_CHECK_EQUAL(row[2], "1");
+    BOOST_CHECK_EQUAL(row[3], boost::lexical_cast<std::string>(hop));
+    BOOST_CHECK_EQUAL(row[4], hopNodes[hop]);
+    BOOST_CHECK_EQUAL(row[6], types[hop]);
+
+    // forwarding does not take time in the simulation, and the links are idle
+    if (hop != 2) {
+      BOOST_CHECK_EQUAL(boost::lexical_cast<double>(row[7]), 0);
+    }
+    BOOST_CHECK_EQUAL(boost::lexical_cast<double>(row[8]), 0);
+    BOOST_CHECK_GT(boost::lexical_cast<double>(row[9]), 0);
+    BOOST_CHECK_CLOSE(boost::lexical_cast<double>(row[10]), 0.01, 0.1);
+  }
+
+  // Data packets are larger than Interests
+  BOOST_CHECK_GT(boost::lexical_cast<double>(rows[3][9]), 1024 * 8 / 10e6);
+  BOOST_CHECK_LT(boost::lexical_cast<double>(rows[1][9]), boost::lexical_cast<double>(rows[3][9]));
+}
+
+BOOST_AUTO_TEST_CASE(Sampling)
+{
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "0.95s"}, // 10 Interests
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  HopDelayTracer::InstallAll(TEST_TRACE.string(), TraceSink::TEXT, TraceFilter().SetSampling(5));
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+
+  HopDelayTracer::Destroy(); // to force log to be written
+
+  auto rows = readTrace();
+  BOOST_REQUIRE_EQUAL(rows.size(), 1 + 2 * 4u);
+
+  std::set<std::string> paths;
+  for (size_t i = 1; i < rows.size(); i++) {
+    paths.insert(rows[i][2]);
+  }
+  BOOST_CHECK_EQUAL(paths.size(), 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
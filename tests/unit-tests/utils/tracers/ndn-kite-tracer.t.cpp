@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-kite-tracer.hpp"
+#include "apps/kite-pull-mobile.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <map>
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class KiteTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  KiteTracerFixture()
+    : os(make_shared<std::ostringstream>())
+  {
+    createTopology({
+        {"1", "2"},
+        {"2", "3"},
+      });
+
+    addRoutes({
+        {"1", "2", "/rv", 1},
+        {"3", "2", "/rv", 1},
+        {"2", "3", "/rv/alice/photo", 1}, // instead of the trace towards the mobile
+      });
+
+    addApps({
+        {"2", "ns3::ndn::KiteRv",
+            {{"RvPrefix", "/rv"}},
+            "0s", "100s"},
+        {"3", "ns3::ndn::KitePullMobile",
+            {{"Prefix", "/rv/alice/photo"}, {"RvPrefix", "/rv"}, {"DataPrefix", "/alice/photo"},
+             {"RefreshInterval", "0s"}},
+            "0s", "100s"},
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/rv/alice/photo"}, {"MaxSeq", "1"}},
+            "2s", "100s"}
+      });
+
+    auto sink = make_shared<TextTraceSink>(os);
+    sink->SetColumns(KiteTracer::GetColumns());
+    tracer = Create<KiteTracer>(sink);
+    for (const std::string& node : {"1", "2", "3"}) {
+      tracer->Connect(getNode(node));
+    }
+  }
+
+  // value of each Type in the rows written for the producer
+  std::map<std::string, double>
+  getHandoffRows()
+  {
+    std::map<std::string, double> rows;
+    std::istringstream is(os->str());
+    std::string line;
+    std::getline(is, line); // header
+    while (std::getline(is, line)) {
+      std::istringstream row(line);
+      std::string time, node, producer, type, value;
+      row >> time >> node >> producer >> type >> value;
+      BOOST_CHECK_EQUAL(node, boost::lexical_cast<std::string>(getNode("3")->GetId()));
+      BOOST_CHECK_EQUAL(producer, "/alice/photo");
+      rows[type] = boost::lexical_cast<double>(value);
+    }
+    return rows;
+  }
+
+public:
+  shared_ptr<std::ostringstream> os;
+  Ptr<KiteTracer> tracer;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnKiteTracer, KiteTracerFixture)
+
+BOOST_AUTO_TEST_CASE(Handoff)
+{
+  Ptr<KitePullMobile> mobile = DynamicCast<KitePullMobile>(getNode("3")->GetApplication(0));
+  BOOST_REQUIRE(mobile != nullptr);
+
+  // association, as done by KiteHelper on Wi-Fi association
+  Simulator::Schedule(Seconds(1.0), &KitePullMobile::OnAssociation, mobile);
+
+  Simulator::Stop(Seconds(5.0));
+  Simulator::Run();
+
+  std::map<std::string, double> rows = getHandoffRows();
+  BOOST_REQUIRE_EQUAL(rows.size(), 3); // nothing has been queued by RV
+
+  BOOST_CHECK_CLOSE(rows["HandoffTraceSent"], 0.01, 0.001);
+  BOOST_CHECK_GT(rows["HandoffTraceConfirmed"], rows["HandoffTraceSent"]);
+  BOOST_CHECK_LT(rows["HandoffTraceConfirmed"], 1.0);
+  // consumer starts 1s after the association
+  BOOST_CHECK_GT(rows["HandoffFirstData"], 1.0);
+  BOOST_CHECK_LT(rows["HandoffFirstData"], 2.0);
+}
+
+BOOST_AUTO_TEST_CASE(NoHandoff)
+{
+  // Data without an association is not a handoff
+  Simulator::Stop(Seconds(5.0));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getHandoffRows().size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
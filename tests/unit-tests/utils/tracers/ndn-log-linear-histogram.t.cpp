@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-log-linear-histogram.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnLogLinearHistogram, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  LogLinearHistogram histogram(16);
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetMax(), 0);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(50), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SmallValuesExact)
+{
+  LogLinearHistogram histogram(8);
+  for (uint64_t value = 1; value <= 10; value++) {
+    histogram.Record(value);
+  }
+
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 10);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(0), 1);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(50), 5);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(90), 9);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(99), 10);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(100), 10);
+}
+
+BOOST_AUTO_TEST_CASE(RelativeError)
+{
+  LogLinearHistogram histogram(32);
+  for (uint64_t value = 1; value < 4000000000; value = value * 3 / 2 + 1) {
+    histogram.Reset();
+    histogram.Record(value);
+    histogram.Record(value + 1); // max, so that the percentile is not capped by it
+
+    uint64_t reported = histogram.GetPercentile(50);
+    BOOST_CHECK_GE(reported, value);
+    BOOST_CHECK_LE(reported - value, value / 32);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Percentiles)
+{
+  LogLinearHistogram histogram(32);
+  for (uint64_t value = 1; value <= 1000; value++) {
+    histogram.Record(value * 1000);
+  }
+
+  BOOST_CHECK_EQUAL(histogram.GetCount(), 1000);
+  BOOST_CHECK_EQUAL(histogram.GetMax(), 1000000);
+
+  uint64_t p50 = histogram.GetPercentile(50);
+  BOOST_CHECK_GE(p50, 500000);
+  BOOST_CHECK_LE(p50, 500000 + 500000 / 32);
+
+  uint64_t p999 = histogram.GetPercentile(99.9);
+  BOOST_CHECK_GE(p999, 999000);
+  BOOST_CHECK_LE(p999, 1000000);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(100), 1000000);
+}
+
+BOOST_AUTO_TEST_CASE(OutOfRange)
+{
+  LogLinearHistogram histogram(8);
+  histogram.Record(100);
+  histogram.Record(100000);
+
+  BOOST_CHECK_EQUAL(histogram.GetMax(), 100000);
+  BOOST_CHECK_EQUAL(histogram.GetPercentile(100), 100000);
+  BOOST_CHECK_LE(histogram.GetPercentile(50), 103);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
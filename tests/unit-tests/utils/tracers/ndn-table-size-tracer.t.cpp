@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-table-size-tracer.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-link-control-helper.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/output_test_stream.hpp>
+
+#include <fstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+
+class TableSizeTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  TableSizeTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "0.9s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~TableSizeTracerFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+    TableSizeTracer::Destroy(); // additional cleanup
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTableSizeTracer, TableSizeTracerFixture)
+
+BOOST_AUTO_TEST_CASE(TableSizes)
+{
+  TableSizeTracer::TableSizes sizes;
+  Simulator::Schedule(Seconds(0.95), [&] { sizes = TableSizeTracer::GetTableSizes(getNode("1")); });
+
+  Simulator::Stop(Seconds(1.0));
+  Simulator::Run();
+
+  BOOST_CHECK_GE(sizes[TableSizeTracer::FIB].entries, 1);
+  BOOST_CHECK_GT(sizes[TableSizeTracer::CS].entries, 0);
+  BOOST_CHECK_GT(sizes[TableSizeTracer::CS].bytes, sizes[TableSizeTracer::CS].entries * 1024);
+  BOOST_CHECK_EQUAL(sizes[TableSizeTracer::CONTENT_STORE].entries, 0);
+  BOOST_CHECK_EQUAL(sizes[TableSizeTracer::TRACE_ENTRIES].entries, 0);
+
+  uint64_t entries = 0, bytes = 0;
+  for (int table = 0; table < TableSizeTracer::TOTAL; table++) {
+    entries += sizes[table].entries;
+    bytes += sizes[table].bytes;
+  }
+  BOOST_CHECK_EQUAL(sizes[TableSizeTracer::TOTAL].entries, entries);
+  BOOST_CHECK_EQUAL(sizes[TableSizeTracer::TOTAL].bytes, bytes);
+}
+
+BOOST_AUTO_TEST_CASE(TraceEntries)
+{
+  // trace Interest stays in the PIT of node 1 until it expires
+  FibHelper::AddRoute(getNode("1"), "/rv", getNode("2"), 1);
+  LinkControlHelper::FailLink(getNode("1"), getNode("2"));
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/rv/trace/alice"}, {"Frequency", "1"}, {"LifeTime", "1.5s"}},
+          "0s", "0.9s"} // send just one trace Interest
+    });
+
+  TableSizeTracer::TableSizes sizes;
+  Simulator::Schedule(Seconds(0.5), [&] { sizes = TableSizeTracer::GetTableSizes(getNode("1")); });
+
+  Simulator::Stop(Seconds(1.0));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(sizes[TableSizeTracer::TRACE_ENTRIES].entries, 1);
+  BOOST_CHECK_GT(sizes[TableSizeTracer::TRACE_ENTRIES].bytes, 0);
+  BOOST_CHECK_GE(sizes[TableSizeTracer::PIT].entries,
+                 sizes[TableSizeTracer::TRACE_ENTRIES].entries);
+
+  // the trace Interest is counted in the PIT, but not once more in the total
+  uint64_t entries = 0, bytes = 0;
+  for (int table = 0; table < TableSizeTracer::TOTAL; table++) {
+    entries += sizes[table].entries;
+    bytes += sizes[table].bytes;
+  }
+  BOOST_CHECK_EQUAL(sizes[TableSizeTracer::TOTAL].entries, entries);
+  BOOST_CHECK_EQUAL(sizes[TableSizeTracer::TOTAL].bytes, bytes);
+}
+
+BOOST_AUTO_TEST_CASE(TopK)
+{
+  TableSizeTracer::InstallAll(TEST_TRACE.string(), Seconds(1), 1);
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  TableSizeTracer::Destroy(); // to force log to be written
+
+  std::ifstream is(TEST_TRACE.string());
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(is, line);) {
+    lines.push_back(line);
+  }
+
+  // header, tables of all nodes, tables of the top node, and RSS of the process
+  BOOST_REQUIRE_EQUAL(lines.size(), 1 + 2 * static_cast<size_t>(TableSizeTracer::N_TABLES) + 2);
+  BOOST_CHECK_EQUAL(lines[0], "Time	Node	Table	Entries	Bytes");
+  BOOST_CHECK_EQUAL(lines[1].substr(0, 10), "1	all	Pit	");
+  BOOST_CHECK_EQUAL(lines[1 + TableSizeTracer::TOTAL].substr(0, 12), "1	all	Total	");
+  BOOST_CHECK_EQUAL(lines[1 + TableSizeTracer::TRACE_ENTRIES].substr(0, 19), "1	all	TraceEntries	");
+
+  // only one of the nodes, whichever has larger tables
+  std::string topNode = lines[1 + TableSizeTracer::N_TABLES].substr(0, 4);
+  BOOST_CHECK(topNode == "1	1	" || topNode == "1	2	");
+  for (int table = 1; table < TableSizeTracer::N_TABLES; table++) {
+    BOOST_CHECK_EQUAL(lines[1 + TableSizeTracer::N_TABLES + table].substr(0, 4), topNode);
+  }
+
+  BOOST_CHECK_EQUAL(lines[1 + 2 * TableSizeTracer::N_TABLES].substr(0, 14), "1	process	Rss	");
+  BOOST_CHECK_EQUAL(lines[2 + 2 * TableSizeTracer::N_TABLES].substr(0, 18), "1	process	PeakRss	");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
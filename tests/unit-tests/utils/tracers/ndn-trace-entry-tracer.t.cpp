@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-trace-entry-tracer.hpp"
+#include "helper/ndn-link-control-helper.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/output_test_stream.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+
+class TraceEntryTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  TraceEntryTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/rv", 1},
+      });
+
+    // trace Interest is neither answered nor Nacked, and stays in the PIT until it expires
+    LinkControlHelper::FailLink(getNode("1"), getNode("2"));
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/rv/trace/alice"}, {"Frequency", "1"}, {"LifeTime", "1.5s"}},
+            "0s", "0.9s"} // send just one trace Interest
+      });
+  }
+
+  ~TraceEntryTracerFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+    TraceEntryTracer::Destroy(); // additional cleanup
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTraceEntryTracer, TraceEntryTracerFixture)
+
+BOOST_AUTO_TEST_CASE(EntryLifecycle)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+
+  TraceEntryTracer::Install(nodes, TEST_TRACE.string(), Seconds(1));
+
+  Ptr<L3Protocol> l3 = getNode("1")->GetObject<L3Protocol>();
+  L3Protocol::TraceEntryCounters active, expired;
+  size_t pitTraces = 0;
+  Simulator::Schedule(Seconds(1.2), [&] {
+      active = l3->getTraceEntryCounters();
+      for (const nfd::pit::Entry& entry : l3->getForwarder()->getPit()) {
+        if (entry.getName().getPrefix(3) == "/rv/trace/alice") {
+          pitTraces++;
+        }
+      }
+    });
+  Simulator::Schedule(Seconds(1.8), [&] { expired = l3->getTraceEntryCounters(); });
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  // counted from the PIT
+  BOOST_CHECK_EQUAL(pitTraces, 1);
+  BOOST_CHECK_EQUAL(active.entries, pitTraces);
+  BOOST_CHECK_EQUAL(active.created, 1);
+  BOOST_CHECK_GT(active.bytes, 0);
+  BOOST_CHECK_EQUAL(active.expired, 0);
+
+  BOOST_CHECK_EQUAL(expired.entries, 0);
+  BOOST_CHECK_EQUAL(expired.bytes, 0);
+  BOOST_CHECK_EQUAL(expired.created, 1);
+  BOOST_CHECK_EQUAL(expired.satisfied, 0);
+  BOOST_CHECK_EQUAL(expired.expired, 1);
+  BOOST_CHECK_EQUAL(expired.lifespan, Seconds(1.5));
+
+  TraceEntryTracer::Destroy(); // to force log to be written
+
+  boost::test_tools::output_test_stream os(TEST_TRACE.string().c_str(), true);
+
+  os << "Time	Node	Type	Value\n";
+  BOOST_CHECK(os.match_pattern());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-trace-filter.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTraceFilter, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(AcceptAll)
+{
+  TraceFilter filter;
+  BOOST_CHECK(filter.IsAcceptingAll());
+  BOOST_CHECK_EQUAL(filter.GetWeight(), 1);
+  BOOST_CHECK(filter.AcceptName(Name("/any/name")));
+  BOOST_CHECK(filter.AcceptFace(257));
+  BOOST_CHECK(filter.Sample(0));
+  BOOST_CHECK(filter.Sample(0));
+}
+
+BOOST_AUTO_TEST_CASE(Sampling)
+{
+  TraceFilter filter;
+  filter.SetSampling(3);
+  BOOST_CHECK(!filter.IsAcceptingAll());
+  BOOST_CHECK_EQUAL(filter.GetWeight(), 3);
+
+  std::vector<bool> sampled;
+  for (int i = 0; i < 6; i++) {
+    sampled.push_back(filter.Sample(0));
+  }
+  BOOST_CHECK((sampled == std::vector<bool>{false, false, true, false, false, true}));
+
+  // other kinds of events have their own counters
+  BOOST_CHECK(!filter.Sample(1));
+  BOOST_CHECK(!filter.Sample(1));
+  BOOST_CHECK(filter.Sample(1));
+}
+
+BOOST_AUTO_TEST_CASE(Prefixes)
+{
+  TraceFilter filter;
+  filter.AddPrefix("/video/hd").AddPrefix("/audio");
+  BOOST_CHECK(!filter.IsAcceptingAll());
+
+  BOOST_CHECK(filter.AcceptName(Name("/video/hd")));
+  BOOST_CHECK(filter.AcceptName(Name("/video/hd/movie/%00%01")));
+  BOOST_CHECK(filter.AcceptName(Name("/audio/song")));
+  BOOST_CHECK(!filter.AcceptName(Name("/video")));
+  BOOST_CHECK(!filter.AcceptName(Name("/video/sd/movie")));
+  BOOST_CHECK(!filter.AcceptName(Name("/audiobook")));
+  BOOST_CHECK(!filter.AcceptName(Name("/")));
+
+  filter.AddPrefix("/");
+  BOOST_CHECK(filter.AcceptName(Name("/video")));
+}
+
+BOOST_AUTO_TEST_CASE(Faces)
+{
+  TraceFilter filter;
+  filter.AddFace(258).AddFace(256);
+
+  BOOST_CHECK(filter.AcceptFace(256));
+  BOOST_CHECK(filter.AcceptFace(258));
+  BOOST_CHECK(!filter.AcceptFace(257));
+  BOOST_CHECK(!filter.AcceptFace(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-trace-sink.hpp"
+
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTraceSink, CleanupFixture)
+
+static const TraceSink::Columns COLUMNS = {{"Time", TraceSink::DOUBLE},
+                                           {"Node", TraceSink::STRING},
+                                           {"FaceId", TraceSink::INTEGER},
+                                           {"Type", TraceSink::STRING},
+                                           {"Packets", TraceSink::DOUBLE}};
+
+static void
+WriteRows(TraceSink& sink)
+{
+  sink.SetColumns(COLUMNS);
+  for (int i = 0; i < 10; i++) {
+    sink.WriteRow(i * 0.5, std::to_string(i % 3), 256 + i, "InInterests", i / 3.0);
+    sink.WriteRow(i * 0.5, "all", -1, std::string("SatisfiedInterests"), 1e6 + i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Text)
+{
+  auto os = make_shared<std::ostringstream>();
+  {
+    TextTraceSink sink(os);
+    sink.SetColumns(COLUMNS);
+    sink.WriteRow(1.5, "1", 257, "InInterests", 2.4);
+    sink.WriteRow(2.0, "all", -1, "TimedOutInterests", 0.0);
+  }
+
+  BOOST_CHECK_EQUAL(os->str(), "Time	Node	FaceId	Type	Packets\n"
+                               "1.5	1	257	InInterests	2.4\n"
+                               "2	all	-1	TimedOutInterests	0\n");
+}
+
+BOOST_AUTO_TEST_CASE(BinaryToText)
+{
+  auto text = make_shared<std::ostringstream>();
+  auto binary = make_shared<std::stringstream>();
+  {
+    TextTraceSink textSink(text);
+    WriteRows(textSink);
+
+    BinaryTraceSink binarySink(binary, 7); // several blocks, the last one written on destruction
+    WriteRows(binarySink);
+  }
+
+  BinaryTraceReader reader(*binary);
+  BOOST_CHECK_EQUAL(reader.GetColumns().size(), COLUMNS.size());
+  BOOST_CHECK_EQUAL(reader.GetColumns()[2].name, "FaceId");
+  BOOST_CHECK_EQUAL(reader.GetColumns()[2].type, TraceSink::INTEGER);
+
+  std::ostringstream converted;
+  reader.ConvertToText(converted);
+  BOOST_CHECK_EQUAL(converted.str(), text->str());
+}
+
+BOOST_AUTO_TEST_CASE(MalformedBinary)
+{
+  std::istringstream text("Time	Node	Type	Packets\n");
+  BOOST_CHECK_THROW(BinaryTraceReader reader(text), BinaryTraceReader::Error);
+
+  auto binary = make_shared<std::stringstream>();
+  {
+    BinaryTraceSink sink(binary);
+    WriteRows(sink);
+  }
+  std::string truncated = binary->str();
+  truncated.resize(truncated.size() - 10);
+
+  std::istringstream is(truncated);
+  BinaryTraceReader reader(is);
+  std::ostringstream os;
+  BOOST_CHECK_THROW(reader.ConvertToText(os), BinaryTraceReader::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Async)
+{
+  auto text = make_shared<std::ostringstream>();
+  auto asyncText = make_shared<std::ostringstream>();
+  auto asyncBinary = make_shared<std::stringstream>();
+  {
+    TextTraceSink textSink(text);
+    WriteRows(textSink);
+
+    AsyncTraceSink asyncTextSink(make_shared<TextTraceSink>(asyncText));
+    WriteRows(asyncTextSink);
+
+    // ring of 8 records is smaller than a single row batch, so the writer has to catch up
+    AsyncTraceSink asyncBinarySink(make_shared<BinaryTraceSink>(asyncBinary, 7), 8);
+    WriteRows(asyncBinarySink);
+    BOOST_CHECK_GT(asyncBinarySink.GetStalls(), 0);
+  }
+
+  BOOST_CHECK_EQUAL(asyncText->str(), text->str());
+
+  BinaryTraceReader reader(*asyncBinary);
+  std::ostringstream converted;
+  reader.ConvertToText(converted);
+  BOOST_CHECK_EQUAL(converted.str(), text->str());
+}
+
+BOOST_AUTO_TEST_CASE(AsyncFlush)
+{
+  auto os = make_shared<std::ostringstream>();
+  AsyncTraceSink sink(make_shared<TextTraceSink>(os));
+  sink.SetColumns(COLUMNS);
+  sink.WriteRow(1.5, "1", 257, "InInterests", 2.4);
+  sink.Flush();
+
+  // written by the background thread, but visible once Flush returns
+  BOOST_CHECK_EQUAL(os->str(), "Time	Node	FaceId	Type	Packets\n"
+                               "1.5	1	257	InInterests	2.4\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
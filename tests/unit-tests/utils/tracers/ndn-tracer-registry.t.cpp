@@ -0,0 +1,177 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-tracer-registry.hpp"
+#include "utils/tracers/ndn-cs-tracer.hpp"
+#include "utils/tracers/ndn-l3-rate-tracer.hpp"
+
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class TracerRegistryFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  TracerRegistryFixture()
+  {
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "100s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~TracerRegistryFixture()
+  {
+    L3RateTracer::Destroy(); // additional cleanup
+    CsTracer::Destroy();
+    TracerRegistry::Get().Clear();
+  }
+
+  TracerRegistry::GroupId
+  addCounter(std::vector<Time>& prints, Time period)
+  {
+    auto sink = make_shared<TextTraceSink>(make_shared<std::ostringstream>());
+    return TracerRegistry::Get().Add("Counter", sink, make_shared<int>(0), period,
+                                     [&prints] (TraceSink&) {
+                                       prints.push_back(Simulator::Now());
+                                     });
+  }
+
+  static bool
+  hasRow(const std::string& output, const std::string& time)
+  {
+    return ("\n" + output).find("\n" + time + "\t") != std::string::npos;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTracerRegistry, TracerRegistryFixture)
+
+BOOST_AUTO_TEST_CASE(SharedEvent)
+{
+  TracerRegistry& registry = TracerRegistry::Get();
+
+  auto l3Output1 = make_shared<std::ostringstream>();
+  auto l3Output2 = make_shared<std::ostringstream>();
+  auto csOutput = make_shared<std::ostringstream>();
+  L3RateTracer::Install(getNode("1"), l3Output1, Seconds(1));
+  L3RateTracer::Install(getNode("2"), l3Output2, Seconds(1));
+  CsTracer::Install(getNode("2"), csOutput, Seconds(1));
+
+  BOOST_CHECK_EQUAL(registry.GetNGroups(), 3);
+  BOOST_CHECK_EQUAL(registry.GetNEvents(), 1);
+
+  auto halfOutput = make_shared<std::ostringstream>();
+  L3RateTracer::Install(getNode("1"), halfOutput, Seconds(0.5));
+  BOOST_CHECK_EQUAL(registry.GetNGroups(), 4);
+  BOOST_CHECK_EQUAL(registry.GetNEvents(), 2);
+
+  Simulator::Stop(Seconds(1.2));
+  Simulator::Run();
+
+  BOOST_CHECK(hasRow(l3Output1->str(), "1"));
+  BOOST_CHECK(hasRow(l3Output2->str(), "1"));
+  BOOST_CHECK(hasRow(csOutput->str(), "1"));
+  BOOST_CHECK(hasRow(halfOutput->str(), "0.5"));
+
+  L3RateTracer::Destroy();
+  BOOST_CHECK_EQUAL(registry.GetNGroups(), 1);
+  BOOST_CHECK_EQUAL(registry.GetNEvents(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(AddAndRemoveAtRunTime)
+{
+  TracerRegistry& registry = TracerRegistry::Get();
+
+  std::vector<Time> prints1;
+  std::vector<Time> prints2;
+  TracerRegistry::GroupId id1 = addCounter(prints1, Seconds(1));
+  TracerRegistry::GroupId id2 = 0;
+
+  // out of phase with the first group, so it gets its own event
+  Simulator::Schedule(Seconds(1.5), [&] { id2 = addCounter(prints2, Seconds(1)); });
+  Simulator::Schedule(Seconds(1.7), [&] {
+      BOOST_CHECK_EQUAL(registry.GetNGroups(), 2);
+      BOOST_CHECK_EQUAL(registry.GetNEvents(), 2);
+    });
+  Simulator::Schedule(Seconds(3.2), [&] { BOOST_CHECK(registry.Remove(id1)); });
+
+  Simulator::Stop(Seconds(4.8));
+  Simulator::Run();
+
+  BOOST_CHECK(prints1 == std::vector<Time>({Seconds(1), Seconds(2), Seconds(3)}));
+  BOOST_CHECK(prints2 == std::vector<Time>({Seconds(2.5), Seconds(3.5), Seconds(4.5)}));
+
+  BOOST_CHECK(!registry.Remove(id1));
+  BOOST_CHECK_EQUAL(registry.GetNGroups(), 1);
+  BOOST_CHECK_EQUAL(registry.GetNEvents(), 1);
+
+  BOOST_CHECK(registry.Remove(id2));
+  BOOST_CHECK_EQUAL(registry.GetNGroups(), 0);
+  BOOST_CHECK_EQUAL(registry.GetNEvents(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(RemoveFromPrinter)
+{
+  TracerRegistry& registry = TracerRegistry::Get();
+
+  auto tracers = make_shared<int>(0);
+  weak_ptr<int> weakTracers = tracers;
+
+  std::vector<Time> prints;
+  std::vector<Time> otherPrints;
+  TracerRegistry::GroupId id = 0;
+  auto sink = make_shared<TextTraceSink>(make_shared<std::ostringstream>());
+  id = registry.Add("Self", sink, tracers, Seconds(1), [&] (TraceSink&) {
+      prints.push_back(Simulator::Now());
+      if (prints.size() == 2) {
+        BOOST_CHECK(registry.Remove(id));
+      }
+    });
+  tracers.reset();
+  addCounter(otherPrints, Seconds(1));
+
+  Simulator::Stop(Seconds(3.5));
+  Simulator::Run();
+
+  BOOST_CHECK(prints == std::vector<Time>({Seconds(1), Seconds(2)}));
+  BOOST_CHECK_EQUAL(otherPrints.size(), 3);
+  BOOST_CHECK(weakTracers.expired());
+  BOOST_CHECK_EQUAL(registry.GetNGroups(), 1);
+  BOOST_CHECK_EQUAL(registry.GetNEvents(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -20,11 +20,13 @@
 #ifndef MEM_USAGE_H
 #define MEM_USAGE_H
 
+#include <fstream>
+
 #ifdef __linux__
 // #include <proc/readproc.h>
-// #include <unistd.h>
-// // #include <sys/resource.h>
+#include <unistd.h>
 #include <sys/sysinfo.h>
+#include <sys/resource.h>
 #endif
 
 #ifdef __APPLE__
@@ -35,6 +37,7 @@
 #include <err.h>
 #include <sys/param.h>
 #include <mach-o/ldsyms.h>
+#include <sys/resource.h>
 #endif
 
 /**
@@ -90,6 +93,28 @@ public:
     }
 
     return t_info.resident_size;
+#endif
+    // other systems are not yet supported
+    return -1;
+  }
+
+  /**
+   * @brief Get peak memory utilization (maximum resident set size) in bytes
+   */
+  static inline int64_t
+  GetPeak()
+  {
+#if defined(__linux__) || defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+      return -1;
+    }
+
+#if defined(__linux__)
+    return static_cast<int64_t>(usage.ru_maxrss) * 1024; // in kilobytes on Linux
+#else
+    return static_cast<int64_t>(usage.ru_maxrss); // in bytes on macOS
+#endif
 #endif
     // other systems are not yet supported
     return -1;
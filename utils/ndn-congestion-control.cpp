@@ -0,0 +1,381 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-congestion-control.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CongestionControl");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(CongestionControl);
+NS_OBJECT_ENSURE_REGISTERED(CongestionControlAimd);
+NS_OBJECT_ENSURE_REGISTERED(CongestionControlCubic);
+NS_OBJECT_ENSURE_REGISTERED(CongestionControlBbr);
+
+//---------------------------------------------------------------------------------
+
+TypeId
+CongestionControl::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::CongestionControl")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+
+      .AddAttribute("InitialWindow", "Initial congestion window, in Interests", DoubleValue(2.0),
+                    MakeDoubleAccessor(&CongestionControl::m_initialWindow),
+                    MakeDoubleChecker<double>(1.0))
+
+      .AddAttribute("InitialSsthresh", "Initial slow start threshold, in Interests",
+                    DoubleValue(std::numeric_limits<double>::max()),
+                    MakeDoubleAccessor(&CongestionControl::m_initialSsthresh),
+                    MakeDoubleChecker<double>())
+
+      .AddAttribute("MinWindow", "Minimum congestion window, in Interests", DoubleValue(1.0),
+                    MakeDoubleAccessor(&CongestionControl::m_minWindow),
+                    MakeDoubleChecker<double>(1.0));
+  return tid;
+}
+
+CongestionControl::CongestionControl()
+  : m_initialWindow(2.0)
+  , m_initialSsthresh(std::numeric_limits<double>::max())
+  , m_minWindow(1.0)
+  , m_cwnd(m_initialWindow)
+  , m_ssthresh(m_initialSsthresh)
+{
+}
+
+void
+CongestionControl::Reset()
+{
+  m_cwnd = m_initialWindow;
+  m_ssthresh = m_initialSsthresh;
+}
+
+void
+CongestionControl::OnTimeout()
+{
+  OnCongestion();
+}
+
+double
+CongestionControl::GetPacingRate() const
+{
+  return 0.0;
+}
+
+//---------------------------------------------------------------------------------
+
+TypeId
+CongestionControlAimd::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::CongestionControlAimd")
+      .SetGroupName("Ndn")
+      .SetParent<CongestionControl>()
+      .AddConstructor<CongestionControlAimd>()
+
+      .AddAttribute("AdditiveIncrease", "Window increase per RTT in congestion avoidance",
+                    DoubleValue(1.0),
+                    MakeDoubleAccessor(&CongestionControlAimd::m_additiveIncrease),
+                    MakeDoubleChecker<double>(0.0))
+
+      .AddAttribute("Beta", "Multiplicative decrease factor", DoubleValue(0.5),
+                    MakeDoubleAccessor(&CongestionControlAimd::m_beta),
+                    MakeDoubleChecker<double>(0.0, 1.0));
+  return tid;
+}
+
+CongestionControlAimd::CongestionControlAimd()
+  : m_additiveIncrease(1.0)
+  , m_beta(0.5)
+{
+}
+
+void
+CongestionControlAimd::OnData(Time sample, Time srtt, uint32_t inFlight)
+{
+  if (m_cwnd < m_ssthresh) {
+    m_cwnd += 1.0; // slow start
+  }
+  else {
+    m_cwnd += m_additiveIncrease / m_cwnd;
+  }
+}
+
+void
+CongestionControlAimd::OnCongestion()
+{
+  m_ssthresh = std::max(m_minWindow, m_cwnd * m_beta);
+  m_cwnd = m_ssthresh;
+  NS_LOG_DEBUG("Window decreased to " << m_cwnd);
+}
+
+//---------------------------------------------------------------------------------
+
+TypeId
+CongestionControlCubic::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::CongestionControlCubic")
+      .SetGroupName("Ndn")
+      .SetParent<CongestionControl>()
+      .AddConstructor<CongestionControlCubic>()
+
+      .AddAttribute("C", "CUBIC scaling constant", DoubleValue(0.4),
+                    MakeDoubleAccessor(&CongestionControlCubic::m_c),
+                    MakeDoubleChecker<double>(0.0))
+
+      .AddAttribute("Beta", "Multiplicative decrease factor", DoubleValue(0.7),
+                    MakeDoubleAccessor(&CongestionControlCubic::m_beta),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+
+      .AddAttribute("FastConvergence", "Release bandwidth faster when window keeps decreasing",
+                    BooleanValue(true),
+                    MakeBooleanAccessor(&CongestionControlCubic::m_fastConvergence),
+                    MakeBooleanChecker());
+  return tid;
+}
+
+CongestionControlCubic::CongestionControlCubic()
+  : m_c(0.4)
+  , m_beta(0.7)
+  , m_fastConvergence(true)
+  , m_wMax(0.0)
+  , m_epochStart(Seconds(-1))
+{
+}
+
+void
+CongestionControlCubic::Reset()
+{
+  CongestionControl::Reset();
+  m_wMax = 0.0;
+  m_epochStart = Seconds(-1);
+}
+
+void
+CongestionControlCubic::OnData(Time sample, Time srtt, uint32_t inFlight)
+{
+  if (m_cwnd < m_ssthresh) {
+    m_cwnd += 1.0; // slow start
+    return;
+  }
+
+  Time now = Simulator::Now();
+  if (m_epochStart.IsNegative()) {
+    // congestion avoidance without a preceding reduction
+    m_epochStart = now;
+    m_wMax = m_cwnd;
+  }
+
+  double t = (now - m_epochStart).ToDouble(Time::S);
+  double k = std::cbrt(m_wMax * (1 - m_beta) / m_c);
+  double target = m_c * std::pow(t - k, 3) + m_wMax;
+
+  Time rtt = srtt.IsZero() ? sample : srtt;
+  if (rtt.IsStrictlyPositive()) {
+    // TCP-friendly region
+    double wEst = m_wMax * m_beta + 3 * (1 - m_beta) / (1 + m_beta) * t / rtt.ToDouble(Time::S);
+    target = std::max(target, wEst);
+  }
+  target = std::min(target, 1.5 * m_cwnd);
+
+  if (target > m_cwnd) {
+    m_cwnd += (target - m_cwnd) / m_cwnd;
+  }
+  else {
+    m_cwnd += 0.01 / m_cwnd;
+  }
+}
+
+void
+CongestionControlCubic::OnCongestion()
+{
+  if (m_fastConvergence && m_cwnd < m_wMax) {
+    m_wMax = m_cwnd * (1 + m_beta) / 2;
+  }
+  else {
+    m_wMax = m_cwnd;
+  }
+
+  m_cwnd = std::max(m_minWindow, m_cwnd * m_beta);
+  m_ssthresh = m_cwnd;
+  m_epochStart = Simulator::Now();
+  NS_LOG_DEBUG("Window decreased to " << m_cwnd << ", Wmax " << m_wMax);
+}
+
+//---------------------------------------------------------------------------------
+
+static const double BBR_HIGH_GAIN = 2.885; // 2/ln(2)
+static const double BBR_PROBE_GAINS[] = {1.25, 0.75, 1, 1, 1, 1, 1, 1};
+static const size_t BBR_N_PROBE_GAINS = sizeof(BBR_PROBE_GAINS) / sizeof(BBR_PROBE_GAINS[0]);
+
+TypeId
+CongestionControlBbr::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::CongestionControlBbr")
+      .SetGroupName("Ndn")
+      .SetParent<CongestionControl>()
+      .AddConstructor<CongestionControlBbr>()
+
+      .AddAttribute("BandwidthFilterLength",
+                    "Number of rounds over which the maximum delivery rate is taken",
+                    UintegerValue(10),
+                    MakeUintegerAccessor(&CongestionControlBbr::m_bwFilterLength),
+                    MakeUintegerChecker<uint32_t>(1))
+
+      .AddAttribute("MinRttWindow", "Interval after which the minimum RTT estimate expires",
+                    TimeValue(Seconds(10)), MakeTimeAccessor(&CongestionControlBbr::m_minRttWindow),
+                    MakeTimeChecker());
+  return tid;
+}
+
+CongestionControlBbr::CongestionControlBbr()
+  : m_bwFilterLength(10)
+  , m_minRttWindow(Seconds(10))
+{
+  Reset();
+}
+
+void
+CongestionControlBbr::Reset()
+{
+  CongestionControl::Reset();
+
+  m_state = STARTUP;
+  m_pacingGain = BBR_HIGH_GAIN;
+  m_cwndGain = BBR_HIGH_GAIN;
+  m_cycleIndex = 0;
+
+  m_bwSamples.clear();
+  m_btlBw = 0.0;
+  m_minRtt = Seconds(0);
+  m_minRttStamp = Seconds(0);
+
+  m_roundStart = Simulator::Now();
+  m_roundDelivered = 0;
+  m_fullBw = 0.0;
+  m_fullBwRounds = 0;
+}
+
+void
+CongestionControlBbr::OnData(Time sample, Time srtt, uint32_t inFlight)
+{
+  Time now = Simulator::Now();
+  if (sample.IsStrictlyPositive()
+      && (m_minRtt.IsZero() || sample <= m_minRtt || now - m_minRttStamp > m_minRttWindow)) {
+    m_minRtt = sample;
+    m_minRttStamp = now;
+  }
+
+  m_roundDelivered++;
+  updateRound(srtt, inFlight);
+
+  if (m_btlBw > 0) {
+    m_cwnd = std::max(m_initialWindow, m_cwndGain * getBdp());
+  }
+  else {
+    m_cwnd += 1.0; // no bandwidth estimate yet, grow as in slow start
+  }
+}
+
+void
+CongestionControlBbr::updateRound(Time srtt, uint32_t inFlight)
+{
+  Time roundLength = srtt.IsZero() ? m_minRtt : srtt;
+  Time now = Simulator::Now();
+  if (roundLength.IsZero() || now - m_roundStart < roundLength)
+    return;
+
+  m_bwSamples.push_back(m_roundDelivered / (now - m_roundStart).ToDouble(Time::S));
+  if (m_bwSamples.size() > m_bwFilterLength) {
+    m_bwSamples.pop_front();
+  }
+  m_btlBw = *std::max_element(m_bwSamples.begin(), m_bwSamples.end());
+
+  m_roundStart = now;
+  m_roundDelivered = 0;
+
+  switch (m_state) {
+  case STARTUP:
+    if (m_btlBw >= m_fullBw * 1.25) {
+      m_fullBw = m_btlBw;
+      m_fullBwRounds = 0;
+    }
+    else if (++m_fullBwRounds >= 3) {
+      NS_LOG_DEBUG("Bandwidth plateau at " << m_btlBw << " Interests/s, draining the queue");
+      m_state = DRAIN;
+      m_pacingGain = 1 / BBR_HIGH_GAIN;
+    }
+    break;
+  case DRAIN:
+    if (inFlight <= getBdp()) {
+      m_state = PROBE_BW;
+      m_cycleIndex = 0;
+      m_pacingGain = BBR_PROBE_GAINS[m_cycleIndex];
+      m_cwndGain = 2.0;
+    }
+    break;
+  case PROBE_BW:
+    m_cycleIndex = (m_cycleIndex + 1) % BBR_N_PROBE_GAINS;
+    m_pacingGain = BBR_PROBE_GAINS[m_cycleIndex];
+    break;
+  }
+}
+
+double
+CongestionControlBbr::getBdp() const
+{
+  return m_btlBw * m_minRtt.ToDouble(Time::S);
+}
+
+void
+CongestionControlBbr::OnCongestion()
+{
+  // rate is driven by the bandwidth and RTT estimates, not by congestion signals
+}
+
+void
+CongestionControlBbr::OnTimeout()
+{
+  m_cwnd = m_minWindow;
+}
+
+double
+CongestionControlBbr::GetPacingRate() const
+{
+  return m_pacingGain * m_btlBw;
+}
+
+} // namespace ndn
+} // namespace ns3
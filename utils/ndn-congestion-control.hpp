@@ -0,0 +1,232 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONGESTION_CONTROL_H
+#define NDN_CONGESTION_CONTROL_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+
+#include <deque>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Base class for congestion controllers of pipelined consumers
+ *
+ * The controller maintains the congestion window (in Interests) and, optionally, the rate at
+ * which Interests should be paced.  All methods take constant time.
+ *
+ * \see ConsumerPipeline
+ */
+class CongestionControl : public Object {
+public:
+  static TypeId
+  GetTypeId();
+
+  CongestionControl();
+
+  /**
+   * \brief Reset the controller to its initial state
+   */
+  virtual void
+  Reset();
+
+  /**
+   * \brief Note that Data for an outstanding Interest has been received
+   * \param sample RTT sample of this Interest/Data exchange, zero if the Interest has been
+   *               retransmitted (Karn's rule)
+   * \param srtt smoothed RTT, zero if no samples has been taken yet
+   * \param inFlight number of outstanding Interests, after accounting for this Data
+   */
+  virtual void
+  OnData(Time sample, Time srtt, uint32_t inFlight) = 0;
+
+  /**
+   * \brief Note a congestion signal (e.g., Nack with Congestion reason)
+   */
+  virtual void
+  OnCongestion() = 0;
+
+  /**
+   * \brief Note a retransmission timeout
+   *
+   * By default, retransmission timeout is handled as a congestion signal.
+   */
+  virtual void
+  OnTimeout();
+
+  /**
+   * \brief Get congestion window, in Interests
+   */
+  double
+  GetWindow() const
+  {
+    return m_cwnd;
+  }
+
+  /**
+   * \brief Get slow start threshold, in Interests
+   */
+  double
+  GetSsthresh() const
+  {
+    return m_ssthresh;
+  }
+
+  /**
+   * \brief Get the rate at which Interests should be paced, in Interests per second
+   * \return 0 if sending is limited only by the congestion window
+   */
+  virtual double
+  GetPacingRate() const;
+
+protected:
+  double m_initialWindow;
+  double m_initialSsthresh;
+  double m_minWindow;
+
+  double m_cwnd;
+  double m_ssthresh;
+};
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Additive-increase/multiplicative-decrease congestion control with slow start
+ */
+class CongestionControlAimd : public CongestionControl {
+public:
+  static TypeId
+  GetTypeId();
+
+  CongestionControlAimd();
+
+  virtual void
+  OnData(Time sample, Time srtt, uint32_t inFlight);
+
+  virtual void
+  OnCongestion();
+
+private:
+  double m_additiveIncrease;
+  double m_beta;
+};
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief CUBIC congestion control (RFC 8312), including TCP-friendly region and fast
+ *        convergence
+ */
+class CongestionControlCubic : public CongestionControl {
+public:
+  static TypeId
+  GetTypeId();
+
+  CongestionControlCubic();
+
+  virtual void
+  Reset();
+
+  virtual void
+  OnData(Time sample, Time srtt, uint32_t inFlight);
+
+  virtual void
+  OnCongestion();
+
+private:
+  double m_c;
+  double m_beta;
+  bool m_fastConvergence;
+
+  double m_wMax;     ///< \brief window before the last reduction
+  Time m_epochStart; ///< \brief time of the last reduction, negative if none
+};
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Rate-based congestion control, modeled after BBR
+ *
+ * The controller estimates bottleneck bandwidth as the maximum Data delivery rate over the last
+ * few rounds (RTTs) and propagation delay as the minimum RTT sample, and paces Interests at
+ * the bandwidth estimate multiplied by the gain of the current state: startup, drain, or
+ * bandwidth probing (gain cycle 1.25, 0.75, 1, 1, 1, 1, 1, 1).  Congestion window is capped at
+ * twice the estimated bandwidth-delay product.  Congestion signals are ignored, while
+ * retransmission timeouts collapse the window to its minimum until new Data arrives.
+ */
+class CongestionControlBbr : public CongestionControl {
+public:
+  static TypeId
+  GetTypeId();
+
+  CongestionControlBbr();
+
+  virtual void
+  Reset();
+
+  virtual void
+  OnData(Time sample, Time srtt, uint32_t inFlight);
+
+  virtual void
+  OnCongestion();
+
+  virtual void
+  OnTimeout();
+
+  virtual double
+  GetPacingRate() const;
+
+private:
+  void
+  updateRound(Time srtt, uint32_t inFlight);
+
+  double
+  getBdp() const;
+
+private:
+  enum State { STARTUP, DRAIN, PROBE_BW };
+
+  uint32_t m_bwFilterLength;
+  Time m_minRttWindow;
+
+  State m_state;
+  double m_pacingGain;
+  double m_cwndGain;
+  size_t m_cycleIndex;
+
+  std::deque<double> m_bwSamples; ///< \brief delivery rate of the last rounds, Interests/s
+  double m_btlBw;
+  Time m_minRtt;
+  Time m_minRttStamp;
+
+  Time m_roundStart;
+  uint64_t m_roundDelivered;
+  double m_fullBw;
+  uint32_t m_fullBwRounds;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONGESTION_CONTROL_H
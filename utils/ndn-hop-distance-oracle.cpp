@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-hop-distance-oracle.hpp"
+
+#include "model/ndn-global-router.hpp"
+
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/channel.h"
+#include "ns3/net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <deque>
+
+NS_LOG_COMPONENT_DEFINE("ndn.HopDistanceOracle");
+
+namespace ns3 {
+namespace ndn {
+
+const uint32_t HopDistanceOracle::UNREACHABLE;
+
+HopDistanceOracle&
+HopDistanceOracle::get()
+{
+  static HopDistanceOracle instance;
+  return instance;
+}
+
+uint32_t
+HopDistanceOracle::getDistance(uint32_t from, uint32_t to)
+{
+  const std::vector<uint32_t>& row = getRow(from);
+  if (to >= row.size()) {
+    return UNREACHABLE;
+  }
+  return row[to];
+}
+
+uint32_t
+HopDistanceOracle::getDistance(Ptr<Node> from, Ptr<Node> to)
+{
+  return getDistance(from->GetId(), to->GetId());
+}
+
+void
+HopDistanceOracle::clear()
+{
+  m_rows.clear();
+  m_isCleanupScheduled = false;
+}
+
+static void
+ClearHopDistanceOracle()
+{
+  HopDistanceOracle::get().clear();
+}
+
+const std::vector<uint32_t>&
+HopDistanceOracle::getRow(uint32_t source)
+{
+  auto entry = m_rows.find(source);
+  if (entry != m_rows.end()) {
+    return entry->second;
+  }
+
+  if (!m_isCleanupScheduled) {
+    // nodes do not survive the simulator, neither should distances between them
+    Simulator::ScheduleDestroy(&ClearHopDistanceOracle);
+    m_isCleanupScheduled = true;
+  }
+
+  std::vector<uint32_t>& row = m_rows[source];
+  row.assign(NodeList::GetNNodes(), UNREACHABLE);
+  if (source >= row.size()) {
+    return row;
+  }
+
+  std::deque<uint32_t> queue;
+  row[source] = 0;
+  queue.push_back(source);
+
+  auto visit = [&](uint32_t current, Ptr<Node> neighbor) {
+    if (neighbor != nullptr && row[neighbor->GetId()] == UNREACHABLE) {
+      row[neighbor->GetId()] = row[current] + 1;
+      queue.push_back(neighbor->GetId());
+    }
+  };
+
+  while (!queue.empty()) {
+    uint32_t current = queue.front();
+    queue.pop_front();
+    Ptr<Node> node = NodeList::GetNode(current);
+
+    Ptr<GlobalRouter> gr = node->GetObject<GlobalRouter>();
+    if (gr != nullptr) {
+      for (const auto& incidency : gr->GetIncidencies()) {
+        visit(current, std::get<2>(incidency)->GetObject<Node>());
+      }
+      continue;
+    }
+
+    for (uint32_t deviceId = 0; deviceId < node->GetNDevices(); deviceId++) {
+      Ptr<Channel> channel = node->GetDevice(deviceId)->GetChannel();
+      if (channel == nullptr || channel->GetNDevices() != 2) {
+        continue;
+      }
+
+      for (uint32_t otherId = 0; otherId < channel->GetNDevices(); otherId++) {
+        Ptr<Node> other = channel->GetDevice(otherId)->GetNode();
+        if (other != node) {
+          visit(current, other);
+        }
+      }
+    }
+  }
+
+  NS_LOG_DEBUG("Computed hop distances from node " << source);
+  return row;
+}
+
+} // namespace ndn
+} // namespace ns3
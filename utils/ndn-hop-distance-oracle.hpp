@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_HOP_DISTANCE_ORACLE_H
+#define NDN_HOP_DISTANCE_ORACLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Global oracle of shortest hop distances between nodes of the simulated topology
+ *
+ * Distances are computed by BFS from a queried source node, once, and the resulting row is cached
+ * for subsequent queries from the same source.  Edges are taken from GlobalRouter incidencies
+ * if GlobalRoutingHelper has been installed on the node, and from point-to-point channels (two
+ * devices) otherwise.  Like in GlobalRoutingHelper, shared channels (e.g., wifi) are not edges.
+ *
+ * Cached rows are dropped on Simulator::Destroy, or explicitly with clear() if the topology
+ * changes during the simulation.
+ */
+class HopDistanceOracle : boost::noncopyable {
+public:
+  /**
+   * @brief Distance to nodes not reachable from the source
+   */
+  static const uint32_t UNREACHABLE = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * @brief Get the global instance of the oracle
+   */
+  static HopDistanceOracle&
+  get();
+
+  /**
+   * @brief Get number of hops on the shortest path between nodes with the ids
+   * @returns UNREACHABLE if there is no path
+   */
+  uint32_t
+  getDistance(uint32_t from, uint32_t to);
+
+  uint32_t
+  getDistance(Ptr<Node> from, Ptr<Node> to);
+
+  /**
+   * @brief Drop all cached rows
+   */
+  void
+  clear();
+
+  /**
+   * @brief Get number of cached rows (source nodes BFS has been run from)
+   */
+  size_t
+  size() const
+  {
+    return m_rows.size();
+  }
+
+private:
+  const std::vector<uint32_t>&
+  getRow(uint32_t source);
+
+private:
+  std::unordered_map<uint32_t, std::vector<uint32_t>> m_rows; // by source node id
+  bool m_isCleanupScheduled = false;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_HOP_DISTANCE_ORACLE_H
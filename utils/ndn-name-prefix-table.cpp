@@ -0,0 +1,66 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-name-prefix-table.hpp"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/encoding/tlv.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+NamePrefixTable&
+NamePrefixTable::get()
+{
+  static NamePrefixTable instance;
+  return instance;
+}
+
+NamePrefixTable::Id
+NamePrefixTable::intern(const Name& prefix)
+{
+  const Block& wire = prefix.wireEncode();
+  std::string key(reinterpret_cast<const char*>(wire.wire()), wire.size());
+
+  auto entry = m_ids.insert(std::make_pair(std::move(key), static_cast<Id>(m_prefixes.size())));
+  if (entry.second) {
+    // a freshly decoded copy, so the components refer to the single wire buffer
+    m_prefixes.push_back(Name(Block(wire.wire(), wire.size())));
+  }
+  return entry.first->second;
+}
+
+Name
+NamePrefixTable::makeName(Id id, const name::Component& suffix) const
+{
+  const Block& prefix = getPrefix(id).wireEncode();
+  size_t valueLength = prefix.value_size() + suffix.size();
+
+  // TLV type and length take at most 1 + 9 octets
+  ::ndn::EncodingBuffer encoder(valueLength + 10, 0);
+  encoder.prependByteArray(suffix.wire(), suffix.size());
+  encoder.prependByteArray(prefix.value(), prefix.value_size());
+  encoder.prependVarNumber(valueLength);
+  encoder.prependVarNumber(::ndn::tlv::Name);
+
+  return Name(encoder.block());
+}
+
+} // namespace ndn
+} // namespace ns3
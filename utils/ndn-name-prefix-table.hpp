@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_NAME_PREFIX_TABLE_H
+#define NDN_NAME_PREFIX_TABLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <limits>
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Global table of interned name prefixes
+ *
+ * Applications intern prefixes from their Name attributes once, when they start, and refer to
+ * them by id afterwards.  Each prefix is stored only once for the whole simulation, in its wire
+ * encoding, no matter how many applications use it.
+ *
+ * Names built with makeName() are encoded directly into a single buffer, which is shared by all
+ * components of the name, instead of copying the component list of the prefix and appending a
+ * separately allocated component to it.
+ *
+ * Entries are never removed, so ids and references returned by getPrefix() remain valid until
+ * the end of the process.
+ */
+class NamePrefixTable : boost::noncopyable {
+public:
+  typedef uint32_t Id;
+
+  /**
+   * @brief Id that never refers to an interned prefix, e.g., to mark a prefix not yet interned
+   */
+  static const Id INVALID_ID = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * @brief Get the global instance of the table
+   */
+  static NamePrefixTable&
+  get();
+
+  /**
+   * @brief Intern the prefix, if not yet interned
+   * @returns id of the prefix
+   */
+  Id
+  intern(const Name& prefix);
+
+  /**
+   * @brief Get interned prefix
+   */
+  const Name&
+  getPrefix(Id id) const
+  {
+    BOOST_ASSERT(id < m_prefixes.size());
+    return m_prefixes[id];
+  }
+
+  /**
+   * @brief Build name consisting of the interned prefix and one more component
+   */
+  Name
+  makeName(Id id, const name::Component& suffix) const;
+
+  /**
+   * @brief Build name consisting of the interned prefix and a sequence number component
+   */
+  Name
+  makeName(Id id, uint64_t seq) const
+  {
+    return makeName(id, name::Component::fromSequenceNumber(seq));
+  }
+
+  /**
+   * @brief Get number of interned prefixes
+   */
+  size_t
+  size() const
+  {
+    return m_prefixes.size();
+  }
+
+private:
+  NamePrefixTable() = default;
+
+private:
+  std::unordered_map<std::string, Id> m_ids; ///< @brief wire encoding to id
+  std::deque<Name> m_prefixes; ///< @brief deque, so references to elements remain valid
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_NAME_PREFIX_TABLE_H
@@ -0,0 +1,338 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-request-trace.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3 {
+namespace ndn {
+
+const char RequestTrace::MAGIC[8] = {'N', 'D', 'N', 'R', 'Q', 'T', 'R', '1'};
+
+// consumed pages are returned to the OS in chunks of this size
+static const size_t RELEASE_CHUNK = 4 * 1024 * 1024;
+
+static uint32_t
+readUint32(const uint8_t* buf)
+{
+  return static_cast<uint32_t>(buf[0]) | static_cast<uint32_t>(buf[1]) << 8
+         | static_cast<uint32_t>(buf[2]) << 16 | static_cast<uint32_t>(buf[3]) << 24;
+}
+
+static uint64_t
+readUint64(const uint8_t* buf)
+{
+  return static_cast<uint64_t>(readUint32(buf))
+         | static_cast<uint64_t>(readUint32(buf + 4)) << 32;
+}
+
+static void
+writeUint32(std::ostream& os, uint32_t value)
+{
+  char buf[4];
+  for (int i = 0; i < 4; i++) {
+    buf[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+  }
+  os.write(buf, sizeof(buf));
+}
+
+static void
+writeUint64(std::ostream& os, uint64_t value)
+{
+  writeUint32(os, static_cast<uint32_t>(value));
+  writeUint32(os, static_cast<uint32_t>(value >> 32));
+}
+
+RequestTraceReader::RequestTraceReader(const std::string& file)
+  : m_fd(-1)
+  , m_base(nullptr)
+  , m_length(0)
+  , m_position(0)
+  , m_released(0)
+{
+  m_fd = ::open(file.c_str(), O_RDONLY);
+  if (m_fd < 0) {
+    BOOST_THROW_EXCEPTION(RequestTrace::Error("Cannot open trace file [" + file + "]"));
+  }
+
+  struct stat st;
+  if (::fstat(m_fd, &st) != 0 || static_cast<size_t>(st.st_size) < RequestTrace::HEADER_SIZE) {
+    ::close(m_fd);
+    BOOST_THROW_EXCEPTION(RequestTrace::Error("Trace file [" + file + "] is truncated"));
+  }
+  m_length = st.st_size;
+
+  void* base = ::mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, m_fd, 0);
+  if (base == MAP_FAILED) {
+    ::close(m_fd);
+    BOOST_THROW_EXCEPTION(RequestTrace::Error("Cannot map trace file [" + file + "]"));
+  }
+  m_base = static_cast<const uint8_t*>(base);
+  ::madvise(base, m_length, MADV_SEQUENTIAL);
+
+  if (std::memcmp(m_base, RequestTrace::MAGIC, sizeof(RequestTrace::MAGIC)) != 0) {
+    unmap();
+    BOOST_THROW_EXCEPTION(RequestTrace::Error("[" + file + "] is not a request trace file"));
+  }
+
+  m_flags = readUint32(m_base + 8);
+  m_recordSize = readUint32(m_base + 12);
+  m_nRecords = readUint64(m_base + 16);
+  uint64_t dictionaryOffset = readUint64(m_base + 24);
+  m_nNames = readUint64(m_base + 32);
+
+  uint32_t expectedRecordSize = hasSize() ? 16 : 12;
+  if (m_recordSize != expectedRecordSize
+      || dictionaryOffset != RequestTrace::HEADER_SIZE + m_nRecords * m_recordSize
+      || dictionaryOffset + m_nNames * 8 > m_length) {
+    unmap();
+    BOOST_THROW_EXCEPTION(RequestTrace::Error("Trace file [" + file + "] is corrupted"));
+  }
+  m_dictionary = m_base + dictionaryOffset;
+}
+
+RequestTraceReader::~RequestTraceReader()
+{
+  unmap();
+}
+
+void
+RequestTraceReader::unmap()
+{
+  if (m_base != nullptr) {
+    ::munmap(const_cast<uint8_t*>(m_base), m_length);
+    m_base = nullptr;
+  }
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    m_fd = -1;
+  }
+}
+
+bool
+RequestTraceReader::peek(RequestTrace::Record& record) const
+{
+  if (m_position >= m_nRecords)
+    return false;
+
+  const uint8_t* buf = m_base + RequestTrace::HEADER_SIZE + m_position * m_recordSize;
+  record.offset = readUint64(buf);
+  record.nameId = readUint32(buf + 8);
+  record.size = hasSize() ? readUint32(buf + 12) : 0;
+  return true;
+}
+
+void
+RequestTraceReader::next()
+{
+  if (m_position < m_nRecords) {
+    m_position++;
+    releaseConsumedPages();
+  }
+}
+
+void
+RequestTraceReader::rewind()
+{
+  m_position = 0;
+  m_released = 0;
+}
+
+Name
+RequestTraceReader::getName(uint32_t nameId) const
+{
+  if (nameId >= m_nNames) {
+    BOOST_THROW_EXCEPTION(RequestTrace::Error("Name id " + std::to_string(nameId)
+                                              + " is not in the trace dictionary"));
+  }
+
+  const uint8_t* names = m_dictionary + m_nNames * 8;
+  uint64_t begin = readUint64(m_dictionary + nameId * 8);
+  uint64_t end = (nameId + 1 < m_nNames) ? readUint64(m_dictionary + (nameId + 1) * 8)
+                                         : static_cast<uint64_t>(m_base + m_length - names);
+  if (begin > end || names + end > m_base + m_length) {
+    BOOST_THROW_EXCEPTION(RequestTrace::Error("Trace dictionary is corrupted"));
+  }
+
+  return Name(Block(names + begin, end - begin));
+}
+
+void
+RequestTraceReader::releaseConsumedPages()
+{
+  size_t consumed = RequestTrace::HEADER_SIZE + m_position * m_recordSize;
+  if (consumed - m_released < RELEASE_CHUNK)
+    return;
+
+  // only whole pages can be released; the page with the current record is kept
+  size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  size_t end = (consumed / pageSize) * pageSize;
+  if (end > m_released) {
+    ::madvise(const_cast<uint8_t*>(m_base) + m_released, end - m_released, MADV_DONTNEED);
+    m_released = end;
+  }
+}
+
+RequestTraceWriter::RequestTraceWriter(const std::string& file, bool hasSize)
+  : m_os(file.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary)
+  , m_hasSize(hasSize)
+  , m_isClosed(false)
+  , m_nRecords(0)
+  , m_lastOffset(0)
+{
+  if (!m_os.is_open()) {
+    BOOST_THROW_EXCEPTION(RequestTrace::Error("Cannot open [" + file + "] for writing"));
+  }
+
+  // placeholder, the actual header is written by close()
+  char header[RequestTrace::HEADER_SIZE] = {0};
+  m_os.write(header, sizeof(header));
+}
+
+RequestTraceWriter::~RequestTraceWriter()
+{
+  if (!m_isClosed) {
+    try {
+      close();
+    }
+    catch (const std::exception&) {
+    }
+  }
+}
+
+void
+RequestTraceWriter::add(uint64_t offset, const Name& name, uint32_t size)
+{
+  if (offset < m_lastOffset) {
+    BOOST_THROW_EXCEPTION(RequestTrace::Error("Trace records must be ordered by time"));
+  }
+  m_lastOffset = offset;
+
+  uint32_t nextId = static_cast<uint32_t>(m_names.size());
+  auto entry = m_nameIds.insert(std::make_pair(name.toUri(), nextId));
+  if (entry.second) {
+    m_names.push_back(name.wireEncode());
+  }
+
+  writeUint64(m_os, offset);
+  writeUint32(m_os, entry.first->second);
+  if (m_hasSize) {
+    writeUint32(m_os, size);
+  }
+  m_nRecords++;
+}
+
+void
+RequestTraceWriter::close()
+{
+  if (m_isClosed)
+    return;
+  m_isClosed = true;
+
+  uint32_t recordSize = m_hasSize ? 16 : 12;
+  uint64_t dictionaryOffset = RequestTrace::HEADER_SIZE + m_nRecords * recordSize;
+
+  uint64_t nameOffset = 0;
+  for (const Block& name : m_names) {
+    writeUint64(m_os, nameOffset);
+    nameOffset += name.size();
+  }
+  for (const Block& name : m_names) {
+    m_os.write(reinterpret_cast<const char*>(name.wire()), name.size());
+  }
+
+  m_os.seekp(0);
+  m_os.write(RequestTrace::MAGIC, sizeof(RequestTrace::MAGIC));
+  writeUint32(m_os, m_hasSize ? RequestTrace::FLAG_HAS_SIZE : 0);
+  writeUint32(m_os, recordSize);
+  writeUint64(m_os, m_nRecords);
+  writeUint64(m_os, dictionaryOffset);
+  writeUint64(m_os, m_names.size());
+  m_os.close();
+
+  m_nameIds.clear();
+  m_names.clear();
+
+  if (m_os.fail()) {
+    BOOST_THROW_EXCEPTION(RequestTrace::Error("Failed to write the trace file"));
+  }
+}
+
+uint64_t
+RequestTraceWriter::convertText(std::istream& is, const std::string& file)
+{
+  std::unique_ptr<RequestTraceWriter> writer;
+  double firstTime = 0;
+
+  std::string line;
+  size_t lineNo = 0;
+  while (std::getline(is, line)) {
+    lineNo++;
+    std::istringstream fields(line);
+    double time;
+    std::string uri;
+    if (!(fields >> time)) {
+      // empty line or comment
+      std::istringstream empty(line);
+      std::string first;
+      if (!(empty >> first) || first[0] == '#')
+        continue;
+      BOOST_THROW_EXCEPTION(RequestTrace::Error("Invalid time on line " + std::to_string(lineNo)));
+    }
+    if (!(fields >> uri)) {
+      BOOST_THROW_EXCEPTION(RequestTrace::Error("Missing name on line " + std::to_string(lineNo)));
+    }
+    uint32_t size = 0;
+    bool hasSize = static_cast<bool>(fields >> size);
+
+    if (writer == nullptr) {
+      writer.reset(new RequestTraceWriter(file, hasSize));
+      firstTime = time;
+    }
+    else if (hasSize != writer->m_hasSize) {
+      BOOST_THROW_EXCEPTION(RequestTrace::Error("Size should be present either on all or on none "
+                                                "of the lines (line "
+                                                + std::to_string(lineNo) + ")"));
+    }
+
+    if (time < firstTime) {
+      BOOST_THROW_EXCEPTION(RequestTrace::Error("Trace records must be ordered by time (line "
+                                                + std::to_string(lineNo) + ")"));
+    }
+    writer->add(static_cast<uint64_t>(std::llround((time - firstTime) * 1e9)), Name(uri), size);
+  }
+
+  if (writer == nullptr) {
+    writer.reset(new RequestTraceWriter(file, false));
+  }
+  uint64_t nRecords = writer->m_nRecords;
+  writer->close();
+  return nRecords;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_REQUEST_TRACE_H
+#define NDN_REQUEST_TRACE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Compact binary request trace, consisting of (time offset, name id, optional size) records
+ *
+ * File layout (all integers are little-endian):
+ *
+ *     header      "NDNRQTR1", uint32 flags, uint32 record size, uint64 number of records,
+ *                 uint64 dictionary offset, uint64 number of names
+ *     records     {uint64 time offset in nanoseconds, uint32 name id [, uint32 size]} ...
+ *     dictionary  uint64 offset of each name (relative to the first name), TLV-encoded names
+ *
+ * Records must be ordered by time offset.  Names are interned: each distinct name is stored only
+ * once in the dictionary and records refer to it by its id.
+ */
+class RequestTrace {
+public:
+  class Error : public std::runtime_error {
+  public:
+    explicit Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  struct Record {
+    uint64_t offset; ///< @brief time offset from the beginning of the trace, in nanoseconds
+    uint32_t nameId; ///< @brief id of the requested name in the trace dictionary
+    uint32_t size;   ///< @brief optional size of the requested object (0 if not present)
+  };
+
+  enum {
+    FLAG_HAS_SIZE = 1
+  };
+
+  static const char MAGIC[8];
+  static const size_t HEADER_SIZE = 40;
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Streaming reader of the binary request trace
+ *
+ * The file is memory-mapped and records are read sequentially.  Pages that have already been
+ * consumed are released back to the OS, so the resident size of the reader does not depend on the
+ * length of the trace.
+ */
+class RequestTraceReader : boost::noncopyable {
+public:
+  /**
+   * @brief Map trace file into memory
+   * @throw RequestTrace::Error if file cannot be opened or is not a valid trace file
+   */
+  explicit RequestTraceReader(const std::string& file);
+
+  ~RequestTraceReader();
+
+  /**
+   * @brief Get the record at the current read position, without advancing it
+   * @returns false if the end of the trace has been reached
+   */
+  bool
+  peek(RequestTrace::Record& record) const;
+
+  /**
+   * @brief Advance read position to the next record
+   */
+  void
+  next();
+
+  /**
+   * @brief Return read position to the first record of the trace
+   */
+  void
+  rewind();
+
+  /**
+   * @brief Get name with the specified id from the trace dictionary
+   */
+  Name
+  getName(uint32_t nameId) const;
+
+  uint64_t
+  getNRecords() const
+  {
+    return m_nRecords;
+  }
+
+  uint64_t
+  getNNames() const
+  {
+    return m_nNames;
+  }
+
+  bool
+  hasSize() const
+  {
+    return (m_flags & RequestTrace::FLAG_HAS_SIZE) != 0;
+  }
+
+private:
+  void
+  releaseConsumedPages();
+
+  void
+  unmap();
+
+private:
+  int m_fd;
+  const uint8_t* m_base;
+  size_t m_length;
+
+  uint32_t m_flags;
+  uint32_t m_recordSize;
+  uint64_t m_nRecords;
+  const uint8_t* m_dictionary;
+  uint64_t m_nNames;
+
+  uint64_t m_position;
+  size_t m_released; ///< @brief number of bytes from the beginning of the file already released
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Writer of the binary request trace
+ */
+class RequestTraceWriter : boost::noncopyable {
+public:
+  /**
+   * @brief Create trace file
+   * @param file    output file name
+   * @param hasSize whether records will carry size of the requested object
+   * @throw RequestTrace::Error if file cannot be opened for writing
+   */
+  RequestTraceWriter(const std::string& file, bool hasSize);
+
+  ~RequestTraceWriter();
+
+  /**
+   * @brief Append a record to the trace
+   * @param offset time offset from the beginning of the trace, in nanoseconds
+   * @throw RequestTrace::Error if offset is smaller than offset of the previous record
+   */
+  void
+  add(uint64_t offset, const Name& name, uint32_t size = 0);
+
+  /**
+   * @brief Write the dictionary and finalize the trace file
+   */
+  void
+  close();
+
+  /**
+   * @brief Convert text request log into the binary trace
+   *
+   * Each non-empty line of the log, except lines starting with '#', should contain time in
+   * seconds, requested name, and optionally size of the requested object, separated by
+   * whitespace.  Time offsets in the resulting trace are relative to the first record.
+   *
+   * @returns number of converted records
+   */
+  static uint64_t
+  convertText(std::istream& is, const std::string& file);
+
+private:
+  std::ofstream m_os;
+  bool m_hasSize;
+  bool m_isClosed;
+  uint64_t m_nRecords;
+  uint64_t m_lastOffset;
+
+  std::unordered_map<std::string, uint32_t> m_nameIds;
+  std::vector<Block> m_names;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_REQUEST_TRACE_H
@@ -216,6 +216,12 @@ RttEstimator::AckSeq(SequenceNumber32 ackSeq)
   return m;
 }
 
+Time
+RttEstimator::AckInterest(SequenceNumber32 ackSeq, Time sentTime, bool isRetransmitted)
+{
+  return AckSeq(ackSeq);
+}
+
 void
 RttEstimator::ClearSent()
 {
@@ -252,5 +258,11 @@ RttEstimator::Reset()
   ResetMultiplier();
 }
 
+bool
+RttEstimator::KeepsHistory() const
+{
+  return true;
+}
+
 } // namespace ndn
 } // namespace ns3
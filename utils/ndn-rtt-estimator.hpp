@@ -87,6 +87,20 @@ public:
   virtual Time
   AckSeq(SequenceNumber32 ackSeq);
 
+  /**
+   * \brief Note that Data for a particular sequence has been received, when the time the
+   *        corresponding Interest was last sent is known to the caller
+   *
+   * The default implementation ignores the provided timestamp and falls back to AckSeq.
+   *
+   * \param ackSeq the sequence number of the received Data.
+   * \param sentTime the time the last Interest for this sequence number was sent.
+   * \param isRetransmitted whether the Interest for this sequence number has been retransmitted.
+   * \return The measured RTT for this Data, or zero if no sample has been taken.
+   */
+  virtual Time
+  AckInterest(SequenceNumber32 ackSeq, Time sentTime, bool isRetransmitted);
+
   /**
    * \brief Clear all history entries
    */
@@ -128,6 +142,18 @@ public:
   virtual void
   Reset();
 
+  /**
+   * \brief Whether the estimator keeps a history of sent sequence numbers
+   *
+   * Consumers reset such estimators after every Data packet, so that the history does not grow.
+   * Estimators that keep no history are not reset and carry their estimate from one Data to
+   * the next.
+   *
+   * \return true by default.
+   */
+  virtual bool
+  KeepsHistory() const;
+
   /**
    * \brief Sets the Minimum RTO.
    * \param minRto The minimum RTO returned by the estimator.
@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-rtt-per-interest.hpp"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.RttPerInterest");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(RttPerInterest);
+
+TypeId
+RttPerInterest::GetTypeId(void)
+{
+  static TypeId tid = TypeId("ns3::ndn::RttPerInterest")
+                        .SetParent<RttMeanDeviation>()
+                        .AddConstructor<RttPerInterest>();
+  return tid;
+}
+
+RttPerInterest::RttPerInterest()
+{
+  NS_LOG_FUNCTION(this);
+}
+
+RttPerInterest::RttPerInterest(const RttPerInterest& c)
+  : RttMeanDeviation(c)
+{
+  NS_LOG_FUNCTION(this);
+}
+
+TypeId
+RttPerInterest::GetInstanceTypeId(void) const
+{
+  return GetTypeId();
+}
+
+void
+RttPerInterest::SentSeq(SequenceNumber32 seq, uint32_t size)
+{
+}
+
+Time
+RttPerInterest::AckSeq(SequenceNumber32 ackSeq)
+{
+  return Seconds(0.0);
+}
+
+bool
+RttPerInterest::KeepsHistory() const
+{
+  return false;
+}
+
+Time
+RttPerInterest::AckInterest(SequenceNumber32 ackSeq, Time sentTime, bool isRetransmitted)
+{
+  NS_LOG_FUNCTION(this << ackSeq << sentTime << isRetransmitted);
+
+  if (isRetransmitted) {
+    // Karn's algorithm: ambiguous sample
+    return Seconds(0.0);
+  }
+
+  Time m = Simulator::Now() - sentTime;
+  Measurement(m);
+  ResetMultiplier(); // Reset multiplier on valid measurement
+  return m;
+}
+
+Ptr<RttEstimator>
+RttPerInterest::Copy() const
+{
+  NS_LOG_FUNCTION(this);
+  return CopyObject<RttPerInterest>(this);
+}
+
+} // namespace ndn
+} // namespace ns3
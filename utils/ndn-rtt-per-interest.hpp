@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_RTT_PER_INTEREST_H
+#define NDN_RTT_PER_INTEREST_H
+
+#include "ndn-rtt-mean-deviation.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Mean--Deviation RTT estimator that takes samples from individual Interest/Data exchanges
+ *
+ * Unlike the TCP-derived RttEstimator, which keeps a history of sent sequence numbers and
+ * samples only on cumulative acknowledgements, this estimator keeps no history at all.  The RTT
+ * sample is calculated from the time the consumer has sent the Interest, which is passed to
+ * AckInterest, so out-of-order (e.g., random) sequence numbers are sampled as well, and each
+ * event takes constant time.
+ *
+ * Following Karn's algorithm, Data for retransmitted Interests do not produce samples, as it is
+ * impossible to tell which of the transmissions it satisfied.
+ */
+class RttPerInterest : public RttMeanDeviation {
+public:
+  static TypeId
+  GetTypeId(void);
+
+  RttPerInterest();
+  RttPerInterest(const RttPerInterest&);
+
+  virtual TypeId
+  GetInstanceTypeId(void) const;
+
+  /**
+   * \brief Does nothing, send times are tracked by the consumer
+   */
+  void
+  SentSeq(SequenceNumber32 seq, uint32_t size);
+
+  /**
+   * \brief Does nothing, samples are taken only in AckInterest
+   */
+  Time
+  AckSeq(SequenceNumber32 ackSeq);
+
+  Time
+  AckInterest(SequenceNumber32 ackSeq, Time sentTime, bool isRetransmitted);
+
+  /**
+   * \brief Returns false, the estimate is kept across Data packets
+   */
+  bool
+  KeepsHistory() const;
+
+  Ptr<RttEstimator>
+  Copy() const;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RTT_PER_INTEREST_H
@@ -28,64 +28,69 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 
+#include "ndn-tracer-registry.hpp"
+
 #include <boost/lexical_cast.hpp>
-#include <fstream>
+
+#include <algorithm>
+#include <vector>
 
 NS_LOG_COMPONENT_DEFINE("L2RateTracer");
 
 namespace ns3 {
 
-static std::list<std::tuple<std::shared_ptr<std::ostream>, std::list<Ptr<L2RateTracer>>>>
-  g_tracers;
-
 void
 L2RateTracer::Destroy()
 {
-  g_tracers.clear();
+  ndn::TracerRegistry::Get().Remove("L2RateTracer");
 }
 
 void
-L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/,
+                         ndn::TraceSink::Format format /* = ndn::TraceSink::TEXT*/)
 {
-  std::list<Ptr<L2RateTracer>> tracers;
-  std::shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    std::shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = std::shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  std::shared_ptr<ndn::TraceSink> sink = ndn::TraceSink::Open(file, format);
+  if (sink == nullptr) {
+    return;
   }
+  sink->SetColumns(GetColumns());
 
+  auto tracers = std::make_shared<std::vector<Ptr<L2RateTracer>>>();
+  tracers->reserve(NodeList::GetNNodes());
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     NS_LOG_DEBUG("Node: " << boost::lexical_cast<std::string>((*node)->GetId()));
 
-    Ptr<L2RateTracer> trace = Create<L2RateTracer>(outputStream, *node);
-    trace->SetAveragingPeriod(averagingPeriod);
-    tracers.push_back(trace);
+    Ptr<L2RateTracer> trace = Create<L2RateTracer>(sink, *node);
+    trace->m_period = averagingPeriod;
+    tracers->push_back(trace);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  const std::vector<Ptr<L2RateTracer>>* group = tracers.get();
+  ndn::TracerRegistry::Get().Add("L2RateTracer", sink, tracers, averagingPeriod,
+                                 [group] (ndn::TraceSink& sink) {
+                                   for (const auto& trace : *group) {
+                                     trace->Print(sink);
+                                     trace->Reset();
+                                   }
+                                 });
 }
 
 L2RateTracer::L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node)
+  : L2RateTracer(std::make_shared<ndn::TextTraceSink>(os), node)
+{
+}
+
+L2RateTracer::L2RateTracer(std::shared_ptr<ndn::TraceSink> sink, Ptr<Node> node)
   : L2Tracer(node)
-  , m_os(os)
+  , m_sink(sink)
+  , m_period(Seconds(1.0))
+  , m_stats(m_interfaces.size())
 {
-  SetAveragingPeriod(Seconds(1.0));
+  for (const auto& iface : m_interfaces) {
+    QueueStats& queue = m_stats[iface.position].queue;
+    GetQueueLength(iface, queue.packets, queue.bytes);
+  }
+  Reset();
 }
 
 L2RateTracer::~L2RateTracer()
@@ -104,71 +109,127 @@ L2RateTracer::SetAveragingPeriod(const Time& period)
 void
 L2RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  Print(*m_sink);
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L2RateTracer::PeriodicPrinter, this);
 }
 
+const ndn::TraceSink::Columns&
+L2RateTracer::GetColumns()
+{
+  static const ndn::TraceSink::Columns columns = {{"Time", ndn::TraceSink::DOUBLE},
+                                                  {"Node", ndn::TraceSink::STRING},
+                                                  {"Interface", ndn::TraceSink::STRING},
+                                                  {"FaceId", ndn::TraceSink::INTEGER},
+                                                  {"Type", ndn::TraceSink::STRING},
+                                                  {"Packets", ndn::TraceSink::DOUBLE},
+                                                  {"Kilobytes", ndn::TraceSink::DOUBLE},
+                                                  {"PacketsRaw", ndn::TraceSink::DOUBLE},
+                                                  {"KilobytesRaw", ndn::TraceSink::DOUBLE}};
+  return columns;
+}
+
 void
 L2RateTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-     << "Interface"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t"
-     << "Kilobytes"
-     << "\t"
-     << "PacketsRaw"
-     << "\t"
-     << "KilobytesRaw";
+  ndn::TraceSink::PrintColumnNames(os, GetColumns());
 }
 
 void
 L2RateTracer::Reset()
 {
-  std::get<0>(m_stats).Reset();
-  std::get<1>(m_stats).Reset();
+  m_periodStart = Simulator::Now();
+
+  for (auto& stats : m_stats) {
+    std::get<0>(stats.drops).Reset();
+    std::get<1>(stats.drops).Reset();
+
+    QueueStats& queue = stats.queue;
+    queue.lastChange = m_periodStart;
+    queue.packetSeconds = 0;
+    queue.byteSeconds = 0;
+    queue.maxPackets = queue.packets;
+    queue.maxBytes = queue.bytes;
+  }
 }
 
 const double alpha = 0.8;
 
-#define STATS(INDEX) std::get<INDEX>(m_stats)
+#define STATS(INDEX) std::get<INDEX>(stats.drops)
 #define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
 
-#define PRINTER(printName, fieldName, interface)                                                   \
+#define PRINTER(printName, fieldName)                                                              \
   STATS(2).fieldName =                                                                             \
     /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
   STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
                        + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << interface << "\t" << printName << "\t" \
-     << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t" << STATS(0).fieldName << "\t"     \
-     << STATS(1).fieldName / 1024.0 << "\n";
+  sink.WriteRow(time, m_node, interface, faceId, printName, STATS(2).fieldName,                    \
+                STATS(3).fieldName, STATS(0).fieldName, STATS(1).fieldName / 1024.0);
 
 void
 L2RateTracer::Print(std::ostream& os) const
 {
-  Time time = Simulator::Now();
+  ndn::TextTraceSink sink(std::shared_ptr<std::ostream>(&os, std::bind([]{})));
+  Print(sink);
+}
 
-  PRINTER("Drop", m_drop, "combined");
+void
+L2RateTracer::Print(ndn::TraceSink& sink) const
+{
+  Time now = Simulator::Now();
+  double time = now.ToDouble(Time::S);
+  double elapsed = (now - m_periodStart).ToDouble(Time::S);
+
+  for (const auto& iface : m_interfaces) {
+    const std::string interface = boost::lexical_cast<std::string>(iface.ifIndex);
+    const int64_t faceId = iface.faceId;
+    InterfaceStats& stats = m_stats[iface.position];
+
+    PRINTER("Drop", m_drop);
+
+    // time-weighted average, including the time since the last change of occupancy
+    const QueueStats& queue = stats.queue;
+    double sinceChange = (now - queue.lastChange).ToDouble(Time::S);
+    double avgPackets = queue.packets;
+    double avgBytes = queue.bytes;
+    if (elapsed > 0) {
+      avgPackets = (queue.packetSeconds + queue.packets * sinceChange) / elapsed;
+      avgBytes = (queue.byteSeconds + queue.bytes * sinceChange) / elapsed;
+    }
+
+    sink.WriteRow(time, m_node, interface, faceId, "QueueAvg", avgPackets, avgBytes / 1024.0,
+                  static_cast<double>(queue.packets), queue.bytes / 1024.0);
+    sink.WriteRow(time, m_node, interface, faceId, "QueueMax",
+                  static_cast<double>(queue.maxPackets), queue.maxBytes / 1024.0,
+                  static_cast<double>(queue.packets), queue.bytes / 1024.0);
+  }
 }
 
 void
-L2RateTracer::Drop(Ptr<const Packet> packet)
+L2RateTracer::Drop(const Interface& iface, Ptr<const Packet> packet)
 {
-  // no interface information... this should be part of this L2Tracer object data
+  InterfaceStats& stats = m_stats[iface.position];
+  std::get<0>(stats.drops).m_drop++;
+  std::get<1>(stats.drops).m_drop += packet->GetSize();
+}
 
-  std::get<0>(m_stats).m_drop++;
-  std::get<1>(m_stats).m_drop += packet->GetSize();
+void
+L2RateTracer::QueueLength(const Interface& iface, uint32_t packets, uint32_t bytes)
+{
+  QueueStats& queue = m_stats[iface.position].queue;
+
+  Time now = Simulator::Now();
+  double duration = (now - queue.lastChange).ToDouble(Time::S);
+  queue.packetSeconds += queue.packets * duration;
+  queue.byteSeconds += queue.bytes * duration;
+  queue.lastChange = now;
+
+  queue.packets = packets;
+  queue.bytes = bytes;
+  queue.maxPackets = std::max(queue.maxPackets, packets);
+  queue.maxBytes = std::max(queue.maxBytes, bytes);
 }
 
 } // namespace ns3
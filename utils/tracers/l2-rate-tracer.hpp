@@ -21,12 +21,14 @@
 #define L2_RATE_TRACER_H
 
 #include "l2-tracer.hpp"
+#include "ndn-trace-sink.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
 
 #include <tuple>
 #include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -34,7 +36,8 @@ namespace ns3 {
  * @ingroup ndn-tracers
  * @brief Tracer to collect link-layer rate information about links
  *
- * @todo Finish implementation
+ * For each interface, reports the rate of dropped packets, as well as time-weighted average and
+ * maximum occupancy of the transmission queue within the averaging period.
  */
 class L2RateTracer : public L2Tracer {
 public:
@@ -42,6 +45,13 @@ public:
    * @brief Network layer tracer constructor
    */
   L2RateTracer(std::shared_ptr<std::ostream> os, Ptr<Node> node);
+
+  /**
+   * @brief Network layer tracer constructor
+   * @param sink Sink of the trace, its columns should be set to GetColumns()
+   */
+  L2RateTracer(std::shared_ptr<ndn::TraceSink> sink, Ptr<Node> node);
+
   virtual ~L2RateTracer();
 
   /**
@@ -51,14 +61,17 @@ public:
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
-   *
-   * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
-   *tuple needs to be preserved
-   *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
-   *
+   * @param format Format of the trace file (default, tab-separated text)
    */
   static void
-  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5),
+             ndn::TraceSink::Format format = ndn::TraceSink::TEXT);
+
+  /**
+   * @brief Get columns of the trace
+   */
+  static const ndn::TraceSink::Columns&
+  GetColumns();
 
   /**
    * @brief Explicit request to remove all statically created tracers
@@ -69,6 +82,12 @@ public:
   static void
   Destroy();
 
+  /**
+   * @brief Print the trace of this tracer every @p period on its own
+   *
+   * Tracers created by InstallAll are printed by TracerRegistry instead and must not
+   * call this method.
+   */
   void
   SetAveragingPeriod(const Time& period);
 
@@ -78,8 +97,16 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  void
+  Print(ndn::TraceSink& sink) const;
+
+protected:
+  // from L2Tracer
+  virtual void
+  Drop(const Interface& iface, Ptr<const Packet> packet);
+
   virtual void
-  Drop(Ptr<const Packet>);
+  QueueLength(const Interface& iface, uint32_t packets, uint32_t bytes);
 
 private:
   void
@@ -89,11 +116,27 @@ private:
   Reset();
 
 private:
-  std::shared_ptr<std::ostream> m_os;
+  std::shared_ptr<ndn::TraceSink> m_sink;
   Time m_period;
   EventId m_printEvent;
 
-  mutable std::tuple<Stats, Stats, Stats, Stats> m_stats;
+  struct QueueStats {
+    uint32_t packets; ///< @brief current occupancy
+    uint32_t bytes;
+    Time lastChange;
+    double packetSeconds; ///< @brief integral of occupancy since the start of the period
+    double byteSeconds;
+    uint32_t maxPackets;
+    uint32_t maxBytes;
+  };
+
+  struct InterfaceStats {
+    std::tuple<Stats, Stats, Stats, Stats> drops;
+    QueueStats queue;
+  };
+
+  Time m_periodStart;
+  mutable std::vector<InterfaceStats> m_stats; // indexed by Interface::position
 };
 
 } // namespace ns3
@@ -23,9 +23,22 @@
 #include "ns3/config.h"
 #include "ns3/names.h"
 #include "ns3/callback.h"
+#include "ns3/simulator.h"
+#include "ns3/pointer.h"
 
 #include "ns3/point-to-point-net-device.h"
+#include "ns3/csma-net-device.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-mac.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/dca-txop.h"
 #include "ns3/queue.h"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/model/ndn-net-device-transport.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
 #include <boost/lexical_cast.hpp>
 
 namespace ns3 {
@@ -43,16 +56,166 @@ L2Tracer::L2Tracer(Ptr<Node> node)
   }
 }
 
+L2Tracer::~L2Tracer()
+{
+  Disconnect();
+}
+
 void
 L2Tracer::Connect()
 {
+  Disconnect();
+
+  Ptr<ndn::L3Protocol> l3 = m_nodePtr->GetObject<ndn::L3Protocol>();
+
+  std::vector<Interface> interfaces;
   for (uint32_t devId = 0; devId < m_nodePtr->GetNDevices(); devId++) {
-    Ptr<PointToPointNetDevice> p2pnd =
-      DynamicCast<PointToPointNetDevice>(m_nodePtr->GetDevice(devId));
-    if (p2pnd) {
-      p2pnd->GetQueue()->TraceConnectWithoutContext("Drop", MakeCallback(&L2Tracer::Drop, this));
+    Ptr<NetDevice> device = m_nodePtr->GetDevice(devId);
+
+    Interface iface{};
+    iface.tracer = this;
+    iface.ifIndex = devId;
+    iface.faceId = -1;
+
+    if (auto p2pnd = DynamicCast<PointToPointNetDevice>(device)) {
+      iface.dropSource = p2pnd;
+      iface.queue = p2pnd->GetQueue();
+    }
+    else if (auto csmand = DynamicCast<CsmaNetDevice>(device)) {
+      iface.dropSource = csmand;
+      iface.queue = csmand->GetQueue();
+    }
+    else if (auto wifind = DynamicCast<WifiNetDevice>(device)) {
+      // only non-QoS MAC has a single queue
+      PointerValue txop;
+      if (wifind->GetMac()->GetAttributeFailSafe("DcaTxop", txop)) {
+        iface.wifiQueue = txop.Get<DcaTxop>()->GetQueue();
+      }
+      iface.dropSource = wifind->GetMac();
+      iface.phy = wifind->GetPhy();
+    }
+    else {
+      continue;
+    }
+
+    if (l3 != nullptr) {
+      for (const auto& face : l3->getForwarder()->getFaceTable()) {
+        auto transport = dynamic_cast<ndn::NetDeviceTransport*>(face.getTransport());
+        if (transport != nullptr && transport->GetNetDevice() == device) {
+          iface.faceId = face.getId();
+          break;
+        }
+      }
+    }
+
+    iface.position = interfaces.size();
+    interfaces.push_back(iface);
+  }
+  m_interfaces.swap(interfaces);
+
+  for (auto& iface : m_interfaces) {
+    iface.dropSource->TraceConnectWithoutContext("MacTxDrop",
+                                                 MakeBoundCallback(&L2Tracer::OnDrop, &iface));
+    if (iface.queue != nullptr) {
+      iface.queue->TraceConnectWithoutContext("PacketsInQueue",
+                                              MakeBoundCallback(&L2Tracer::OnQueueChange, &iface));
+      iface.queue->TraceConnectWithoutContext("BytesInQueue",
+                                              MakeBoundCallback(&L2Tracer::OnQueueChange, &iface));
+    }
+    if (iface.wifiQueue != nullptr) {
+      iface.dropSource->TraceConnectWithoutContext("MacTx",
+                                                   MakeBoundCallback(&L2Tracer::OnWifiMacTx,
+                                                                     &iface));
+      iface.phy->TraceConnectWithoutContext("PhyTxBegin",
+                                            MakeBoundCallback(&L2Tracer::OnWifiPhyTxBegin, &iface));
+    }
+  }
+}
+
+void
+L2Tracer::Disconnect()
+{
+  for (auto& iface : m_interfaces) {
+    iface.dropSource->TraceDisconnectWithoutContext("MacTxDrop",
+                                                    MakeBoundCallback(&L2Tracer::OnDrop, &iface));
+    if (iface.queue != nullptr) {
+      iface.queue->TraceDisconnectWithoutContext("PacketsInQueue",
+                                                 MakeBoundCallback(&L2Tracer::OnQueueChange,
+                                                                   &iface));
+      iface.queue->TraceDisconnectWithoutContext("BytesInQueue",
+                                                 MakeBoundCallback(&L2Tracer::OnQueueChange,
+                                                                   &iface));
+    }
+    if (iface.wifiQueue != nullptr) {
+      // the pending sample refers to the interface, which is about to be released
+      Simulator::Cancel(iface.wifiSample);
+      iface.dropSource->TraceDisconnectWithoutContext("MacTx",
+                                                      MakeBoundCallback(&L2Tracer::OnWifiMacTx,
+                                                                        &iface));
+      iface.phy->TraceDisconnectWithoutContext("PhyTxBegin",
+                                               MakeBoundCallback(&L2Tracer::OnWifiPhyTxBegin,
+                                                                 &iface));
     }
   }
+  m_interfaces.clear();
+}
+
+void
+L2Tracer::GetQueueLength(const Interface& iface, uint32_t& packets, uint32_t& bytes)
+{
+  if (iface.queue != nullptr) {
+    packets = iface.queue->GetNPackets();
+    bytes = iface.queue->GetNBytes();
+  }
+  else if (iface.wifiQueue != nullptr) {
+    // WifiMacQueue does not count bytes, so they are estimated from the average packet size
+    packets = iface.wifiQueue->GetSize();
+    bytes = static_cast<uint32_t>(packets * iface.wifiPacketSize);
+  }
+  else {
+    packets = 0;
+    bytes = 0;
+  }
+}
+
+void
+L2Tracer::OnDrop(Interface* iface, Ptr<const Packet> packet)
+{
+  iface->tracer->Drop(*iface, packet);
+}
+
+void
+L2Tracer::OnQueueChange(Interface* iface, uint32_t, uint32_t)
+{
+  SampleQueue(iface);
+}
+
+void
+L2Tracer::OnWifiMacTx(Interface* iface, Ptr<const Packet> packet)
+{
+  iface->wifiPackets++;
+  iface->wifiPacketSize += (packet->GetSize() - iface->wifiPacketSize) / iface->wifiPackets;
+
+  // MacTx is fired before the packet is enqueued (or sent right away); a pending sample will see
+  // this packet as well
+  if (!iface->wifiSample.IsRunning()) {
+    iface->wifiSample = Simulator::ScheduleNow(&L2Tracer::SampleQueue, iface);
+  }
+}
+
+void
+L2Tracer::OnWifiPhyTxBegin(Interface* iface, Ptr<const Packet>)
+{
+  // the frame has been dequeued, unless it is a control frame or retransmission
+  SampleQueue(iface);
+}
+
+void
+L2Tracer::SampleQueue(Interface* iface)
+{
+  uint32_t packets, bytes;
+  GetQueueLength(*iface, packets, bytes);
+  iface->tracer->QueueLength(*iface, packets, bytes);
 }
 
 } // namespace ns3
@@ -25,41 +25,103 @@
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include "ns3/packet.h"
+#include "ns3/event-id.h"
+
+#include <vector>
 
 namespace ns3 {
 
 class Node;
+class Object;
+class Queue;
+class WifiMacQueue;
 
 /**
  * @ingroup ndn-tracers
  * @brief Link-layer tracer
  *
- * @todo Finish implementation
+ * Tracks drops and transmission queue occupancy on each point-to-point, CSMA, and Wi-Fi
+ * interface of the node.  Interfaces are identified by the index of NetDevice and by the id of
+ * NDN face created on top of it, as reported by L3 tracers.
  */
 class L2Tracer : public SimpleRefCount<L2Tracer> {
 public:
   L2Tracer(Ptr<Node> node);
-  virtual ~L2Tracer(){};
+  virtual ~L2Tracer();
 
   void
   Connect();
 
+  void
+  Disconnect();
+
   virtual void
   PrintHeader(std::ostream& os) const = 0;
 
   virtual void
   Print(std::ostream& os) const = 0;
 
-  virtual void
-  Drop(Ptr<const Packet>) = 0;
-
   // Rx/Tx is NetDevice specific
   // please refer to pyviz.cc in order to extend this tracer
 
+protected:
+  /**
+   * @brief Transmission queue of a NetDevice
+   */
+  struct Interface {
+    L2Tracer* tracer;
+    size_t position;  ///< @brief position in m_interfaces
+    uint32_t ifIndex; ///< @brief index of NetDevice on the node
+    int64_t faceId;   ///< @brief id of NDN face on the NetDevice, -1 if none
+
+    Ptr<Object> dropSource; ///< @brief NetDevice or Wi-Fi MAC firing MacTxDrop
+    Ptr<Object> phy;        ///< @brief Wi-Fi PHY firing PhyTxBegin
+
+    Ptr<Queue> queue;            ///< @brief queue of point-to-point or CSMA NetDevice
+    Ptr<WifiMacQueue> wifiQueue; ///< @brief queue of Wi-Fi MAC, which does not count bytes
+    double wifiPacketSize;       ///< @brief average size of packets given to Wi-Fi MAC
+    uint64_t wifiPackets;
+    EventId wifiSample;          ///< @brief pending sample of Wi-Fi queue, cancelled by Disconnect
+  };
+
+  virtual void
+  Drop(const Interface& iface, Ptr<const Packet> packet) = 0;
+
+  /**
+   * @brief Called when occupancy of the interface queue changes
+   */
+  virtual void
+  QueueLength(const Interface& iface, uint32_t packets, uint32_t bytes) = 0;
+
+  /**
+   * @brief Get the current occupancy of the interface queue
+   */
+  static void
+  GetQueueLength(const Interface& iface, uint32_t& packets, uint32_t& bytes);
+
+private:
+  static void
+  OnDrop(Interface* iface, Ptr<const Packet> packet);
+
+  static void
+  OnQueueChange(Interface* iface, uint32_t oldValue, uint32_t newValue);
+
+  static void
+  OnWifiMacTx(Interface* iface, Ptr<const Packet> packet);
+
+  static void
+  OnWifiPhyTxBegin(Interface* iface, Ptr<const Packet> packet);
+
+  static void
+  SampleQueue(Interface* iface);
+
 protected:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
+  // filled in by Connect, never resized afterwards, as callbacks are bound to its elements
+  std::vector<Interface> m_interfaces;
+
   struct Stats {
     void
     Reset()
@@ -69,9 +131,9 @@ protected:
       m_drop = 0;
     }
 
-    uint64_t m_in;
-    uint64_t m_out;
-    uint64_t m_drop;
+    double m_in;
+    double m_out;
+    double m_drop;
   };
 };
 
@@ -18,6 +18,8 @@
  **/
 
 #include "ndn-app-delay-tracer.hpp"
+#include "ndn-log-linear-histogram.hpp"
+#include "ndn-tracer-registry.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -28,143 +30,193 @@
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
+#include "ns3/string.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
-#include <fstream>
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <vector>
 
 NS_LOG_COMPONENT_DEFINE("ndn.AppDelayTracer");
 
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<AppDelayTracer>>>>
-  g_tracers;
+// delays are recorded in microseconds, up to about 4295 seconds
+static const unsigned DELAY_RANGE_BITS = 32;
+static const unsigned COUNT_RANGE_BITS = 8;
+
+static const double PERCENTILES[] = {50, 90, 99, 99.9};
+
+// kinds of events sampled independently by TraceFilter
+enum {
+  LAST_DELAY,
+  FULL_DELAY
+};
+
+/**
+ * @brief Histograms of all tracers installed by one AppDelayTracer::InstallHistograms call
+ */
+class AppDelayHistograms {
+public:
+  AppDelayHistograms(shared_ptr<TraceSink> sink, AppDelayTracer::Aggregation aggregation,
+                     double weight);
+
+  /**
+   * @brief Write out the last, possibly incomplete, period
+   */
+  ~AppDelayHistograms();
+
+  void
+  Record(const std::string& node, Ptr<App> app, bool isFirst, Time delay, uint32_t retxCount,
+         int32_t hopCount);
+
+  /**
+   * @brief Write out and reset the histograms, called by TracerRegistry every period
+   */
+  void
+  Print();
+
+private:
+  struct Slot {
+    Slot()
+      : appId(-1)
+      , prefix("all")
+      , fullDelay(DELAY_RANGE_BITS)
+      , lastDelay(DELAY_RANGE_BITS)
+      , retxCount(COUNT_RANGE_BITS)
+      , hopCount(COUNT_RANGE_BITS)
+    {
+    }
+
+    std::string node;
+    int64_t appId;
+    std::string prefix;
+
+    LogLinearHistogram fullDelay;
+    LogLinearHistogram lastDelay;
+    LogLinearHistogram retxCount;
+    LogLinearHistogram hopCount;
+  };
+
+  Slot&
+  GetSlot(const std::string& node, Ptr<App> app);
+
+  void
+  Print(const Slot& slot, const char* type, const LogLinearHistogram& histogram, double scale);
+
+private:
+  shared_ptr<TraceSink> m_sink;
+  AppDelayTracer::Aggregation m_aggregation;
+  double m_weight; // number of delays represented by a recorded one
+
+  std::map<std::string, Slot> m_slots; // ordered for a deterministic trace
+  std::unordered_map<const App*, Slot*> m_appSlots;
+};
 
 void
 AppDelayTracer::Destroy()
 {
-  g_tracers.clear();
+  TracerRegistry::Get().Remove("AppDelayTracer");
 }
 
 void
-AppDelayTracer::InstallAll(const std::string& file)
+AppDelayTracer::InstallAll(const std::string& file, TraceSink::Format format /* = TraceSink::TEXT*/,
+                           const TraceFilter& filter /* = TraceFilter()*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
+  Install(NodeContainer::GetGlobal(), file, format, filter);
+}
 
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
-    tracers.push_back(trace);
+void
+AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file,
+                        TraceSink::Format format /* = TraceSink::TEXT*/,
+                        const TraceFilter& filter /* = TraceFilter()*/)
+{
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, format);
+  if (sink == nullptr) {
+    return;
   }
+  sink->SetColumns(GetColumns());
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+  auto tracers = make_shared<std::vector<Ptr<AppDelayTracer>>>();
+  tracers->reserve(nodes.GetN());
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<AppDelayTracer> trace = Install(*node, sink);
+    if (!filter.IsAcceptingAll()) {
+      trace->SetFilter(filter);
+    }
+    tracers->push_back(trace);
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  // rows are written as delays are measured, so the group has no printer
+  TracerRegistry::Get().Add("AppDelayTracer", sink, tracers);
 }
 
 void
-AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
+AppDelayTracer::Install(Ptr<Node> node, const std::string& file,
+                        TraceSink::Format format /* = TraceSink::TEXT*/,
+                        const TraceFilter& filter /* = TraceFilter()*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
+  Install(NodeContainer(node), file, format, filter);
+}
 
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
+Ptr<AppDelayTracer>
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
+{
+  return Install(node, make_shared<TextTraceSink>(outputStream));
+}
 
-  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
-    tracers.push_back(trace);
-  }
+Ptr<AppDelayTracer>
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
+  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(sink, node);
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  return trace;
 }
 
 void
-AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
+AppDelayTracer::InstallAllHistograms(const std::string& file, Time period,
+                                     Aggregation aggregation /* = PER_APP*/,
+                                     TraceSink::Format format /* = TraceSink::TEXT*/,
+                                     const TraceFilter& filter /* = TraceFilter()*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<AppDelayTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
+  InstallHistograms(NodeContainer::GetGlobal(), file, period, aggregation, format, filter);
+}
 
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+void
+AppDelayTracer::InstallHistograms(const NodeContainer& nodes, const std::string& file,
+                                  Time period, Aggregation aggregation /* = PER_APP*/,
+                                  TraceSink::Format format /* = TraceSink::TEXT*/,
+                                  const TraceFilter& filter /* = TraceFilter()*/)
+{
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, format);
+  if (sink == nullptr) {
+    return;
   }
+  sink->SetColumns(GetHistogramColumns());
 
-  Ptr<AppDelayTracer> trace = Install(node, outputStream);
-  tracers.push_back(trace);
+  auto histograms = make_shared<AppDelayHistograms>(sink, aggregation, filter.GetWeight());
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+  auto tracers = make_shared<std::vector<Ptr<AppDelayTracer>>>();
+  tracers->reserve(nodes.GetN());
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    NS_LOG_DEBUG("Node: " << (*node)->GetId());
+    Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(histograms, *node);
+    if (!filter.IsAcceptingAll()) {
+      trace->SetFilter(filter);
+    }
+    tracers->push_back(trace);
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
-}
-
-Ptr<AppDelayTracer>
-AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
-{
-  NS_LOG_DEBUG("Node: " << node->GetId());
-
-  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(outputStream, node);
-
-  return trace;
+  // histograms are owned by the tracers
+  AppDelayHistograms* raw = histograms.get();
+  TracerRegistry::Get().Add("AppDelayTracer", sink, tracers, period,
+                            [raw] (TraceSink&) { raw->Print(); });
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -172,8 +224,20 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 //////////////////////////////////////////////////////////////////////////////
 
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : AppDelayTracer(make_shared<TextTraceSink>(os), node)
+{
+}
+
+AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
+  : m_node(node)
+  , m_sink(make_shared<TextTraceSink>(os))
+{
+  Connect();
+}
+
+AppDelayTracer::AppDelayTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
   : m_nodePtr(node)
-  , m_os(os)
+  , m_sink(sink)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -185,11 +249,18 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   }
 }
 
-AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
-  : m_node(node)
-  , m_os(os)
+AppDelayTracer::AppDelayTracer(shared_ptr<AppDelayHistograms> histograms, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_histograms(histograms)
 {
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
   Connect();
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
 }
 
 AppDelayTracer::~AppDelayTracer(){};
@@ -206,50 +277,212 @@ AppDelayTracer::Connect()
                                 MakeCallback(&AppDelayTracer::FirstInterestDataDelay, this));
 }
 
+const TraceSink::Columns&
+AppDelayTracer::GetColumns()
+{
+  static const TraceSink::Columns columns = {{"Time", TraceSink::DOUBLE},
+                                             {"Node", TraceSink::STRING},
+                                             {"AppId", TraceSink::INTEGER},
+                                             {"SeqNo", TraceSink::INTEGER},
+                                             {"Type", TraceSink::STRING},
+                                             {"DelayS", TraceSink::DOUBLE},
+                                             {"DelayUS", TraceSink::DOUBLE},
+                                             {"RetxCount", TraceSink::INTEGER},
+                                             {"HopCount", TraceSink::INTEGER}};
+  return columns;
+}
+
+const TraceSink::Columns&
+AppDelayTracer::GetHistogramColumns()
+{
+  static const TraceSink::Columns columns = {{"Time", TraceSink::DOUBLE},
+                                             {"Node", TraceSink::STRING},
+                                             {"AppId", TraceSink::INTEGER},
+                                             {"Prefix", TraceSink::STRING},
+                                             {"Type", TraceSink::STRING},
+                                             {"Count", TraceSink::INTEGER},
+                                             {"P50", TraceSink::DOUBLE},
+                                             {"P90", TraceSink::DOUBLE},
+                                             {"P99", TraceSink::DOUBLE},
+                                             {"P99.9", TraceSink::DOUBLE},
+                                             {"Max", TraceSink::DOUBLE}};
+  return columns;
+}
+
 void
 AppDelayTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-     << "Node"
-     << "\t"
-     << "AppId"
-     << "\t"
-     << "SeqNo"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "DelayS"
-     << "\t"
-     << "DelayUS"
-     << "\t"
-     << "RetxCount"
-     << "\t"
-     << "HopCount"
-     << "";
+  TraceSink::PrintColumnNames(os, GetColumns());
+}
+
+void
+AppDelayTracer::SetFilter(const TraceFilter& filter)
+{
+  if (filter.IsAcceptingAll()) {
+    m_filter.reset();
+  }
+  else {
+    m_filter.reset(new TraceFilter(filter));
+  }
+  m_acceptedApps.clear();
+}
+
+bool
+AppDelayTracer::Accept(Ptr<App> app, size_t event)
+{
+  auto accepted = m_acceptedApps.find(PeekPointer(app));
+  if (accepted == m_acceptedApps.end()) {
+    StringValue prefix("/");
+    app->GetAttributeFailSafe("Prefix", prefix);
+    accepted = m_acceptedApps.emplace(PeekPointer(app), m_filter->AcceptName(Name(prefix.Get()))).first;
+  }
+  return accepted->second && m_filter->Sample(event);
 }
 
 void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "LastDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << 1 << "\t"
-        << hopCount << "\n";
+  if (m_filter != nullptr && !Accept(app, LAST_DELAY)) {
+    return;
+  }
+
+  if (m_histograms != nullptr) {
+    m_histograms->Record(m_node, app, false, delay, 1, hopCount);
+    return;
+  }
+
+  m_sink->WriteRow(Simulator::Now().ToDouble(Time::S), m_node, app->GetId(), seqno, "LastDelay",
+                   delay.ToDouble(Time::S), delay.ToDouble(Time::US), 1, hopCount);
 }
 
 void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
-  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
-        << seqno << "\t"
-        << "FullDelay"
-        << "\t" << delay.ToDouble(Time::S) << "\t" << delay.ToDouble(Time::US) << "\t" << retxCount
-        << "\t" << hopCount << "\n";
+  if (m_filter != nullptr && !Accept(app, FULL_DELAY)) {
+    return;
+  }
+
+  if (m_histograms != nullptr) {
+    m_histograms->Record(m_node, app, true, delay, retxCount, hopCount);
+    return;
+  }
+
+  m_sink->WriteRow(Simulator::Now().ToDouble(Time::S), m_node, app->GetId(), seqno, "FullDelay",
+                   delay.ToDouble(Time::S), delay.ToDouble(Time::US), retxCount, hopCount);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+AppDelayHistograms::AppDelayHistograms(shared_ptr<TraceSink> sink,
+                                       AppDelayTracer::Aggregation aggregation, double weight)
+  : m_sink(sink)
+  , m_aggregation(aggregation)
+  , m_weight(weight)
+{
+}
+
+AppDelayHistograms::~AppDelayHistograms()
+{
+  Print();
+}
+
+AppDelayHistograms::Slot&
+AppDelayHistograms::GetSlot(const std::string& node, Ptr<App> app)
+{
+  auto cached = m_appSlots.find(PeekPointer(app));
+  if (cached != m_appSlots.end()) {
+    return *cached->second;
+  }
+
+  StringValue prefix("-");
+  app->GetAttributeFailSafe("Prefix", prefix);
+
+  std::string key;
+  switch (m_aggregation) {
+  case AppDelayTracer::PER_APP:
+    key = node + "\t" + boost::lexical_cast<std::string>(app->GetId());
+    break;
+  case AppDelayTracer::PER_NODE:
+    key = node;
+    break;
+  case AppDelayTracer::PER_PREFIX:
+    key = prefix.Get();
+    break;
+  }
+
+  Slot& slot = m_slots[key];
+  if (slot.node.empty()) {
+    slot.node = m_aggregation == AppDelayTracer::PER_PREFIX ? "all" : node;
+    if (m_aggregation == AppDelayTracer::PER_APP) {
+      slot.appId = app->GetId();
+    }
+    if (m_aggregation != AppDelayTracer::PER_NODE) {
+      slot.prefix = prefix.Get();
+    }
+  }
+
+  m_appSlots[PeekPointer(app)] = &slot;
+  return slot;
+}
+
+void
+AppDelayHistograms::Record(const std::string& node, Ptr<App> app, bool isFirst, Time delay,
+                           uint32_t retxCount, int32_t hopCount)
+{
+  Slot& slot = GetSlot(node, app);
+  uint64_t delayUs = std::max<int64_t>(delay.GetMicroSeconds(), 0);
+
+  if (!isFirst) {
+    slot.lastDelay.Record(delayUs);
+    return;
+  }
+
+  slot.fullDelay.Record(delayUs);
+  slot.retxCount.Record(retxCount);
+  if (hopCount >= 0) {
+    slot.hopCount.Record(hopCount);
+  }
+}
+
+void
+AppDelayHistograms::Print(const Slot& slot, const char* type, const LogLinearHistogram& histogram,
+                          double scale)
+{
+  if (histogram.GetCount() == 0) {
+    return;
+  }
+
+  double values[sizeof(PERCENTILES) / sizeof(PERCENTILES[0])];
+  for (size_t i = 0; i < sizeof(PERCENTILES) / sizeof(PERCENTILES[0]); i++) {
+    values[i] = histogram.GetPercentile(PERCENTILES[i]) * scale;
+  }
+
+  m_sink->WriteRow(Simulator::Now().ToDouble(Time::S), slot.node, slot.appId, slot.prefix, type,
+                   static_cast<uint64_t>(histogram.GetCount() * m_weight), values[0], values[1],
+                   values[2], values[3], histogram.GetMax() * scale);
+}
+
+void
+AppDelayHistograms::Print()
+{
+  for (auto& entry : m_slots) {
+    Slot& slot = entry.second;
+
+    // delays are reported in seconds, the same as DelayS of the per-packet trace
+    Print(slot, "FullDelay", slot.fullDelay, 1e-6);
+    Print(slot, "LastDelay", slot.lastDelay, 1e-6);
+    Print(slot, "RetxCount", slot.retxCount, 1);
+    Print(slot, "HopCount", slot.hopCount, 1);
+
+    slot.fullDelay.Reset();
+    slot.lastDelay.Reset();
+    slot.retxCount.Reset();
+    slot.hopCount.Reset();
+  }
 }
 
 } // namespace ndn
@@ -21,6 +21,8 @@
 #define CCNX_APP_DELAY_TRACER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-sink.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-filter.hpp"
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -28,8 +30,7 @@
 #include <ns3/event-id.h>
 #include <ns3/node-container.h>
 
-#include <tuple>
-#include <list>
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -39,42 +40,61 @@ class Packet;
 namespace ndn {
 
 class App;
+class AppDelayHistograms;
 
 /**
  * @ingroup ndn-tracers
  * @brief Tracer to obtain application-level delays
+ *
+ * By default, one row is written per received Data.  In the histogram mode (InstallHistograms),
+ * delays, retransmission counts, and hop counts are instead accumulated in LogLinearHistogram and
+ * summarized once per period.
  */
 class AppDelayTracer : public SimpleRefCount<AppDelayTracer> {
 public:
+  /**
+   * @brief Granularity of histograms
+   */
+  enum Aggregation {
+    PER_APP,   ///< histograms of each application
+    PER_NODE,  ///< histograms of all applications on a node
+    PER_PREFIX ///< histograms of all applications with the same Prefix attribute
+  };
+
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
    * @param file File to which traces will be written.  If filename is -, then std::out is used
-   *
+   * @param format Format of the trace file (default, tab-separated text)
+   * @param filter Selection of traced delays (default, all), see SetFilter
    */
   static void
-  InstallAll(const std::string& file);
+  InstallAll(const std::string& file, TraceSink::Format format = TraceSink::TEXT,
+             const TraceFilter& filter = TraceFilter());
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
    * @param file File to which traces will be written.  If filename is -, then std::out is used
-   *
+   * @param format Format of the trace file (default, tab-separated text)
+   * @param filter Selection of traced delays (default, all), see SetFilter
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file);
+  Install(const NodeContainer& nodes, const std::string& file,
+          TraceSink::Format format = TraceSink::TEXT, const TraceFilter& filter = TraceFilter());
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
    * @param file File to which traces will be written.  If filename is -, then std::out is used
-   * @param averagingPeriod How often data will be written into the trace file (default, every half
-   *        second)
+   * @param format Format of the trace file (default, tab-separated text)
+   * @param filter Selection of traced delays (default, all), see SetFilter
    */
   static void
-  Install(Ptr<Node> node, const std::string& file);
+  Install(Ptr<Node> node, const std::string& file, TraceSink::Format format = TraceSink::TEXT,
+          const TraceFilter& filter = TraceFilter());
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -91,6 +111,58 @@ public:
   static Ptr<AppDelayTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param sink Sink of the trace, its columns should be set to GetColumns()
+   */
+  static Ptr<AppDelayTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink);
+
+  /**
+   * @brief Helper method to install tracers summarizing delays on all simulation nodes
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param period How often the histograms are written into the trace file and reset
+   * @param aggregation Granularity of the histograms
+   * @param format Format of the trace file (default, tab-separated text)
+   * @param filter Selection of traced delays (default, all), see SetFilter.  Counts are
+   *        multiplied by its sampling factor
+   */
+  static void
+  InstallAllHistograms(const std::string& file, Time period, Aggregation aggregation = PER_APP,
+                       TraceSink::Format format = TraceSink::TEXT,
+                       const TraceFilter& filter = TraceFilter());
+
+  /**
+   * @brief Helper method to install tracers summarizing delays on the selected simulation nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param period How often the histograms are written into the trace file and reset
+   * @param aggregation Granularity of the histograms
+   * @param format Format of the trace file (default, tab-separated text)
+   * @param filter Selection of traced delays (default, all), see SetFilter.  Counts are
+   *        multiplied by its sampling factor
+   */
+  static void
+  InstallHistograms(const NodeContainer& nodes, const std::string& file, Time period,
+                    Aggregation aggregation = PER_APP, TraceSink::Format format = TraceSink::TEXT,
+                    const TraceFilter& filter = TraceFilter());
+
+  /**
+   * @brief Get columns of the trace
+   */
+  static const TraceSink::Columns&
+  GetColumns();
+
+  /**
+   * @brief Get columns of the trace in the histogram mode
+   */
+  static const TraceSink::Columns&
+  GetHistogramColumns();
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -114,6 +186,20 @@ public:
    */
   AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to all applications on the node using node's pointer
+   * @param sink  sink of the trace
+   * @param node  pointer to the node
+   */
+  AppDelayTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
+  /**
+   * @brief Trace constructor that attaches to all applications on the node using node's pointer
+   * @param histograms  histograms shared by tracers of one InstallHistograms call
+   * @param node        pointer to the node
+   */
+  AppDelayTracer(shared_ptr<AppDelayHistograms> histograms, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -127,10 +213,22 @@ public:
   void
   PrintHeader(std::ostream& os) const;
 
+  /**
+   * @brief Trace only delays accepted by the filter
+   *
+   * Prefixes of the filter are matched against the Prefix attribute of the applications, and its
+   * faces are ignored.
+   */
+  void
+  SetFilter(const TraceFilter& filter);
+
 private:
   void
   Connect();
 
+  bool
+  Accept(Ptr<App> app, size_t event);
+
   void
   LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
 
@@ -142,7 +240,11 @@ private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
+  shared_ptr<AppDelayHistograms> m_histograms; // set only in the histogram mode
+
+  std::unique_ptr<TraceFilter> m_filter;
+  std::unordered_map<const App*, bool> m_acceptedApps; // whether Prefix of the app is accepted
 };
 
 } // namespace ndn
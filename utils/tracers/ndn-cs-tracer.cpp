@@ -23,160 +23,121 @@
 #include "ns3/config.h"
 #include "ns3/names.h"
 #include "ns3/callback.h"
+#include "ns3/boolean.h"
 
 #include "apps/ndn-app.hpp"
 #include "model/cs/ndn-content-store.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "utils/tracers/ndn-tracer-registry.hpp"
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
 
 #include <boost/lexical_cast.hpp>
 
-#include <fstream>
+#include <algorithm>
+
 
 NS_LOG_COMPONENT_DEFINE("ndn.CsTracer");
 
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<CsTracer>>>> g_tracers;
-
 void
 CsTracer::Destroy()
 {
-  g_tracers.clear();
+  TracerRegistry::Get().Remove("CsTracer");
 }
 
 void
-CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/,
+                     TraceSink::Format format /* = TraceSink::TEXT*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
-  }
-
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  Install(NodeContainer::GetGlobal(), file, averagingPeriod, format);
 }
 
 void
 CsTracer::Install(const NodeContainer& nodes, const std::string& file,
-                  Time averagingPeriod /* = Seconds (0.5)*/)
+                  Time averagingPeriod /* = Seconds (0.5)*/,
+                  TraceSink::Format format /* = TraceSink::TEXT*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, format);
+  if (sink == nullptr) {
+    return;
   }
+  sink->SetColumns(GetColumns());
 
+  auto tracers = make_shared<std::vector<Ptr<CsTracer>>>();
+  tracers->reserve(nodes.GetN());
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
+    NS_LOG_DEBUG("Node: " << (*node)->GetId());
+    tracers->push_back(Create<CsTracer>(sink, *node));
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  Register(sink, tracers, averagingPeriod);
 }
 
 void
 CsTracer::Install(Ptr<Node> node, const std::string& file,
-                  Time averagingPeriod /* = Seconds (0.5)*/)
+                  Time averagingPeriod /* = Seconds (0.5)*/,
+                  TraceSink::Format format /* = TraceSink::TEXT*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<CsTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  Ptr<CsTracer> trace = Install(node, outputStream, averagingPeriod);
-  tracers.push_back(trace);
-
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  Install(NodeContainer(node), file, averagingPeriod, format);
 }
 
 Ptr<CsTracer>
 CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
                   Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  return Install(node, make_shared<TextTraceSink>(outputStream), averagingPeriod);
+}
+
+Ptr<CsTracer>
+CsTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink,
+                  Time averagingPeriod /* = Seconds (0.5)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<CsTracer> trace = Create<CsTracer>(outputStream, node);
-  trace->SetAveragingPeriod(averagingPeriod);
+  Ptr<CsTracer> trace = Create<CsTracer>(sink, node);
+  Register(sink, make_shared<std::vector<Ptr<CsTracer>>>(1, trace), averagingPeriod);
 
   return trace;
 }
 
+void
+CsTracer::Register(shared_ptr<TraceSink> sink, shared_ptr<std::vector<Ptr<CsTracer>>> tracers,
+                   Time averagingPeriod)
+{
+  const std::vector<Ptr<CsTracer>>* group = tracers.get();
+  TracerRegistry::Get().Add("CsTracer", sink, tracers, averagingPeriod,
+                            [group] (TraceSink& sink) {
+                              for (const auto& trace : *group) {
+                                trace->Print(sink);
+                                trace->Reset();
+                              }
+                            });
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
 CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : CsTracer(make_shared<TextTraceSink>(os), node)
+{
+}
+
+CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
+  : m_node(node)
+  , m_nodePtr(Names::Find<Node>(node))
+  , m_sink(make_shared<TextTraceSink>(os))
+{
+  Connect();
+}
+
+CsTracer::CsTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
   : m_nodePtr(node)
-  , m_os(os)
+  , m_sink(sink)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -188,74 +149,83 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   }
 }
 
-CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
-  : m_node(node)
-  , m_os(os)
-{
-  Connect();
-}
-
 CsTracer::~CsTracer(){};
 
 void
 CsTracer::Connect()
 {
-  Ptr<ContentStore> cs = m_nodePtr->GetObject<ContentStore>();
-  cs->TraceConnectWithoutContext("CacheHits", MakeCallback(&CsTracer::CacheHits, this));
-  cs->TraceConnectWithoutContext("CacheMisses", MakeCallback(&CsTracer::CacheMisses, this));
+  m_cs = m_nodePtr->GetObject<ContentStore>();
+  if (m_cs != nullptr) {
+    m_cs->TraceConnectWithoutContext("CacheHits", MakeCallback(&CsTracer::CacheHits, this));
+    m_cs->TraceConnectWithoutContext("CacheMisses", MakeCallback(&CsTracer::CacheMisses, this));
+    m_cs->TraceConnectWithoutContext("DidAddEntry", MakeCallback(&CsTracer::DidAddEntry, this));
+  }
+  else {
+    // NFD content store: events are reported by L3Protocol
+    Ptr<L3Protocol> l3 = L3Protocol::getL3Protocol(m_nodePtr);
+    l3->SetAttribute("CsTracing", BooleanValue(true));
+
+    l3->TraceConnectWithoutContext("CsHits", MakeCallback(&CsTracer::CsHits, this));
+    l3->TraceConnectWithoutContext("CsMisses", MakeCallback(&CsTracer::CsMisses, this));
+    l3->TraceConnectWithoutContext("CsInserts", MakeCallback(&CsTracer::CsInserts, this));
+    l3->TraceConnectWithoutContext("CsEvictions", MakeCallback(&CsTracer::CsEvictions, this));
+  }
 
   Reset();
 }
 
-void
-CsTracer::SetAveragingPeriod(const Time& period)
+const TraceSink::Columns&
+CsTracer::GetColumns()
 {
-  m_period = period;
-  m_printEvent.Cancel();
-  m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
-}
-
-void
-CsTracer::PeriodicPrinter()
-{
-  Print(*m_os);
-  Reset();
-
-  m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
+  static const TraceSink::Columns columns = {{"Time", TraceSink::DOUBLE},
+                                             {"Node", TraceSink::STRING},
+                                             {"Type", TraceSink::STRING},
+                                             {"Packets", TraceSink::DOUBLE}};
+  return columns;
 }
 
 void
 CsTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t";
+  TraceSink::PrintColumnNames(os, GetColumns());
 }
 
 void
 CsTracer::Reset()
 {
   m_stats.Reset();
+
+  if (m_cs != nullptr) {
+    m_csSize = m_cs->GetSize();
+  }
 }
 
-#define PRINTER(printName, fieldName)                                                              \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << printName << "\t" << m_stats.fieldName \
-     << "\n";
+#define PRINTER(printName, fieldName) sink.WriteRow(time, m_node, printName, m_stats.fieldName);
 
 void
 CsTracer::Print(std::ostream& os) const
 {
-  Time time = Simulator::Now();
+  TextTraceSink sink(shared_ptr<std::ostream>(&os, std::bind([]{})));
+  Print(sink);
+}
+
+void
+CsTracer::Print(TraceSink& sink) const
+{
+  double time = Simulator::Now().ToDouble(Time::S);
 
   PRINTER("CacheHits", m_cacheHits);
   PRINTER("CacheMisses", m_cacheMisses);
+  PRINTER("CacheInserts", m_cacheInserts);
+
+  if (m_cs != nullptr) {
+    // ndnSIM ContentStore does not report replacements, so they are derived from its size change
+    double growth = static_cast<double>(m_cs->GetSize()) - m_csSize;
+    sink.WriteRow(time, m_node, "CacheEvictions", std::max(m_stats.m_cacheInserts - growth, 0.0));
+  }
+  else {
+    PRINTER("CacheEvictions", m_cacheEvictions);
+  }
 }
 
 void
@@ -270,5 +240,35 @@ CsTracer::CacheMisses(shared_ptr<const Interest>)
   m_stats.m_cacheMisses++;
 }
 
+void
+CsTracer::DidAddEntry(Ptr<const cs::Entry>)
+{
+  m_stats.m_cacheInserts++;
+}
+
+void
+CsTracer::CsHits(const Interest&, const Data&)
+{
+  m_stats.m_cacheHits++;
+}
+
+void
+CsTracer::CsMisses(const Interest&)
+{
+  m_stats.m_cacheMisses++;
+}
+
+void
+CsTracer::CsInserts(const Data&)
+{
+  m_stats.m_cacheInserts++;
+}
+
+void
+CsTracer::CsEvictions(const Data&)
+{
+  m_stats.m_cacheEvictions++;
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -21,6 +21,7 @@
 #define CCNX_CS_TRACER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-sink.hpp"
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -28,9 +29,8 @@
 #include <ns3/event-id.h>
 #include <ns3/node-container.h>
 
-#include <tuple>
 #include <map>
-#include <list>
+#include <vector>
 
 namespace ns3 {
 
@@ -39,8 +39,12 @@ class Packet;
 
 namespace ndn {
 
+class ContentStore;
+
 namespace cs {
 
+class Entry;
+
 /// @cond include_hidden
 struct Stats {
   inline void
@@ -48,16 +52,23 @@ struct Stats {
   {
     m_cacheHits = 0;
     m_cacheMisses = 0;
+    m_cacheInserts = 0;
+    m_cacheEvictions = 0;
   }
   double m_cacheHits;
   double m_cacheMisses;
+  double m_cacheInserts;
+  double m_cacheEvictions;
 };
 /// @endcond
 }
 
 /**
  * @ingroup ndn-tracers
- * @brief NDN tracer for cache performance (hits and misses)
+ * @brief NDN tracer for cache performance (hits, misses, insertions, and evictions)
+ *
+ * Attaches to the ndnSIM ContentStore if the node has one (StackHelper::SetOldContentStore), and
+ * to the content store of NFD otherwise, enabling CsTracing attribute of L3Protocol.
  */
 class CsTracer : public SimpleRefCount<CsTracer> {
 public:
@@ -67,14 +78,11 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
-   *
-   * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
-   *tuple needs to be preserved
-   *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
-   *
+   * @param format Format of the trace file (default, tab-separated text)
    */
   static void
-  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5),
+             TraceSink::Format format = TraceSink::TEXT);
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
@@ -83,14 +91,11 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
-   *
-   * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
-   *tuple needs to be preserved
-   *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
-   *
+   * @param format Format of the trace file (default, tab-separated text)
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          TraceSink::Format format = TraceSink::TEXT);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -99,14 +104,11 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
-   *
-   * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
-   *tuple needs to be preserved
-   *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
-   *
+   * @param format Format of the trace file (default, tab-separated text)
    */
   static void
-  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          TraceSink::Format format = TraceSink::TEXT);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -124,6 +126,23 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param sink Sink of the trace, its columns should be set to GetColumns()
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *second)
+   */
+  static Ptr<CsTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time averagingPeriod = Seconds(0.5));
+
+  /**
+   * @brief Get columns of the trace
+   */
+  static const TraceSink::Columns&
+  GetColumns();
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -147,6 +166,13 @@ public:
    */
   CsTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param sink  sink of the trace
+   * @param node  pointer to the node
+   */
+  CsTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -168,6 +194,12 @@ public:
   void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write current trace data to the sink
+   */
+  void
+  Print(TraceSink& sink) const;
+
 private:
   void
   Connect();
@@ -178,25 +210,42 @@ private:
   void
   CacheMisses(shared_ptr<const Interest>);
 
-private:
   void
-  SetAveragingPeriod(const Time& period);
+  DidAddEntry(Ptr<const cs::Entry>);
 
   void
-  Reset();
+  CsHits(const Interest&, const Data&);
 
   void
-  PeriodicPrinter();
+  CsMisses(const Interest&);
+
+  void
+  CsInserts(const Data&);
+
+  void
+  CsEvictions(const Data&);
+
+private:
+  /**
+   * @brief Register the tracers with TracerRegistry, which prints them every averaging period
+   */
+  static void
+  Register(shared_ptr<TraceSink> sink, shared_ptr<std::vector<Ptr<CsTracer>>> tracers,
+           Time averagingPeriod);
+
+  void
+  Reset();
 
 private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
 
-  Time m_period;
-  EventId m_printEvent;
   cs::Stats m_stats;
+
+  Ptr<ContentStore> m_cs; // ContentStore of ndnSIM, if installed on the node
+  uint32_t m_csSize;      // its size at the beginning of the averaging period
 };
 
 /**
@@ -0,0 +1,465 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-hop-delay-tracer.hpp"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/tag.h"
+#include "ns3/names.h"
+#include "ns3/callback.h"
+#include "ns3/data-rate.h"
+#include "ns3/net-device.h"
+
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/model/ndn-net-device-transport.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-tracer-registry.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <array>
+
+NS_LOG_COMPONENT_DEFINE("ndn.HopDelayTracer");
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Packet tag referring to the path of a traced packet in flight
+ *
+ * The paths are kept in a ring indexed by the id of the tag.  Path of a packet that was not
+ * received before its slot got reused (e.g., dropped by a queue) is simply not traced further.
+ */
+class HopDelayTag : public ns3::Tag {
+public:
+  static TypeId
+  GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::ndn::HopDelayTag")
+                          .SetGroupName("Ndn")
+                          .SetParent<ns3::Tag>()
+                          .AddConstructor<HopDelayTag>();
+    return tid;
+  }
+
+  explicit HopDelayTag(uint32_t id = 0)
+    : m_id(id)
+  {
+  }
+
+  uint32_t
+  GetId() const
+  {
+    return m_id;
+  }
+
+  virtual TypeId
+  GetInstanceTypeId() const
+  {
+    return GetTypeId();
+  }
+
+  virtual uint32_t
+  GetSerializedSize() const
+  {
+    return sizeof(m_id);
+  }
+
+  virtual void
+  Serialize(TagBuffer i) const
+  {
+    i.WriteU32(m_id);
+  }
+
+  virtual void
+  Deserialize(TagBuffer i)
+  {
+    m_id = i.ReadU32();
+  }
+
+  virtual void
+  Print(std::ostream& os) const
+  {
+    os << "Path=" << m_id;
+  }
+
+private:
+  uint32_t m_id;
+};
+
+NS_OBJECT_ENSURE_REGISTERED(HopDelayTag);
+
+// number of paths in flight, power of two
+static const size_t IN_FLIGHT_SIZE = 4096;
+
+struct InFlight {
+  uint32_t id;
+  shared_ptr<HopDelayTracer::Path> path;
+};
+
+static std::array<InFlight, IN_FLIGHT_SIZE> g_inFlight;
+static uint32_t g_lastTagId = 0;
+static uint64_t g_lastPathId = 0;
+
+static shared_ptr<HopDelayTracer::Path>
+FindInFlight(Ptr<const Packet> packet)
+{
+  HopDelayTag tag;
+  if (!packet->PeekPacketTag(tag)) {
+    return nullptr;
+  }
+
+  InFlight& slot = g_inFlight[tag.GetId() & (IN_FLIGHT_SIZE - 1)];
+  if (slot.id != tag.GetId()) {
+    return nullptr;
+  }
+  return slot.path;
+}
+
+static std::string
+GetNodeName(uint32_t id)
+{
+  std::string name = Names::FindName(NodeList::GetNode(id));
+  if (name.empty()) {
+    name = boost::lexical_cast<std::string>(id);
+  }
+  return name;
+}
+
+void
+HopDelayTracer::Destroy()
+{
+  TracerRegistry::Get().Remove("HopDelayTracer");
+  g_inFlight.fill(InFlight{0, nullptr});
+  g_lastTagId = 0;
+  g_lastPathId = 0;
+}
+
+void
+HopDelayTracer::InstallAll(const std::string& file, TraceSink::Format format /* = TraceSink::TEXT*/,
+                           const TraceFilter& filter /* = TraceFilter()*/)
+{
+  Install(NodeContainer::GetGlobal(), file, format, filter);
+}
+
+void
+HopDelayTracer::Install(const NodeContainer& nodes, const std::string& file,
+                        TraceSink::Format format /* = TraceSink::TEXT*/,
+                        const TraceFilter& filter /* = TraceFilter()*/)
+{
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, format);
+  if (sink == nullptr) {
+    return;
+  }
+  sink->SetColumns(GetColumns());
+
+  auto tracers = make_shared<std::vector<Ptr<HopDelayTracer>>>();
+  tracers->reserve(nodes.GetN());
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    if ((*node)->GetObject<L3Protocol>() == nullptr) {
+      continue;
+    }
+    tracers->push_back(Install(*node, sink, filter));
+  }
+
+  // rows are written as Data packets reach the consumers, so the group has no printer
+  TracerRegistry::Get().Add("HopDelayTracer", sink, tracers);
+}
+
+Ptr<HopDelayTracer>
+HopDelayTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink,
+                        const TraceFilter& filter /* = TraceFilter()*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  return Create<HopDelayTracer>(sink, node, filter);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+HopDelayTracer::HopDelayTracer(shared_ptr<TraceSink> sink, Ptr<Node> node,
+                               const TraceFilter& filter)
+  : m_nodePtr(node)
+  , m_l3(node->GetObject<L3Protocol>())
+  , m_sink(sink)
+  , m_filter(filter)
+  , m_isReceiving(false)
+  , m_pendingFace(nfd::face::INVALID_FACEID)
+{
+  NS_ASSERT_MSG(m_l3 != nullptr, "NDN stack should be installed on the node");
+
+  m_node = boost::lexical_cast<std::string>(node->GetId());
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+
+  // afterSend signals of the link service, and so these trace sources, precede sending the
+  // packet through the transport
+  m_l3->TraceConnectWithoutContext("OutInterests", MakeCallback(&HopDelayTracer::OutInterests,
+                                                                this));
+  m_l3->TraceConnectWithoutContext("OutData", MakeCallback(&HopDelayTracer::OutData, this));
+
+  for (const auto& face : m_l3->getForwarder()->getFaceTable()) {
+    auto transport = dynamic_cast<NetDeviceTransport*>(face.getTransport());
+    if (transport == nullptr) {
+      continue;
+    }
+
+    nfd::FaceId faceId = face.getId();
+    FaceHook& hook = m_faces[faceId];
+    hook.device = transport->GetNetDevice();
+
+    DataRateValue rate;
+    hook.bitRate = 0;
+    if (hook.device->GetAttributeFailSafe("DataRate", rate)) {
+      hook.bitRate = rate.Get().GetBitRate();
+    }
+
+    // devices without the trace source report queueing and transmission as propagation
+    hook.device->TraceConnectWithoutContext("PhyTxBegin",
+                                            MakeCallback(&HopDelayTracer::PhyTxBegin, this));
+
+    hook.connections.emplace_back(transport->beforeSendPacket.connect(
+      [this, faceId] (Ptr<const Packet> packet) { BeforeSendPacket(faceId, packet); }));
+    hook.connections.emplace_back(transport->beforeReceivePacket.connect(
+      [this] (Ptr<const Packet> packet) { BeforeReceivePacket(packet); }));
+    hook.connections.emplace_back(transport->afterReceivePacket.connect(
+      [this] (Ptr<const Packet> packet) { AfterReceivePacket(packet); }));
+  }
+}
+
+HopDelayTracer::~HopDelayTracer()
+{
+  m_l3->TraceDisconnectWithoutContext("OutInterests", MakeCallback(&HopDelayTracer::OutInterests,
+                                                                   this));
+  m_l3->TraceDisconnectWithoutContext("OutData", MakeCallback(&HopDelayTracer::OutData, this));
+
+  for (const auto& hook : m_faces) {
+    hook.second.device->TraceDisconnectWithoutContext("PhyTxBegin",
+                                                      MakeCallback(&HopDelayTracer::PhyTxBegin,
+                                                                   this));
+  }
+}
+
+const TraceSink::Columns&
+HopDelayTracer::GetColumns()
+{
+  static const TraceSink::Columns columns = {{"Time", TraceSink::DOUBLE},
+                                             {"Node", TraceSink::STRING},
+                                             {"PathId", TraceSink::INTEGER},
+                                             {"Hop", TraceSink::INTEGER},
+                                             {"HopNode", TraceSink::STRING},
+                                             {"FaceId", TraceSink::INTEGER},
+                                             {"Type", TraceSink::STRING},
+                                             {"Residence", TraceSink::DOUBLE},
+                                             {"Queueing", TraceSink::DOUBLE},
+                                             {"Transmission", TraceSink::DOUBLE},
+                                             {"Propagation", TraceSink::DOUBLE}};
+  return columns;
+}
+
+void
+HopDelayTracer::PrintHeader(std::ostream& os) const
+{
+  TraceSink::PrintColumnNames(os, GetColumns());
+}
+
+const std::string&
+HopDelayTracer::MakeKey(const Name& name)
+{
+  m_key.clear();
+  for (const auto& component : name) {
+    m_key.append(reinterpret_cast<const char*>(component.wire()), component.size());
+  }
+  return m_key;
+}
+
+void
+HopDelayTracer::OutInterests(const Interest& interest, const Face& face)
+{
+  m_pending.reset();
+
+  if (m_faces.count(face.getId()) == 0) {
+    if (m_current == nullptr) {
+      return;
+    }
+
+    // delivered to a local application, the path continues with the Data it sends
+    Time now = Simulator::Now();
+    while (!m_deliveredExpiry.empty() && m_deliveredExpiry.front().first <= now) {
+      auto entry = m_delivered.find(m_deliveredExpiry.front().second);
+      if (entry != m_delivered.end() && entry->second.expiry <= now) {
+        m_delivered.erase(entry);
+      }
+      m_deliveredExpiry.pop_front();
+    }
+
+    Time expiry = now + MilliSeconds(interest.getInterestLifetime().count());
+    m_delivered[MakeKey(interest.getName())] = Delivered{m_current, expiry};
+    m_deliveredExpiry.emplace_back(expiry, m_key);
+    return;
+  }
+
+  shared_ptr<Path> path;
+  if (m_isReceiving) {
+    if (m_current == nullptr) {
+      return;
+    }
+    path = make_shared<Path>(*m_current);
+  }
+  else {
+    // sent by the node on its own
+    if (!m_filter.Accept(0, interest.getName(), &face)) {
+      return;
+    }
+    path = make_shared<Path>();
+    path->id = ++g_lastPathId;
+  }
+  AddHop(path, face, false);
+}
+
+void
+HopDelayTracer::OutData(const Data& data, const Face& face)
+{
+  m_pending.reset();
+
+  if (m_faces.count(face.getId()) == 0) {
+    if (m_current != nullptr) {
+      WritePath(*m_current);
+    }
+    return;
+  }
+
+  shared_ptr<Path> path;
+  if (m_isReceiving) {
+    if (m_current == nullptr) {
+      return;
+    }
+    path = make_shared<Path>(*m_current);
+  }
+  else {
+    // sent by a local application
+    auto entry = m_delivered.find(MakeKey(data.getName()));
+    if (entry == m_delivered.end()) {
+      return;
+    }
+    path = make_shared<Path>(*entry->second.path);
+    m_delivered.erase(entry);
+  }
+  AddHop(path, face, true);
+}
+
+void
+HopDelayTracer::AddHop(shared_ptr<Path> path, const Face& face, bool isData)
+{
+  Time now = Simulator::Now();
+  path->hops.push_back(Hop{m_nodePtr->GetId(), face.getId(), isData, now, now, Time(0), now});
+
+  m_pending = path;
+  m_pendingFace = face.getId();
+}
+
+void
+HopDelayTracer::BeforeSendPacket(nfd::FaceId face, Ptr<const Packet> packet)
+{
+  if (m_pending == nullptr || m_pendingFace != face) {
+    return;
+  }
+
+  uint32_t id = ++g_lastTagId;
+  if (id == 0) {
+    id = ++g_lastTagId; // 0 marks unused slots
+  }
+
+  InFlight& slot = g_inFlight[id & (IN_FLIGHT_SIZE - 1)];
+  slot.id = id;
+  slot.path = std::move(m_pending);
+  m_pending.reset();
+
+  packet->AddPacketTag(HopDelayTag(id));
+}
+
+void
+HopDelayTracer::PhyTxBegin(Ptr<const Packet> packet)
+{
+  shared_ptr<Path> path = FindInFlight(packet);
+  if (path == nullptr) {
+    return;
+  }
+
+  Hop& hop = path->hops.back();
+  hop.txBegin = Simulator::Now();
+
+  auto hook = m_faces.find(hop.face);
+  if (hook != m_faces.end() && hook->second.bitRate > 0) {
+    hop.txTime = Seconds(packet->GetSize() * 8.0 / hook->second.bitRate);
+  }
+}
+
+void
+HopDelayTracer::BeforeReceivePacket(Ptr<const Packet> packet)
+{
+  m_isReceiving = true;
+  m_current.reset();
+
+  shared_ptr<const Path> path = FindInFlight(packet);
+  if (path == nullptr) {
+    return;
+  }
+
+  // a copy, as several nodes can receive the packet on a shared medium
+  auto current = make_shared<Path>(*path);
+  current->hops.back().received = Simulator::Now();
+  m_current = current;
+}
+
+void
+HopDelayTracer::AfterReceivePacket(Ptr<const Packet> packet)
+{
+  m_isReceiving = false;
+  m_current.reset();
+}
+
+void
+HopDelayTracer::WritePath(const Path& path)
+{
+  double time = Simulator::Now().ToDouble(Time::S);
+
+  for (size_t i = 0; i < path.hops.size(); i++) {
+    const Hop& hop = path.hops[i];
+    Time residence = i > 0 ? hop.sent - path.hops[i - 1].received : Time(0);
+    Time queueing = hop.txBegin - hop.sent;
+    Time propagation = hop.received - hop.txBegin - hop.txTime;
+
+    m_sink->WriteRow(time, m_node, path.id, i, GetNodeName(hop.node), hop.face,
+                     hop.isData ? "Data" : "Interest", residence.ToDouble(Time::S),
+                     queueing.ToDouble(Time::S), hop.txTime.ToDouble(Time::S),
+                     propagation.ToDouble(Time::S));
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
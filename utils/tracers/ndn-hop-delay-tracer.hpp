@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_HOP_DELAY_TRACER_H
+#define NDN_HOP_DELAY_TRACER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-sink.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-filter.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include <ns3/nstime.h>
+#include <ns3/node-container.h>
+
+#include <ndn-cxx/util/signal.hpp>
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+class Packet;
+class NetDevice;
+
+namespace ndn {
+
+class L3Protocol;
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Tracer decomposing the delay of sampled packets hop by hop
+ *
+ * A path record is started for sampled Interests sent by a node on its own (e.g., by a consumer)
+ * and extended with one hop each time the Interest, and then the Data answering it, crosses a
+ * NetDevice.  The record is carried over links in an ns-3 packet tag and through the forwarder
+ * of each traced node.  When Data with a record is delivered to a local application, one row per
+ * hop is written with the time the packet spent in the node before being sent, waiting in the
+ * queue of the NetDevice, being transmitted, and propagating to the next node.
+ *
+ * Paths are followed only through the traced nodes, and Interests released later by a node
+ * (e.g., from a buffer) start new paths.
+ */
+class HopDelayTracer : public SimpleRefCount<HopDelayTracer> {
+public:
+  /**
+   * @brief Helper method to install tracers on all simulation nodes
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param format Format of the trace file (default, tab-separated text)
+   * @param filter Selection of Interests starting traced paths (default, all), use
+   *        TraceFilter::SetSampling to bound the overhead
+   */
+  static void
+  InstallAll(const std::string& file, TraceSink::Format format = TraceSink::TEXT,
+             const TraceFilter& filter = TraceFilter());
+
+  /**
+   * @brief Helper method to install tracers on the selected simulation nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param format Format of the trace file (default, tab-separated text)
+   * @param filter Selection of Interests starting traced paths (default, all)
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file,
+          TraceSink::Format format = TraceSink::TEXT, const TraceFilter& filter = TraceFilter());
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param sink Sink of the trace, its columns should be set to GetColumns()
+   * @param filter Selection of Interests starting traced paths (default, all)
+   */
+  static Ptr<HopDelayTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, const TraceFilter& filter = TraceFilter());
+
+  /**
+   * @brief Get columns of the trace
+   */
+  static const TraceSink::Columns&
+  GetColumns();
+
+  /**
+   * @brief Explicit request to remove all statically created tracers
+   *
+   * This method can be helpful if simulation scenario contains several independent run,
+   * or if it is desired to do a postprocessing of the resulting data
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Trace constructor that attaches to the node and its NetDevice faces
+   * @param sink   sink of the trace
+   * @param node   pointer to the node
+   * @param filter selection of Interests starting traced paths
+   */
+  HopDelayTracer(shared_ptr<TraceSink> sink, Ptr<Node> node, const TraceFilter& filter);
+
+  /**
+   * @brief Destructor
+   */
+  ~HopDelayTracer();
+
+  /**
+   * @brief Print head of the trace (e.g., for post-processing)
+   *
+   * @param os reference to output stream
+   */
+  void
+  PrintHeader(std::ostream& os) const;
+
+public:
+  /**
+   * @brief Passage of a packet over one link
+   */
+  struct Hop {
+    uint32_t node;      ///< id of the sending node
+    nfd::FaceId face;   ///< outgoing face
+    bool isData;        ///< Data or Interest
+    Time sent;          ///< when the packet was passed to the NetDevice
+    Time txBegin;       ///< when the NetDevice started the transmission
+    Time txTime;        ///< serialization time
+    Time received;      ///< when the next node received the packet
+  };
+
+  /**
+   * @brief Hops of a sampled Interest and of the Data answering it
+   */
+  struct Path {
+    uint64_t id;
+    std::vector<Hop> hops;
+  };
+
+private:
+  void
+  OutInterests(const Interest& interest, const Face& face);
+
+  void
+  OutData(const Data& data, const Face& face);
+
+  void
+  BeforeSendPacket(nfd::FaceId face, Ptr<const Packet> packet);
+
+  void
+  BeforeReceivePacket(Ptr<const Packet> packet);
+
+  void
+  AfterReceivePacket(Ptr<const Packet> packet);
+
+  void
+  PhyTxBegin(Ptr<const Packet> packet);
+
+  /**
+   * @brief Extend the path with a hop over the face, to be tagged in BeforeSendPacket
+   */
+  void
+  AddHop(shared_ptr<Path> path, const Face& face, bool isData);
+
+  void
+  WritePath(const Path& path);
+
+  const std::string&
+  MakeKey(const Name& name);
+
+private:
+  std::string m_node;
+  Ptr<Node> m_nodePtr;
+  Ptr<L3Protocol> m_l3;
+
+  shared_ptr<TraceSink> m_sink;
+  TraceFilter m_filter;
+
+  struct FaceHook {
+    Ptr<NetDevice> device;
+    uint64_t bitRate; ///< DataRate of the NetDevice, or 0 if unknown
+    std::vector< ::ndn::util::signal::ScopedConnection> connections;
+  };
+  std::unordered_map<nfd::FaceId, FaceHook> m_faces; // faces on NetDevices
+
+  bool m_isReceiving;               // inside processing of a packet received from a NetDevice
+  shared_ptr<const Path> m_current; // path of that packet, if traced
+
+  nfd::FaceId m_pendingFace; // face of the hop added last and not yet tagged
+  shared_ptr<Path> m_pending;
+
+  struct Delivered {
+    shared_ptr<const Path> path;
+    Time expiry;
+  };
+  // traced Interests delivered to local applications, by name, waiting for Data
+  std::unordered_map<std::string, Delivered> m_delivered;
+  std::deque<std::pair<Time, std::string>> m_deliveredExpiry;
+  std::string m_key; // reusable buffer for names of delivered Interests
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_HOP_DELAY_TRACER_H
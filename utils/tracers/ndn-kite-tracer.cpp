@@ -0,0 +1,328 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-kite-tracer.hpp"
+#include "ns3/node.h"
+#include "ns3/config.h"
+#include "ns3/names.h"
+#include "ns3/callback.h"
+
+#include "apps/ndn-app.hpp"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "ns3/ndnSIM/utils/tracers/ndn-tracer-registry.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.KiteTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static const unsigned DELAY_RANGE_BITS = 32; // in microseconds, over an hour
+
+static uint64_t
+toMicroSeconds(Time delay)
+{
+  return std::max<int64_t>(delay.GetMicroSeconds(), 0);
+}
+
+void
+KiteTracer::Destroy()
+{
+  TracerRegistry::Get().Remove("KiteTracer");
+}
+
+void
+KiteTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (1.0)*/,
+                       TraceSink::Format format /* = TraceSink::TEXT*/)
+{
+  Install(NodeContainer::GetGlobal(), file, averagingPeriod, format);
+}
+
+void
+KiteTracer::Install(const NodeContainer& nodes, const std::string& file,
+                    Time averagingPeriod /* = Seconds (1.0)*/,
+                    TraceSink::Format format /* = TraceSink::TEXT*/)
+{
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, format);
+  if (sink == nullptr) {
+    return;
+  }
+  sink->SetColumns(GetColumns());
+
+  Ptr<KiteTracer> tracer = Create<KiteTracer>(sink);
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    tracer->Connect(*node);
+  }
+
+  KiteTracer* raw = PeekPointer(tracer);
+  TracerRegistry::Get().Add("KiteTracer", sink, make_shared<Ptr<KiteTracer>>(tracer),
+                            averagingPeriod, [raw] (TraceSink&) { raw->Print(); });
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+KiteTracer::MobileProducer::MobileProducer()
+  : handoff(false)
+  , traceSent(Seconds(-1))
+  , traceConfirmed(Seconds(-1))
+  , bufferQueued(Seconds(-1))
+  , bufferFlushed(Seconds(-1))
+{
+}
+
+KiteTracer::KiteTracer(shared_ptr<TraceSink> sink)
+  : m_sink(sink)
+  , m_nHandoffs(0)
+  , m_handoffLatency(DELAY_RANGE_BITS)
+  , m_traceSetup(DELAY_RANGE_BITS)
+  , m_bufferWait(DELAY_RANGE_BITS)
+{
+}
+
+KiteTracer::~KiteTracer()
+{
+}
+
+void
+KiteTracer::Connect(Ptr<Node> node)
+{
+  std::string path = "/NodeList/" + boost::lexical_cast<std::string>(node->GetId())
+                     + "/ApplicationList/*/";
+
+  for (const std::string& mobile : {"$ns3::ndn::KitePullMobile/", "$ns3::ndn::KiteUploadMobile/"}) {
+    Config::ConnectWithoutContext(path + mobile + "Association",
+                                  MakeCallback(&KiteTracer::Association, this));
+    Config::ConnectWithoutContext(path + mobile + "TraceSent",
+                                  MakeCallback(&KiteTracer::TraceSent, this));
+    Config::ConnectWithoutContext(path + mobile + "TraceConfirmed",
+                                  MakeCallback(&KiteTracer::TraceConfirmed, this));
+  }
+
+  Config::ConnectWithoutContext(path + "$ns3::ndn::KiteRv/InterestBuffered",
+                                MakeCallback(&KiteTracer::InterestBuffered, this));
+  Config::ConnectWithoutContext(path + "$ns3::ndn::KiteRv/BufferedInterestSent",
+                                MakeCallback(&KiteTracer::BufferedInterestSent, this));
+
+  Config::ConnectWithoutContext(path + "ReceivedDatas",
+                                MakeCallback(&KiteTracer::ReceivedData, this));
+}
+
+const TraceSink::Columns&
+KiteTracer::GetColumns()
+{
+  static const TraceSink::Columns columns = {{"Time", TraceSink::DOUBLE},
+                                             {"Node", TraceSink::STRING},
+                                             {"Producer", TraceSink::STRING},
+                                             {"Type", TraceSink::STRING},
+                                             {"Value", TraceSink::DOUBLE}};
+  return columns;
+}
+
+void
+KiteTracer::PrintHeader(std::ostream& os) const
+{
+  TraceSink::PrintColumnNames(os, GetColumns());
+}
+
+KiteTracer::MobileProducer&
+KiteTracer::findProducer(const Name& dataPrefix)
+{
+  m_key.clear();
+  for (const auto& component : dataPrefix) {
+    m_key.append(reinterpret_cast<const char*>(component.wire()), component.size());
+  }
+
+  MobileProducer& producer = m_producers[m_key];
+  if (producer.dataPrefix.empty()) {
+    producer.dataPrefix = dataPrefix;
+    producer.uri = dataPrefix.toUri();
+  }
+  return producer;
+}
+
+KiteTracer::MobileProducer&
+KiteTracer::findProducer(Ptr<App> mobile)
+{
+  auto entry = m_mobiles.find(PeekPointer(mobile));
+  if (entry != m_mobiles.end()) {
+    return *entry->second;
+  }
+
+  NameValue rvPrefix;
+  NameValue dataPrefix;
+  mobile->GetAttribute("RvPrefix", rvPrefix);
+  mobile->GetAttribute("DataPrefix", dataPrefix);
+
+  MobileProducer& producer = findProducer(dataPrefix.Get());
+  producer.node = boost::lexical_cast<std::string>(mobile->GetNode()->GetId());
+  m_mobiles[PeekPointer(mobile)] = &producer;
+
+  Name consumerPrefix = rvPrefix.Get();
+  consumerPrefix.append(dataPrefix.Get());
+  m_key.clear();
+  for (const auto& component : consumerPrefix) {
+    m_key.append(reinterpret_cast<const char*>(component.wire()), component.size());
+  }
+  m_consumerPrefixes[m_key] = &producer;
+
+  return producer;
+}
+
+void
+KiteTracer::Association(Ptr<App> app)
+{
+  MobileProducer& producer = findProducer(app);
+  if (!producer.handoff) {
+    m_nHandoffs++;
+  }
+
+  producer.handoff = true;
+  producer.association = Simulator::Now();
+  producer.traceSent = Seconds(-1);
+  producer.traceConfirmed = Seconds(-1);
+  producer.bufferQueued = Seconds(-1);
+  producer.bufferFlushed = Seconds(-1);
+}
+
+void
+KiteTracer::TraceSent(Ptr<App> app, uint64_t seq)
+{
+  MobileProducer& producer = findProducer(app);
+  if (producer.handoff && producer.traceSent.IsNegative()) {
+    producer.traceSent = Simulator::Now() - producer.association;
+  }
+}
+
+void
+KiteTracer::TraceConfirmed(Ptr<App> app, uint64_t seq, Time rtt)
+{
+  MobileProducer& producer = findProducer(app);
+  if (producer.handoff && producer.traceConfirmed.IsNegative()) {
+    producer.traceConfirmed = Simulator::Now() - producer.association;
+  }
+
+  m_traceSetup.Record(toMicroSeconds(rtt));
+}
+
+void
+KiteTracer::InterestBuffered(Ptr<App> app, const Name& dataPrefix)
+{
+  MobileProducer& producer = findProducer(dataPrefix);
+  if (producer.handoff && producer.bufferQueued.IsNegative()) {
+    producer.bufferQueued = Simulator::Now() - producer.association;
+  }
+}
+
+void
+KiteTracer::BufferedInterestSent(Ptr<App> app, const Name& dataPrefix, Time wait)
+{
+  MobileProducer& producer = findProducer(dataPrefix);
+  if (producer.handoff && producer.bufferFlushed.IsNegative()) {
+    producer.bufferFlushed = Simulator::Now() - producer.association;
+  }
+
+  m_bufferWait.Record(toMicroSeconds(wait));
+}
+
+void
+KiteTracer::ReceivedData(shared_ptr<const Data> data, Ptr<App> app, shared_ptr<Face>)
+{
+  if (m_nHandoffs == 0) {
+    return;
+  }
+
+  // find mobile producer of the Data, with the longest consumer prefix
+  const Name& name = data->getName();
+  MobileProducer* producer = nullptr;
+  m_key.clear();
+  for (size_t i = 0; i < name.size(); i++) {
+    m_key.append(reinterpret_cast<const char*>(name[i].wire()), name[i].size());
+
+    auto entry = m_consumerPrefixes.find(m_key);
+    if (entry != m_consumerPrefixes.end()) {
+      producer = entry->second;
+    }
+  }
+
+  if (producer == nullptr || !producer->handoff) {
+    return;
+  }
+
+  producer->handoff = false;
+  m_nHandoffs--;
+
+  Time now = Simulator::Now();
+  Time firstData = now - producer->association;
+  m_handoffLatency.Record(toMicroSeconds(firstData));
+
+  const std::pair<const char*, Time> breakdown[] = {
+    {"HandoffTraceSent", producer->traceSent},
+    {"HandoffTraceConfirmed", producer->traceConfirmed},
+    {"HandoffInterestBuffered", producer->bufferQueued},
+    {"HandoffBufferFlushed", producer->bufferFlushed},
+    {"HandoffFirstData", firstData}};
+  for (const auto& step : breakdown) {
+    if (step.second.IsNegative()) {
+      continue; // step did not happen before the first Data, e.g., nothing was queued
+    }
+    m_sink->WriteRow(now.ToDouble(Time::S), producer->node, producer->uri, step.first,
+                     step.second.ToDouble(Time::S));
+  }
+}
+
+void
+KiteTracer::PrintPercentiles(const std::string& type, LogLinearHistogram& samples)
+{
+  double now = Simulator::Now().ToDouble(Time::S);
+
+  m_sink->WriteRow(now, "all", "all", type + "Count", static_cast<double>(samples.GetCount()));
+
+  if (samples.GetCount() == 0) {
+    return;
+  }
+
+  // delays are reported in seconds, the same as the per-handoff rows
+  for (int percentile : {50, 90, 99}) {
+    m_sink->WriteRow(now, "all", "all", type + "P" + std::to_string(percentile),
+                     samples.GetPercentile(percentile) * 1e-6);
+  }
+
+  m_sink->WriteRow(now, "all", "all", type + "Max", samples.GetMax() * 1e-6);
+
+  samples.Reset();
+}
+
+void
+KiteTracer::Print()
+{
+  PrintPercentiles("Handoff", m_handoffLatency);
+  PrintPercentiles("TraceSetup", m_traceSetup);
+  PrintPercentiles("BufferWait", m_bufferWait);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_KITE_TRACER_H
+#define NDN_KITE_TRACER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-sink.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-log-linear-histogram.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+#include <ns3/node-container.h>
+
+#include <unordered_map>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+class App;
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Tracer of KITE handoffs and trace latencies
+ *
+ * The tracer correlates events of KITE applications on the traced nodes, per mobile producer
+ * (DataPrefix of the mobile, e.g., /alice/photo):
+ *
+ * - association of the mobile with a new AP (KitePullMobile and KiteUploadMobile);
+ * - trace Interest sent and confirmed by RV;
+ * - consumer Interest queued in and sent out of the RV queue (KiteRv);
+ * - Data under RvPrefix + DataPrefix received by any application (consumers).
+ *
+ * For each handoff, the time from the association to the first trace Interest sent, to the first
+ * trace confirmed, to the first consumer Interest queued and sent out by RV, and to the first Data
+ * received by a consumer is written as soon as the consumer receives Data.  Every averaging
+ * period, the number of samples and the 50th, 90th, 99th percentiles and maximum of handoff
+ * latency (to the first Data), trace setup latency (trace Interest RTT), and RV queueing delay in
+ * that period are written.  The samples are kept in LogLinearHistogram, so the memory does not
+ * grow with their number and percentiles are within about 3% of the recorded values.
+ *
+ * One tracer is shared by all traced nodes, as events of the same producer happen on different
+ * nodes.  As with other tracers, applications must be installed before the tracer.
+ */
+class KiteTracer : public SimpleRefCount<KiteTracer> {
+public:
+  /**
+   * @brief Helper method to install tracer on all simulation nodes
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often percentiles will be written into the trace file
+   * @param format Format of the trace file (default, tab-separated text)
+   */
+  static void
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(1.0),
+             TraceSink::Format format = TraceSink::TEXT);
+
+  /**
+   * @brief Helper method to install tracer on the selected simulation nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often percentiles will be written into the trace file
+   * @param format Format of the trace file (default, tab-separated text)
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(1.0),
+          TraceSink::Format format = TraceSink::TEXT);
+
+  /**
+   * @brief Explicit request to remove all statically created tracers
+   *
+   * This method can be helpful if simulation scenario contains several independent run,
+   * or if it is desired to do a postprocessing of the resulting data
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Trace constructor
+   * @param sink sink of the trace, its columns should be set to GetColumns()
+   *
+   * Percentiles are written periodically only by tracers created by Install, which registers
+   * them with TracerRegistry.
+   */
+  explicit KiteTracer(shared_ptr<TraceSink> sink);
+
+  ~KiteTracer();
+
+  /**
+   * @brief Connect to KITE applications installed on the node
+   */
+  void
+  Connect(Ptr<Node> node);
+
+  /**
+   * @brief Print head of the trace (e.g., for post-processing)
+   *
+   * @param os reference to output stream
+   */
+  void
+  PrintHeader(std::ostream& os) const;
+
+  /**
+   * @brief Get columns of the trace
+   */
+  static const TraceSink::Columns&
+  GetColumns();
+
+private:
+  struct MobileProducer {
+    MobileProducer();
+
+    Name dataPrefix;     // e.g. /alice/photo
+    std::string uri;     // URI of dataPrefix, as written in the trace
+    std::string node;    // node of the mobile
+    bool handoff;        // handoff in progress, waiting for the first consumer Data
+    Time association;
+    Time traceSent;      // since association, negative if not yet
+    Time traceConfirmed; // since association, negative if not yet
+    Time bufferQueued;   // since association, negative if not yet
+    Time bufferFlushed;  // since association, negative if not yet
+  };
+
+  MobileProducer&
+  findProducer(const Name& dataPrefix);
+
+  MobileProducer&
+  findProducer(Ptr<App> mobile);
+
+  void
+  Association(Ptr<App> app);
+
+  void
+  TraceSent(Ptr<App> app, uint64_t seq);
+
+  void
+  TraceConfirmed(Ptr<App> app, uint64_t seq, Time rtt);
+
+  void
+  InterestBuffered(Ptr<App> app, const Name& producer);
+
+  void
+  BufferedInterestSent(Ptr<App> app, const Name& producer, Time wait);
+
+  void
+  ReceivedData(shared_ptr<const Data> data, Ptr<App> app, shared_ptr<Face> face);
+
+  void
+  Print();
+
+  void
+  PrintPercentiles(const std::string& type, LogLinearHistogram& samples);
+
+private:
+  shared_ptr<TraceSink> m_sink;
+
+  std::unordered_map<std::string, MobileProducer> m_producers;        // by wire of DataPrefix
+  std::unordered_map<std::string, MobileProducer*> m_consumerPrefixes; // by RvPrefix + DataPrefix
+  std::unordered_map<const App*, MobileProducer*> m_mobiles;
+  size_t m_nHandoffs; // handoffs in progress
+  std::string m_key;  // reusable buffer for table keys
+
+  // samples for the current averaging period, in microseconds
+  LogLinearHistogram m_handoffLatency;
+  LogLinearHistogram m_traceSetup;
+  LogLinearHistogram m_bufferWait;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_KITE_TRACER_H
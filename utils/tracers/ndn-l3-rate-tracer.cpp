@@ -26,218 +26,178 @@
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-tracer-registry.hpp"
 
 #include "daemon/table/pit-entry.hpp"
 
-#include <fstream>
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+
 NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
 
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<L3RateTracer>>>>
-  g_tracers;
-
 void
 L3RateTracer::Destroy()
 {
-  g_tracers.clear();
+  TracerRegistry::Get().Remove("L3RateTracer");
 }
 
 void
-L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/,
+                         TraceSink::Format format /* = TraceSink::TEXT*/,
+                         const TraceFilter& filter /* = TraceFilter()*/)
 {
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
-  }
-
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  Install(NodeContainer::GetGlobal(), file, averagingPeriod, format, filter);
 }
 
 void
 L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+                      Time averagingPeriod /* = Seconds (0.5)*/,
+                      TraceSink::Format format /* = TraceSink::TEXT*/,
+                      const TraceFilter& filter /* = TraceFilter()*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, format);
+  if (sink == nullptr) {
+    return;
   }
+  sink->SetColumns(GetColumns());
 
+  auto tracers = make_shared<std::vector<Ptr<L3RateTracer>>>();
+  tracers->reserve(nodes.GetN());
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
-  }
+    NS_LOG_DEBUG("Node: " << (*node)->GetId());
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+    Ptr<L3RateTracer> trace = Create<L3RateTracer>(sink, *node);
+    if (!filter.IsAcceptingAll()) {
+      trace->SetFilter(filter);
+    }
+    tracers->push_back(trace);
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  Register(sink, tracers, averagingPeriod);
 }
 
 void
 L3RateTracer::Install(Ptr<Node> node, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+                      Time averagingPeriod /* = Seconds (0.5)*/,
+                      TraceSink::Format format /* = TraceSink::TEXT*/,
+                      const TraceFilter& filter /* = TraceFilter()*/)
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
-
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
-  }
-
-  Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
-  tracers.push_back(trace);
-
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
-  }
-
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  Install(NodeContainer(node), file, averagingPeriod, format, filter);
 }
 
 Ptr<L3RateTracer>
 L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
                       Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  return Install(node, make_shared<TextTraceSink>(outputStream), averagingPeriod);
+}
+
+Ptr<L3RateTracer>
+L3RateTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink,
+                      Time averagingPeriod /* = Seconds (0.5)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<L3RateTracer> trace = Create<L3RateTracer>(outputStream, node);
-  trace->SetAveragingPeriod(averagingPeriod);
+  Ptr<L3RateTracer> trace = Create<L3RateTracer>(sink, node);
+  Register(sink, make_shared<std::vector<Ptr<L3RateTracer>>>(1, trace), averagingPeriod);
 
   return trace;
 }
 
+void
+L3RateTracer::Register(shared_ptr<TraceSink> sink,
+                       shared_ptr<std::vector<Ptr<L3RateTracer>>> tracers, Time averagingPeriod)
+{
+  for (const auto& trace : *tracers) {
+    trace->m_period = averagingPeriod;
+  }
+
+  const std::vector<Ptr<L3RateTracer>>* group = tracers.get();
+  TracerRegistry::Get().Add("L3RateTracer", sink, tracers, averagingPeriod,
+                            [group] (TraceSink& sink) {
+                              for (const auto& trace : *group) {
+                                trace->Print(sink);
+                                trace->Reset();
+                              }
+                            });
+}
+
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
-  : L3Tracer(node)
-  , m_os(os)
+  : L3RateTracer(make_shared<TextTraceSink>(os), node)
 {
-  SetAveragingPeriod(Seconds(1.0));
 }
 
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   : L3Tracer(node)
-  , m_os(os)
+  , m_sink(make_shared<TextTraceSink>(os))
+  , m_period(Seconds(1.0))
+  , m_allStats()
+  , m_hasAllStats(false)
 {
-  SetAveragingPeriod(Seconds(1.0));
 }
 
-L3RateTracer::~L3RateTracer()
+L3RateTracer::L3RateTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
+  : L3Tracer(node)
+  , m_sink(sink)
+  , m_period(Seconds(1.0))
+  , m_allStats()
+  , m_hasAllStats(false)
 {
-  m_printEvent.Cancel();
 }
 
-void
-L3RateTracer::SetAveragingPeriod(const Time& period)
+L3RateTracer::~L3RateTracer()
 {
-  m_period = period;
-  m_printEvent.Cancel();
-  m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
 }
 
-void
-L3RateTracer::PeriodicPrinter()
+L3RateTracer::FaceSlot::FaceSlot()
+  : id(nfd::face::INVALID_FACEID)
+  , stats()
 {
-  Print(*m_os);
-  Reset();
+}
 
-  m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
+const TraceSink::Columns&
+L3RateTracer::GetColumns()
+{
+  static const TraceSink::Columns columns = {{"Time", TraceSink::DOUBLE},
+                                             {"Node", TraceSink::STRING},
+                                             {"FaceId", TraceSink::INTEGER},
+                                             {"FaceDescr", TraceSink::STRING},
+                                             {"Type", TraceSink::STRING},
+                                             {"Packets", TraceSink::DOUBLE},
+                                             {"Kilobytes", TraceSink::DOUBLE},
+                                             {"PacketRaw", TraceSink::DOUBLE},
+                                             {"KilobytesRaw", TraceSink::DOUBLE}};
+  return columns;
 }
 
 void
 L3RateTracer::PrintHeader(std::ostream& os) const
 {
-  os << "Time"
-     << "\t"
-
-     << "Node"
-     << "\t"
-     << "FaceId"
-     << "\t"
-     << "FaceDescr"
-     << "\t"
-
-     << "Type"
-     << "\t"
-     << "Packets"
-     << "\t"
-     << "Kilobytes"
-     << "\t"
-     << "PacketRaw"
-     << "\t"
-     << "KilobytesRaw";
+  TraceSink::PrintColumnNames(os, GetColumns());
 }
 
 void
 L3RateTracer::Reset()
 {
-  for (auto& stats : m_stats) {
-    std::get<0>(stats.second).Reset();
-    std::get<1>(stats.second).Reset();
+  for (auto& slot : m_reservedFaces) {
+    std::get<0>(slot.stats).Reset();
+    std::get<1>(slot.stats).Reset();
   }
+  for (auto& slot : m_faces) {
+    std::get<0>(slot.stats).Reset();
+    std::get<1>(slot.stats).Reset();
+  }
+  std::get<0>(m_allStats).Reset();
+  std::get<1>(m_allStats).Reset();
 }
 
 const double alpha = 0.8;
 
-#define STATS(INDEX) std::get<INDEX>(stats.second)
+#define STATS(INDEX) std::get<INDEX>(stats)
 #define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
 
 #define PRINTER(printName, fieldName)                                                              \
@@ -246,159 +206,202 @@ const double alpha = 0.8;
   STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
                        + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nfd::face::INVALID_FACEID) {                                                  \
-    os << stats.first << "\t";                                                                     \
-    NS_ASSERT(m_faceInfos.find(stats.first) != m_faceInfos.end());                                 \
-    os << m_faceInfos.find(stats.first)->second << "\t";                                           \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+  sink.WriteRow(time, m_node, faceId, faceDescr, printName, STATS(2).fieldName,                   \
+                STATS(3).fieldName, STATS(0).fieldName, STATS(1).fieldName / 1024.0);
 
 void
 L3RateTracer::Print(std::ostream& os) const
 {
-  Time time = Simulator::Now();
-
-  for (auto& stats : m_stats) {
-    if (stats.first == nfd::face::INVALID_FACEID)
-      continue;
-
-    PRINTER("InInterests", m_inInterests);
-    PRINTER("OutInterests", m_outInterests);
+  TextTraceSink sink(shared_ptr<std::ostream>(&os, std::bind([]{})));
+  Print(sink);
+}
 
-    PRINTER("InData", m_inData);
-    PRINTER("OutData", m_outData);
+void
+L3RateTracer::Print(TraceSink& sink) const
+{
+  double time = Simulator::Now().ToDouble(Time::S);
 
-    PRINTER("InNacks", m_inNack);
-    PRINTER("OutNacks", m_outNack);
+  for (const auto& slot : m_reservedFaces) {
+    PrintSlot(sink, time, slot);
+  }
+  for (const auto& slot : m_faces) {
+    if (slot.id != nfd::face::INVALID_FACEID) {
+      PrintSlot(sink, time, slot);
+    }
+  }
 
-    PRINTER("InSatisfiedInterests", m_satisfiedInterests);
-    PRINTER("InTimedOutInterests", m_timedOutInterests);
+  if (m_hasAllStats) {
+    static const std::string faceDescr = "all";
+    const int64_t faceId = -1;
+    FaceStats& stats = m_allStats;
 
-    PRINTER("OutSatisfiedInterests", m_outSatisfiedInterests);
-    PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
+    PRINTER("SatisfiedInterests", m_satisfiedInterests);
+    PRINTER("TimedOutInterests", m_timedOutInterests);
   }
+}
 
-  {
-    auto i = m_stats.find(nfd::face::INVALID_FACEID);
-    if (i != m_stats.end()) {
-      auto& stats = *i;
-      PRINTER("SatisfiedInterests", m_satisfiedInterests);
-      PRINTER("TimedOutInterests", m_timedOutInterests);
-    }
+void
+L3RateTracer::PrintSlot(TraceSink& sink, double time, const FaceSlot& slot) const
+{
+  if (slot.descr.empty()) {
+    shared_ptr<const Face> face = slot.face.lock();
+    slot.descr = face != nullptr ? boost::lexical_cast<std::string>(face->getLocalUri())
+                                 : "unknown://";
   }
+
+  const std::string& faceDescr = slot.descr;
+  const int64_t faceId = slot.id;
+  FaceStats& stats = slot.stats;
+
+  PRINTER("InInterests", m_inInterests);
+  PRINTER("OutInterests", m_outInterests);
+
+  PRINTER("InData", m_inData);
+  PRINTER("OutData", m_outData);
+
+  PRINTER("InNacks", m_inNack);
+  PRINTER("OutNacks", m_outNack);
+
+  PRINTER("InSatisfiedInterests", m_satisfiedInterests);
+  PRINTER("InTimedOutInterests", m_timedOutInterests);
+
+  PRINTER("OutSatisfiedInterests", m_outSatisfiedInterests);
+  PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
 }
 
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outInterests++;
+  FaceStats& stats = GetSlot(face).stats;
+  std::get<0>(stats).m_outInterests += m_weight;
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outInterests +=
-      interest.wireEncode().size();
+    std::get<1>(stats).m_outInterests += interest.wireEncode().size() * m_weight;
   }
 }
 
 void
 L3RateTracer::InInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inInterests++;
+  FaceStats& stats = GetSlot(face).stats;
+  std::get<0>(stats).m_inInterests += m_weight;
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inInterests +=
-      interest.wireEncode().size();
+    std::get<1>(stats).m_inInterests += interest.wireEncode().size() * m_weight;
   }
 }
 
 void
 L3RateTracer::OutData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outData++;
+  FaceStats& stats = GetSlot(face).stats;
+  std::get<0>(stats).m_outData += m_weight;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outData +=
-      data.wireEncode().size();
+    std::get<1>(stats).m_outData += data.wireEncode().size() * m_weight;
   }
 }
 
 void
 L3RateTracer::InData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inData++;
+  FaceStats& stats = GetSlot(face).stats;
+  std::get<0>(stats).m_inData += m_weight;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inData +=
-      data.wireEncode().size();
+    std::get<1>(stats).m_inData += data.wireEncode().size() * m_weight;
   }
 }
 
 void
 L3RateTracer::OutNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outNack++;
+  FaceStats& stats = GetSlot(face).stats;
+  std::get<0>(stats).m_outNack += m_weight;
   if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outNack +=
-      nack.getInterest().wireEncode().size();
+    std::get<1>(stats).m_outNack += nack.getInterest().wireEncode().size() * m_weight;
   }
 }
 
 void
 L3RateTracer::InNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inNack++;
+  FaceStats& stats = GetSlot(face).stats;
+  std::get<0>(stats).m_inNack += m_weight;
   if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inNack +=
-      nack.getInterest().wireEncode().size();
+    std::get<1>(stats).m_inNack += nack.getInterest().wireEncode().size() * m_weight;
   }
 }
 
 void
 L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_satisfiedInterests++;
+  std::get<0>(m_allStats).m_satisfiedInterests += m_weight;
+  m_hasAllStats = true;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_satisfiedInterests ++;
+    if (!IsTracedFace(in.getFace())) {
+      continue;
+    }
+    std::get<0>(GetSlot(in.getFace()).stats).m_satisfiedInterests += m_weight;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outSatisfiedInterests ++;
+    if (!IsTracedFace(out.getFace())) {
+      continue;
+    }
+    std::get<0>(GetSlot(out.getFace()).stats).m_outSatisfiedInterests += m_weight;
   }
 }
 
 void
 L3RateTracer::TimedOutInterests(const nfd::pit::Entry& entry)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_timedOutInterests++;
+  std::get<0>(m_allStats).m_timedOutInterests += m_weight;
+  m_hasAllStats = true;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_timedOutInterests++;
+    if (!IsTracedFace(in.getFace())) {
+      continue;
+    }
+    std::get<0>(GetSlot(in.getFace()).stats).m_timedOutInterests += m_weight;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outTimedOutInterests++;
+    if (!IsTracedFace(out.getFace())) {
+      continue;
+    }
+    std::get<0>(GetSlot(out.getFace()).stats).m_outTimedOutInterests += m_weight;
   }
 }
 
-void
-L3RateTracer::AddInfo(const Face& face)
+L3RateTracer::FaceSlot&
+L3RateTracer::GetSlot(const Face& face)
 {
-  if (m_faceInfos.find(face.getId()) == m_faceInfos.end()) {
-    m_faceInfos.insert(make_pair(face.getId(), boost::lexical_cast<std::string>(face.getLocalUri())));
+  nfd::FaceId id = face.getId();
+
+  if (id > nfd::face::FACEID_RESERVED_MAX) {
+    size_t index = id - nfd::face::FACEID_RESERVED_MAX - 1;
+    if (index >= m_faces.size()) {
+      m_faces.resize(index + 1);
+    }
+
+    FaceSlot& slot = m_faces[index];
+    if (slot.id == nfd::face::INVALID_FACEID) {
+      slot.id = id;
+      slot.face = face.shared_from_this();
+    }
+    return slot;
+  }
+
+  auto slot = std::lower_bound(m_reservedFaces.begin(), m_reservedFaces.end(), id,
+                               [] (const FaceSlot& reserved, nfd::FaceId id) {
+                                 return reserved.id < id;
+                               });
+  if (slot == m_reservedFaces.end() || slot->id != id) {
+    slot = m_reservedFaces.insert(slot, FaceSlot());
+    slot->id = id;
+    slot->face = face.shared_from_this();
   }
+  return *slot;
 }
 
 } // namespace ndn
@@ -23,14 +23,14 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
 #include "ndn-l3-tracer.hpp"
+#include "ndn-trace-sink.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
 #include "ns3/node-container.h"
 
 #include <tuple>
-#include <map>
-#include <list>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -48,9 +48,12 @@ public:
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
+   * @param format Format of the trace file (default, tab-separated text)
+   * @param filter Selection of traced packets (default, all)
    */
   static void
-  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5),
+             TraceSink::Format format = TraceSink::TEXT, const TraceFilter& filter = TraceFilter());
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
@@ -59,9 +62,12 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param format Format of the trace file (default, tab-separated text)
+   * @param filter Selection of traced packets (default, all)
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          TraceSink::Format format = TraceSink::TEXT, const TraceFilter& filter = TraceFilter());
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -70,9 +76,12 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param format Format of the trace file (default, tab-separated text)
+   * @param filter Selection of traced packets (default, all)
    */
   static void
-  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          TraceSink::Format format = TraceSink::TEXT, const TraceFilter& filter = TraceFilter());
 
   /**
    * @brief Explicit request to remove all statically created tracers
@@ -97,6 +106,13 @@ public:
    */
   L3RateTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param sink  sink of the trace
+   * @param node  pointer to the node
+   */
+  L3RateTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -118,6 +134,23 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param sink Sink of the trace, its columns should be set to GetColumns()
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *second)
+   */
+  static Ptr<L3RateTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time averagingPeriod = Seconds(0.5));
+
+  /**
+   * @brief Get columns of the trace
+   */
+  static const TraceSink::Columns&
+  GetColumns();
+
   // from L3Tracer
   virtual void
   PrintHeader(std::ostream& os) const;
@@ -125,6 +158,9 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  void
+  Print(TraceSink& sink) const;
+
 protected:
   // from L3Tracer
   virtual void
@@ -152,25 +188,48 @@ protected:
   TimedOutInterests(const nfd::pit::Entry&);
 
 private:
-  void
-  SetAveragingPeriod(const Time& period);
-
-  void
-  PeriodicPrinter();
+  /**
+   * @brief Register the tracers with TracerRegistry, which prints them every averaging period
+   */
+  static void
+  Register(shared_ptr<TraceSink> sink, shared_ptr<std::vector<Ptr<L3RateTracer>>> tracers,
+           Time averagingPeriod);
 
   void
   Reset();
 
+  typedef std::tuple<Stats, Stats, Stats, Stats> FaceStats;
+
+  struct FaceSlot {
+    FaceSlot();
+
+    nfd::FaceId id; // INVALID_FACEID, if the face has not been seen yet
+    std::weak_ptr<const Face> face;
+    mutable std::string descr; // resolved at the first print, face may not exist later
+    mutable FaceStats stats;
+  };
+
+  /**
+   * @brief Get counters of the face, without lookups in the common case
+   *
+   * Forwarder assigns face ids sequentially, starting after the reserved ones, so the id is used
+   * as an index of the slot.  The few reserved faces (e.g., the internal face) are in a separate
+   * small vector.
+   */
+  FaceSlot&
+  GetSlot(const Face& face);
+
   void
-  AddInfo(const Face& face);
+  PrintSlot(TraceSink& sink, double time, const FaceSlot& slot) const;
 
 private:
-  shared_ptr<std::ostream> m_os;
+  shared_ptr<TraceSink> m_sink;
   Time m_period;
-  EventId m_printEvent;
 
-  mutable std::map<nfd::FaceId, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
-  std::map<nfd::FaceId, std::string> m_faceInfos; // needed, because face may no longer exists at the time of stat printing
+  std::vector<FaceSlot> m_faces;         // regular faces, by id - FACEID_RESERVED_MAX - 1
+  std::vector<FaceSlot> m_reservedFaces; // sorted by id
+  mutable FaceStats m_allStats;          // satisfied and timed out Interests of all faces
+  bool m_hasAllStats;
 };
 
 } // namespace ndn
@@ -28,11 +28,26 @@
 
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 
+#include "daemon/table/pit-entry.hpp"
+
 namespace ns3 {
 namespace ndn {
 
+// kinds of events sampled independently by TraceFilter
+enum {
+  OUT_INTERESTS,
+  IN_INTERESTS,
+  OUT_DATA,
+  IN_DATA,
+  OUT_NACK,
+  IN_NACK,
+  SATISFIED_INTERESTS,
+  TIMED_OUT_INTERESTS
+};
+
 L3Tracer::L3Tracer(Ptr<Node> node)
   : m_nodePtr(node)
+  , m_weight(1)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -46,30 +61,139 @@ L3Tracer::L3Tracer(Ptr<Node> node)
 
 L3Tracer::L3Tracer(const std::string& node)
   : m_node(node)
+  , m_weight(1)
 {
   Connect();
 }
 
 L3Tracer::~L3Tracer(){};
 
+std::vector<std::pair<std::string, CallbackBase>>
+L3Tracer::GetCallbacks()
+{
+  if (m_filter == nullptr) {
+    return {{"OutInterests", MakeCallback(&L3Tracer::OutInterests, this)},
+            {"InInterests", MakeCallback(&L3Tracer::InInterests, this)},
+            {"OutData", MakeCallback(&L3Tracer::OutData, this)},
+            {"InData", MakeCallback(&L3Tracer::InData, this)},
+            {"OutNack", MakeCallback(&L3Tracer::OutNack, this)},
+            {"InNack", MakeCallback(&L3Tracer::InNack, this)},
+            // satisfied/timed out PIs
+            {"SatisfiedInterests", MakeCallback(&L3Tracer::SatisfiedInterests, this)},
+            {"TimedOutInterests", MakeCallback(&L3Tracer::TimedOutInterests, this)}};
+  }
+
+  return {{"OutInterests", MakeCallback(&L3Tracer::FilterOutInterests, this)},
+          {"InInterests", MakeCallback(&L3Tracer::FilterInInterests, this)},
+          {"OutData", MakeCallback(&L3Tracer::FilterOutData, this)},
+          {"InData", MakeCallback(&L3Tracer::FilterInData, this)},
+          {"OutNack", MakeCallback(&L3Tracer::FilterOutNack, this)},
+          {"InNack", MakeCallback(&L3Tracer::FilterInNack, this)},
+          {"SatisfiedInterests", MakeCallback(&L3Tracer::FilterSatisfiedInterests, this)},
+          {"TimedOutInterests", MakeCallback(&L3Tracer::FilterTimedOutInterests, this)}};
+}
+
 void
 L3Tracer::Connect()
 {
   Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
 
-  l3->TraceConnectWithoutContext("OutInterests", MakeCallback(&L3Tracer::OutInterests, this));
-  l3->TraceConnectWithoutContext("InInterests", MakeCallback(&L3Tracer::InInterests, this));
-  l3->TraceConnectWithoutContext("OutData", MakeCallback(&L3Tracer::OutData, this));
-  l3->TraceConnectWithoutContext("InData", MakeCallback(&L3Tracer::InData, this));
-  l3->TraceConnectWithoutContext("OutNack", MakeCallback(&L3Tracer::OutNack, this));
-  l3->TraceConnectWithoutContext("InNack", MakeCallback(&L3Tracer::InNack, this));
+  for (const auto& callback : GetCallbacks()) {
+    l3->TraceConnectWithoutContext(callback.first, callback.second);
+  }
+}
+
+void
+L3Tracer::Disconnect()
+{
+  Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
+
+  for (const auto& callback : GetCallbacks()) {
+    l3->TraceDisconnectWithoutContext(callback.first, callback.second);
+  }
+}
+
+void
+L3Tracer::SetFilter(const TraceFilter& filter)
+{
+  Disconnect();
+
+  // without criteria, events go directly to the tracer
+  if (filter.IsAcceptingAll()) {
+    m_filter.reset();
+  }
+  else {
+    m_filter.reset(new TraceFilter(filter));
+  }
+  m_weight = filter.GetWeight();
+
+  Connect();
+}
+
+void
+L3Tracer::FilterOutInterests(const Interest& interest, const Face& face)
+{
+  if (m_filter->Accept(OUT_INTERESTS, interest.getName(), &face)) {
+    OutInterests(interest, face);
+  }
+}
+
+void
+L3Tracer::FilterInInterests(const Interest& interest, const Face& face)
+{
+  if (m_filter->Accept(IN_INTERESTS, interest.getName(), &face)) {
+    InInterests(interest, face);
+  }
+}
+
+void
+L3Tracer::FilterOutData(const Data& data, const Face& face)
+{
+  if (m_filter->Accept(OUT_DATA, data.getName(), &face)) {
+    OutData(data, face);
+  }
+}
 
-  // satisfied/timed out PIs
-  l3->TraceConnectWithoutContext("SatisfiedInterests",
-                                 MakeCallback(&L3Tracer::SatisfiedInterests, this));
+void
+L3Tracer::FilterInData(const Data& data, const Face& face)
+{
+  if (m_filter->Accept(IN_DATA, data.getName(), &face)) {
+    InData(data, face);
+  }
+}
 
-  l3->TraceConnectWithoutContext("TimedOutInterests",
-                                 MakeCallback(&L3Tracer::TimedOutInterests, this));
+void
+L3Tracer::FilterOutNack(const lp::Nack& nack, const Face& face)
+{
+  if (m_filter->Accept(OUT_NACK, nack.getInterest().getName(), &face)) {
+    OutNack(nack, face);
+  }
+}
+
+void
+L3Tracer::FilterInNack(const lp::Nack& nack, const Face& face)
+{
+  if (m_filter->Accept(IN_NACK, nack.getInterest().getName(), &face)) {
+    InNack(nack, face);
+  }
+}
+
+void
+L3Tracer::FilterSatisfiedInterests(const nfd::pit::Entry& entry, const Face& face,
+                                   const Data& data)
+{
+  // faces of in- and out-records are checked by the tracer
+  if (m_filter->Accept(SATISFIED_INTERESTS, entry.getName(), nullptr)) {
+    SatisfiedInterests(entry, face, data);
+  }
+}
+
+void
+L3Tracer::FilterTimedOutInterests(const nfd::pit::Entry& entry)
+{
+  if (m_filter->Accept(TIMED_OUT_INTERESTS, entry.getName(), nullptr)) {
+    TimedOutInterests(entry);
+  }
 }
 
 } // namespace ndn
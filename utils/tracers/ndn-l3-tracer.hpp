@@ -22,8 +22,13 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ndn-trace-filter.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
+#include "ns3/callback.h"
+
+#include <vector>
 
 namespace nfd {
 namespace pit {
@@ -77,10 +82,25 @@ public:
   virtual void
   Print(std::ostream& os) const = 0;
 
+  /**
+   * @brief Trace only events accepted by the filter
+   *
+   * Subclasses should multiply counts by m_weight and skip faces rejected by IsTracedFace, when
+   * they count per-face events of PIT entries
+   */
+  void
+  SetFilter(const TraceFilter& filter);
+
 protected:
   void
   Connect();
 
+  bool
+  IsTracedFace(const Face& face) const
+  {
+    return m_filter == nullptr || m_filter->AcceptFace(face.getId());
+  }
+
   virtual void
   OutInterests(const Interest&, const Face&) = 0;
 
@@ -105,9 +125,46 @@ protected:
   virtual void
   TimedOutInterests(const nfd::pit::Entry&) = 0;
 
+private:
+  std::vector<std::pair<std::string, CallbackBase>>
+  GetCallbacks();
+
+  void
+  Disconnect();
+
+  void
+  FilterOutInterests(const Interest&, const Face&);
+
+  void
+  FilterInInterests(const Interest&, const Face&);
+
+  void
+  FilterOutData(const Data&, const Face&);
+
+  void
+  FilterInData(const Data&, const Face&);
+
+  void
+  FilterOutNack(const lp::Nack& nack, const Face&);
+
+  void
+  FilterInNack(const lp::Nack&, const Face&);
+
+  void
+  FilterSatisfiedInterests(const nfd::pit::Entry&, const Face&, const Data&);
+
+  void
+  FilterTimedOutInterests(const nfd::pit::Entry&);
+
 protected:
   std::string m_node;
   Ptr<Node> m_nodePtr;
+  double m_weight; ///< @brief number of events represented by a traced one
+
+private:
+  std::unique_ptr<TraceFilter> m_filter;
+
+protected:
 
   struct Stats {
     inline void
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-log-linear-histogram.hpp"
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+namespace ndn {
+
+// values below 2^PRECISION_BITS are exact, and each power of two above has 2^(PRECISION_BITS - 1)
+// buckets
+static const unsigned PRECISION_BITS = 6;
+static const uint64_t SUB_BUCKETS = 1 << (PRECISION_BITS - 1);
+
+LogLinearHistogram::LogLinearHistogram(unsigned rangeBits)
+  : m_count(0)
+  , m_max(0)
+{
+  NS_ASSERT(rangeBits >= PRECISION_BITS && rangeBits <= 64);
+  m_counts.resize((rangeBits - PRECISION_BITS + 2) * SUB_BUCKETS);
+}
+
+size_t
+LogLinearHistogram::GetIndex(uint64_t value) const
+{
+  size_t index = value;
+  if (value >= 2 * SUB_BUCKETS) {
+    unsigned msb = 63 - __builtin_clzll(value);
+    unsigned shift = msb - (PRECISION_BITS - 1);
+    index = shift * SUB_BUCKETS + (value >> shift);
+  }
+  return std::min(index, m_counts.size() - 1);
+}
+
+uint64_t
+LogLinearHistogram::GetHighestValue(size_t index)
+{
+  if (index < 2 * SUB_BUCKETS) {
+    return index;
+  }
+  unsigned shift = index / SUB_BUCKETS - 1;
+  uint64_t lowest = static_cast<uint64_t>(index - shift * SUB_BUCKETS) << shift;
+  return lowest + (static_cast<uint64_t>(1) << shift) - 1;
+}
+
+void
+LogLinearHistogram::Record(uint64_t value)
+{
+  m_counts[GetIndex(value)]++;
+  m_count++;
+  m_max = std::max(m_max, value);
+}
+
+void
+LogLinearHistogram::Reset()
+{
+  if (m_count == 0) {
+    return;
+  }
+  std::fill(m_counts.begin(), m_counts.end(), 0);
+  m_count = 0;
+  m_max = 0;
+}
+
+uint64_t
+LogLinearHistogram::GetPercentile(double percentile) const
+{
+  if (m_count == 0) {
+    return 0;
+  }
+
+  uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100 * m_count));
+  rank = std::min(std::max<uint64_t>(rank, 1), m_count);
+
+  uint64_t seen = 0;
+  for (size_t index = 0; index < m_counts.size(); index++) {
+    seen += m_counts[index];
+    if (seen >= rank) {
+      // the last bucket also counts values out of range
+      return index + 1 < m_counts.size() ? std::min(GetHighestValue(index), m_max) : m_max;
+    }
+  }
+  return m_max;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_LOG_LINEAR_HISTOGRAM_H
+#define NDN_LOG_LINEAR_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Histogram of non-negative integers with log-linear buckets (as in HdrHistogram)
+ *
+ * Values below 64 are counted exactly.  Larger values fall into one of 32 equal buckets within
+ * their power of two, so that any reported value is within 1/32 (about 3%) of the recorded ones.
+ * The number of buckets depends only on the range, so the memory is fixed regardless of the
+ * number of recorded values.
+ */
+class LogLinearHistogram {
+public:
+  /**
+   * @param rangeBits values up to 2^rangeBits - 1 are distinguished, larger values are counted in
+   *        the last bucket (but still reported by GetMax).  Must be at least 6
+   */
+  explicit LogLinearHistogram(unsigned rangeBits);
+
+  void
+  Record(uint64_t value);
+
+  /**
+   * @brief Forget all recorded values
+   */
+  void
+  Reset();
+
+  uint64_t
+  GetCount() const
+  {
+    return m_count;
+  }
+
+  uint64_t
+  GetMax() const
+  {
+    return m_max;
+  }
+
+  /**
+   * @brief Get value, below or at which are the given percent of recorded values
+   * @param percentile from 0 to 100, e.g., 99.9
+   * @return the highest value of the bucket containing the percentile, but at most GetMax() (which
+   *         is also returned for the last bucket), or 0 if no values are recorded
+   */
+  uint64_t
+  GetPercentile(double percentile) const;
+
+private:
+  size_t
+  GetIndex(uint64_t value) const;
+
+  static uint64_t
+  GetHighestValue(size_t index);
+
+private:
+  std::vector<uint32_t> m_counts;
+  uint64_t m_count;
+  uint64_t m_max;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LOG_LINEAR_HISTOGRAM_H
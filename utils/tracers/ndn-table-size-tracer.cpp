@@ -0,0 +1,274 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-table-size-tracer.hpp"
+#include "ns3/node.h"
+#include "ns3/names.h"
+
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-tracer-registry.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TableSizeTracer");
+
+namespace ns3 {
+namespace ndn {
+
+void
+TableSizeTracer::Destroy()
+{
+  TracerRegistry::Get().Remove("TableSizeTracer");
+}
+
+void
+TableSizeTracer::InstallAll(const std::string& file, Time period /* = Seconds (1.0)*/,
+                            size_t topK /* = 0*/, TraceSink::Format format /* = TraceSink::TEXT*/)
+{
+  Install(NodeContainer::GetGlobal(), file, period, topK, format);
+}
+
+void
+TableSizeTracer::Install(const NodeContainer& nodes, const std::string& file,
+                         Time period /* = Seconds (1.0)*/, size_t topK /* = 0*/,
+                         TraceSink::Format format /* = TraceSink::TEXT*/)
+{
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, format);
+  if (sink == nullptr) {
+    return;
+  }
+  sink->SetColumns(GetColumns());
+
+  NodeContainer ndnNodes;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    if ((*node)->GetObject<L3Protocol>() == nullptr) {
+      continue;
+    }
+    NS_LOG_DEBUG("Node: " << (*node)->GetId());
+    ndnNodes.Add(*node);
+  }
+
+  Ptr<TableSizeTracer> trace = Create<TableSizeTracer>(sink, ndnNodes, topK);
+
+  TableSizeTracer* raw = PeekPointer(trace);
+  TracerRegistry::Get().Add("TableSizeTracer", sink, make_shared<Ptr<TableSizeTracer>>(trace),
+                            period, [raw] (TraceSink& sink) { raw->Print(sink); });
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// per-entry overhead of the tables that are not walked, roughly the entry itself and the links
+// of its container
+static const size_t MEASUREMENTS_ENTRY_SIZE = sizeof(nfd::measurements::Entry) + 2 * sizeof(void*);
+static const size_t STRATEGY_CHOICE_ENTRY_SIZE =
+  sizeof(nfd::strategy_choice::Entry) + 2 * sizeof(void*);
+static const size_t DEAD_NONCE_LIST_ENTRY_SIZE = sizeof(uint64_t) + 3 * sizeof(void*);
+static const size_t NAME_TREE_ENTRY_SIZE = sizeof(nfd::name_tree::Entry) + 2 * sizeof(void*);
+
+const char*
+TableSizeTracer::GetTableName(Table table)
+{
+  static const char* names[N_TABLES] = {"Pit",
+                                        "Fib",
+                                        "Cs",
+                                        "Measurements",
+                                        "StrategyChoice",
+                                        "DeadNonceList",
+                                        "NameTree",
+                                        "ContentStore",
+                                        "Total",
+                                        "TraceEntries"};
+  return names[table];
+}
+
+TableSizeTracer::TableSizes
+TableSizeTracer::GetTableSizes(Ptr<Node> node)
+{
+  TableSizes sizes;
+  sizes.fill(TableSize{0, 0});
+
+  Ptr<L3Protocol> l3 = node->GetObject<L3Protocol>();
+  if (l3 == nullptr) {
+    return sizes;
+  }
+  nfd::Forwarder& forwarder = *l3->getForwarder();
+
+  for (const nfd::pit::Entry& entry : forwarder.getPit()) {
+    uint64_t bytes = sizeof(nfd::pit::Entry) + entry.getInterest().wireEncode().size()
+                     + entry.getInRecords().size() * sizeof(nfd::pit::InRecord)
+                     + entry.getOutRecords().size() * sizeof(nfd::pit::OutRecord);
+    sizes[PIT].entries++;
+    sizes[PIT].bytes += bytes;
+
+    if (L3Protocol::isTraceName(entry.getName())) {
+      sizes[TRACE_ENTRIES].entries++;
+      sizes[TRACE_ENTRIES].bytes += bytes;
+    }
+  }
+
+  for (const nfd::fib::Entry& entry : forwarder.getFib()) {
+    sizes[FIB].entries++;
+    sizes[FIB].bytes +=
+      sizeof(nfd::fib::Entry) + entry.getNextHops().size() * sizeof(nfd::fib::NextHop);
+  }
+
+  for (const nfd::cs::Entry& entry : forwarder.getCs()) {
+    sizes[CS].entries++;
+    sizes[CS].bytes += sizeof(nfd::cs::Entry) + entry.getData().wireEncode().size();
+  }
+
+  sizes[MEASUREMENTS].entries = forwarder.getMeasurements().size();
+  sizes[MEASUREMENTS].bytes = sizes[MEASUREMENTS].entries * MEASUREMENTS_ENTRY_SIZE;
+
+  sizes[STRATEGY_CHOICE].entries = forwarder.getStrategyChoice().size();
+  sizes[STRATEGY_CHOICE].bytes = sizes[STRATEGY_CHOICE].entries * STRATEGY_CHOICE_ENTRY_SIZE;
+
+  sizes[DEAD_NONCE_LIST].entries = forwarder.getDeadNonceList().size();
+  sizes[DEAD_NONCE_LIST].bytes = sizes[DEAD_NONCE_LIST].entries * DEAD_NONCE_LIST_ENTRY_SIZE;
+
+  sizes[NAME_TREE].entries = forwarder.getNameTree().size();
+  sizes[NAME_TREE].bytes = sizes[NAME_TREE].entries * NAME_TREE_ENTRY_SIZE;
+
+  Ptr<ContentStore> contentStore = node->GetObject<ContentStore>();
+  if (contentStore != nullptr) {
+    for (Ptr<cs::Entry> entry = contentStore->Begin(); entry != contentStore->End();
+         entry = contentStore->Next(entry)) {
+      sizes[CONTENT_STORE].entries++;
+      sizes[CONTENT_STORE].bytes += sizeof(cs::Entry) + entry->GetData()->wireEncode().size();
+    }
+  }
+
+  for (int table = 0; table < TOTAL; table++) {
+    sizes[TOTAL].entries += sizes[table].entries;
+    sizes[TOTAL].bytes += sizes[table].bytes;
+  }
+  return sizes;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+TableSizeTracer::TableSizeTracer(shared_ptr<TraceSink> sink, const NodeContainer& nodes,
+                                 size_t topK)
+  : m_topK(topK)
+  , m_sink(sink)
+{
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<L3Protocol> l3 = (*node)->GetObject<L3Protocol>();
+    NS_ASSERT_MSG(l3 != nullptr, "NDN stack should be installed on the node");
+
+    std::string name = Names::FindName(*node);
+    if (name.empty()) {
+      name = boost::lexical_cast<std::string>((*node)->GetId());
+    }
+    m_nodes.push_back(NodeEntry{name, *node});
+  }
+}
+
+TableSizeTracer::~TableSizeTracer()
+{
+}
+
+const TraceSink::Columns&
+TableSizeTracer::GetColumns()
+{
+  static const TraceSink::Columns columns = {{"Time", TraceSink::DOUBLE},
+                                             {"Node", TraceSink::STRING},
+                                             {"Table", TraceSink::STRING},
+                                             {"Entries", TraceSink::INTEGER},
+                                             {"Bytes", TraceSink::INTEGER}};
+  return columns;
+}
+
+void
+TableSizeTracer::PrintHeader(std::ostream& os) const
+{
+  TraceSink::PrintColumnNames(os, GetColumns());
+}
+
+void
+TableSizeTracer::Print(std::ostream& os) const
+{
+  TextTraceSink sink(shared_ptr<std::ostream>(&os, std::bind([]{})));
+  Print(sink);
+}
+
+void
+TableSizeTracer::Print(TraceSink& sink) const
+{
+  double time = Simulator::Now().ToDouble(Time::S);
+
+  std::vector<TableSizes> sizes;
+  sizes.reserve(m_nodes.size());
+
+  TableSizes all;
+  all.fill(TableSize{0, 0});
+  for (const NodeEntry& node : m_nodes) {
+    sizes.push_back(GetTableSizes(node.node));
+    for (int table = 0; table < N_TABLES; table++) {
+      all[table].entries += sizes.back()[table].entries;
+      all[table].bytes += sizes.back()[table].bytes;
+    }
+  }
+  PrintSizes(sink, time, "all", all);
+
+  // nodes in the order of installation, or the top-K by total memory of the tables
+  std::vector<size_t> order(m_nodes.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  if (m_topK > 0 && m_topK < order.size()) {
+    std::partial_sort(order.begin(), order.begin() + m_topK, order.end(),
+                      [&sizes] (size_t a, size_t b) {
+                        return sizes[a][TOTAL].bytes > sizes[b][TOTAL].bytes
+                               || (sizes[a][TOTAL].bytes == sizes[b][TOTAL].bytes && a < b);
+                      });
+    order.resize(m_topK);
+  }
+  for (size_t i : order) {
+    PrintSizes(sink, time, m_nodes[i].name, sizes[i]);
+  }
+
+  sink.WriteRow(time, "process", "Rss", 0, MemUsage::Get());
+  sink.WriteRow(time, "process", "PeakRss", 0, MemUsage::GetPeak());
+}
+
+void
+TableSizeTracer::PrintSizes(TraceSink& sink, double time, const std::string& node,
+                            const TableSizes& sizes) const
+{
+  for (int table = 0; table < N_TABLES; table++) {
+    sink.WriteRow(time, node, GetTableName(static_cast<Table>(table)), sizes[table].entries,
+                  sizes[table].bytes);
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TABLE_SIZE_TRACER_H
+#define NDN_TABLE_SIZE_TRACER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-sink.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+#include <ns3/node-container.h>
+
+#include <array>
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief NDN tracer for the size and approximate memory of the forwarding tables
+ *
+ * Periodically samples the NFD tables (PIT, FIB, CS, Measurements, StrategyChoice,
+ * DeadNonceList, and NameTree), the ndnSIM ContentStore, and the KITE trace entries of each node,
+ * and writes them together with the resident set size (RSS) and peak RSS of the simulation
+ * process.  To keep the trace small for large topologies, only aggregates over all nodes and the
+ * top-K nodes by total table memory can be written each period.
+ *
+ * Trace entries are PIT entries of trace Interests, a breakdown of the PIT that is not added to
+ * the total.
+ */
+class TableSizeTracer : public SimpleRefCount<TableSizeTracer> {
+public:
+  /**
+   * @brief Helper method to install the tracer on all simulation nodes
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param period How often data will be written into the trace file (default, every second)
+   * @param topK Number of nodes with the largest tables written each period (0, all nodes)
+   * @param format Format of the trace file (default, tab-separated text)
+   */
+  static void
+  InstallAll(const std::string& file, Time period = Seconds(1.0), size_t topK = 0,
+             TraceSink::Format format = TraceSink::TEXT);
+
+  /**
+   * @brief Helper method to install the tracer on the selected simulation nodes
+   *
+   * @param nodes Nodes to be sampled by the tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param period How often data will be written into the trace file (default, every second)
+   * @param topK Number of nodes with the largest tables written each period (0, all nodes)
+   * @param format Format of the trace file (default, tab-separated text)
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file, Time period = Seconds(1.0),
+          size_t topK = 0, TraceSink::Format format = TraceSink::TEXT);
+
+  /**
+   * @brief Get columns of the trace
+   */
+  static const TraceSink::Columns&
+  GetColumns();
+
+  /**
+   * @brief Explicit request to remove all statically created tracers
+   *
+   * This method can be helpful if simulation scenario contains several independent run,
+   * or if it is desired to do a postprocessing of the resulting data
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Tables reported by the tracer
+   */
+  enum Table {
+    PIT,
+    FIB,
+    CS,
+    MEASUREMENTS,
+    STRATEGY_CHOICE,
+    DEAD_NONCE_LIST,
+    NAME_TREE,
+    CONTENT_STORE, ///< ndnSIM ContentStore, if installed on the node
+    TOTAL,         ///< sum of all above
+    TRACE_ENTRIES, ///< KITE trace entries of L3Protocol, held in the PIT, so not part of TOTAL
+    N_TABLES
+  };
+
+  /**
+   * @brief Number of entries and approximate memory of a table
+   */
+  struct TableSize {
+    uint64_t entries;
+    uint64_t bytes;
+  };
+
+  typedef std::array<TableSize, N_TABLES> TableSizes;
+
+  /**
+   * @brief Get name of the table, as written to the trace
+   */
+  static const char*
+  GetTableName(Table table);
+
+  /**
+   * @brief Sample the tables of a node
+   *
+   * Entries of the PIT, FIB, and both content stores are walked to account for the packets and
+   * records they hold, while other tables are estimated from the number of entries.
+   */
+  static TableSizes
+  GetTableSizes(Ptr<Node> node);
+
+  /**
+   * @brief Trace constructor that samples the selected nodes
+   * @param sink  sink of the trace
+   * @param nodes nodes to be sampled
+   * @param topK  number of nodes with the largest tables written each period (0, all nodes)
+   */
+  TableSizeTracer(shared_ptr<TraceSink> sink, const NodeContainer& nodes, size_t topK);
+
+  /**
+   * @brief Destructor
+   */
+  ~TableSizeTracer();
+
+  /**
+   * @brief Print head of the trace (e.g., for post-processing)
+   *
+   * @param os reference to output stream
+   */
+  void
+  PrintHeader(std::ostream& os) const;
+
+  /**
+   * @brief Print current trace data
+   *
+   * @param os reference to output stream
+   */
+  void
+  Print(std::ostream& os) const;
+
+  /**
+   * @brief Write current trace data to the sink
+   */
+  void
+  Print(TraceSink& sink) const;
+
+private:
+  void
+  PrintSizes(TraceSink& sink, double time, const std::string& node, const TableSizes& sizes) const;
+
+private:
+  struct NodeEntry {
+    std::string name;
+    Ptr<Node> node;
+  };
+
+  std::vector<NodeEntry> m_nodes;
+  size_t m_topK;
+
+  shared_ptr<TraceSink> m_sink;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TABLE_SIZE_TRACER_H
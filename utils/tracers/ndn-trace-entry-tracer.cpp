@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-entry-tracer.hpp"
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/boolean.h"
+
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "ns3/ndnSIM/utils/tracers/ndn-tracer-registry.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceEntryTracer");
+
+namespace ns3 {
+namespace ndn {
+
+void
+TraceEntryTracer::Destroy()
+{
+  TracerRegistry::Get().Remove("TraceEntryTracer");
+}
+
+void
+TraceEntryTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/,
+                             TraceSink::Format format /* = TraceSink::TEXT*/)
+{
+  Install(NodeContainer::GetGlobal(), file, averagingPeriod, format);
+}
+
+void
+TraceEntryTracer::Install(const NodeContainer& nodes, const std::string& file,
+                          Time averagingPeriod /* = Seconds (0.5)*/,
+                          TraceSink::Format format /* = TraceSink::TEXT*/)
+{
+  shared_ptr<TraceSink> sink = TraceSink::Open(file, format);
+  if (sink == nullptr) {
+    return;
+  }
+  sink->SetColumns(GetColumns());
+
+  auto tracers = make_shared<std::vector<Ptr<TraceEntryTracer>>>();
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    if ((*node)->GetObject<L3Protocol>() == nullptr) {
+      continue;
+    }
+    NS_LOG_DEBUG("Node: " << (*node)->GetId());
+    tracers->push_back(Create<TraceEntryTracer>(sink, *node));
+  }
+
+  Register(sink, tracers, averagingPeriod);
+}
+
+void
+TraceEntryTracer::Install(Ptr<Node> node, const std::string& file,
+                          Time averagingPeriod /* = Seconds (0.5)*/,
+                          TraceSink::Format format /* = TraceSink::TEXT*/)
+{
+  Install(NodeContainer(node), file, averagingPeriod, format);
+}
+
+Ptr<TraceEntryTracer>
+TraceEntryTracer::Install(Ptr<Node> node, shared_ptr<TraceSink> sink,
+                          Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<TraceEntryTracer> trace = Create<TraceEntryTracer>(sink, node);
+  Register(sink, make_shared<std::vector<Ptr<TraceEntryTracer>>>(1, trace), averagingPeriod);
+
+  return trace;
+}
+
+void
+TraceEntryTracer::Register(shared_ptr<TraceSink> sink,
+                           shared_ptr<std::vector<Ptr<TraceEntryTracer>>> tracers,
+                           Time averagingPeriod)
+{
+  const std::vector<Ptr<TraceEntryTracer>>* group = tracers.get();
+  TracerRegistry::Get().Add("TraceEntryTracer", sink, tracers, averagingPeriod,
+                            [group] (TraceSink& sink) {
+                              for (const auto& trace : *group) {
+                                trace->Print(sink);
+                                trace->Reset();
+                              }
+                            });
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+TraceEntryTracer::TraceEntryTracer(shared_ptr<TraceSink> sink, Ptr<Node> node)
+  : m_l3(node->GetObject<L3Protocol>())
+  , m_sink(sink)
+{
+  NS_ASSERT_MSG(m_l3 != nullptr, "NDN stack should be installed on the node");
+
+  m_node = boost::lexical_cast<std::string>(node->GetId());
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+
+  m_l3->SetAttribute("TraceAccounting", BooleanValue(true));
+  Reset();
+}
+
+TraceEntryTracer::~TraceEntryTracer()
+{
+}
+
+const TraceSink::Columns&
+TraceEntryTracer::GetColumns()
+{
+  static const TraceSink::Columns columns = {{"Time", TraceSink::DOUBLE},
+                                             {"Node", TraceSink::STRING},
+                                             {"Type", TraceSink::STRING},
+                                             {"Value", TraceSink::DOUBLE}};
+  return columns;
+}
+
+void
+TraceEntryTracer::PrintHeader(std::ostream& os) const
+{
+  TraceSink::PrintColumnNames(os, GetColumns());
+}
+
+void
+TraceEntryTracer::Reset()
+{
+  m_last = m_l3->getTraceEntryCounters();
+}
+
+#define PRINTER(printName, value) sink.WriteRow(time, m_node, printName, static_cast<double>(value));
+
+void
+TraceEntryTracer::Print(std::ostream& os) const
+{
+  TextTraceSink sink(shared_ptr<std::ostream>(&os, std::bind([]{})));
+  Print(sink);
+}
+
+void
+TraceEntryTracer::Print(TraceSink& sink) const
+{
+  double time = Simulator::Now().ToDouble(Time::S);
+  L3Protocol::TraceEntryCounters now = m_l3->getTraceEntryCounters();
+
+  PRINTER("Entries", now.entries);
+  PRINTER("Bytes", now.bytes);
+  PRINTER("Created", now.created - m_last.created);
+  PRINTER("Satisfied", now.satisfied - m_last.satisfied);
+  PRINTER("Expired", now.expired - m_last.expired);
+  PRINTER("Prolonged", now.prolonged - m_last.prolonged);
+  PRINTER("RemovedOnNack", now.removedOnNack - m_last.removedOnNack);
+
+  uint64_t ended = now.satisfied + now.expired - m_last.satisfied - m_last.expired;
+  if (ended > 0) {
+    PRINTER("MeanLifespan", (now.lifespan - m_last.lifespan).ToDouble(Time::S) / ended);
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
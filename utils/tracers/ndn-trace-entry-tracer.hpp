@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_ENTRY_TRACER_H
+#define NDN_TRACE_ENTRY_TRACER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-sink.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+#include <ns3/node-container.h>
+
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief NDN tracer for the footprint of KITE trace entries in the forwarder
+ *
+ * Enables TraceAccounting of L3Protocol on the node and periodically reports the number of trace
+ * entries in the PIT, their approximate memory, and how many of them were created, satisfied,
+ * and expired during the averaging period.  Prolongations (ProlongTrace) and removals on Nack
+ * (RemoveTrace) are not reported by the forwarder and are estimated, as described in
+ * L3Protocol::TraceEntryCounters.
+ */
+class TraceEntryTracer : public SimpleRefCount<TraceEntryTracer> {
+public:
+  /**
+   * @brief Helper method to install tracers on all simulation nodes
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *second)
+   * @param format Format of the trace file (default, tab-separated text)
+   */
+  static void
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5),
+             TraceSink::Format format = TraceSink::TEXT);
+
+  /**
+   * @brief Helper method to install tracers on the selected simulation nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *second)
+   * @param format Format of the trace file (default, tab-separated text)
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          TraceSink::Format format = TraceSink::TEXT);
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *second)
+   * @param format Format of the trace file (default, tab-separated text)
+   */
+  static void
+  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          TraceSink::Format format = TraceSink::TEXT);
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param sink Sink of the trace, its columns should be set to GetColumns()
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *second)
+   */
+  static Ptr<TraceEntryTracer>
+  Install(Ptr<Node> node, shared_ptr<TraceSink> sink, Time averagingPeriod = Seconds(0.5));
+
+  /**
+   * @brief Get columns of the trace
+   */
+  static const TraceSink::Columns&
+  GetColumns();
+
+  /**
+   * @brief Explicit request to remove all statically created tracers
+   *
+   * This method can be helpful if simulation scenario contains several independent run,
+   * or if it is desired to do a postprocessing of the resulting data
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param sink  sink of the trace
+   * @param node  pointer to the node
+   */
+  TraceEntryTracer(shared_ptr<TraceSink> sink, Ptr<Node> node);
+
+  /**
+   * @brief Destructor
+   */
+  ~TraceEntryTracer();
+
+  /**
+   * @brief Print head of the trace (e.g., for post-processing)
+   *
+   * @param os reference to output stream
+   */
+  void
+  PrintHeader(std::ostream& os) const;
+
+  /**
+   * @brief Print current trace data
+   *
+   * @param os reference to output stream
+   */
+  void
+  Print(std::ostream& os) const;
+
+  /**
+   * @brief Write current trace data to the sink
+   */
+  void
+  Print(TraceSink& sink) const;
+
+private:
+  /**
+   * @brief Register the tracers with TracerRegistry, which prints them every averaging period
+   */
+  static void
+  Register(shared_ptr<TraceSink> sink, shared_ptr<std::vector<Ptr<TraceEntryTracer>>> tracers,
+           Time averagingPeriod);
+
+  void
+  Reset();
+
+private:
+  std::string m_node;
+  Ptr<L3Protocol> m_l3;
+
+  shared_ptr<TraceSink> m_sink;
+
+  L3Protocol::TraceEntryCounters m_last; // counters at the beginning of the averaging period
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_ENTRY_TRACER_H
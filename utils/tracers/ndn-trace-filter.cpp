@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-filter.hpp"
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+
+TraceFilter::TraceFilter()
+  : m_sampling(1)
+{
+  m_counters.fill(0);
+}
+
+TraceFilter&
+TraceFilter::SetSampling(uint32_t n)
+{
+  m_sampling = std::max<uint32_t>(n, 1);
+  m_counters.fill(0);
+  return *this;
+}
+
+TraceFilter&
+TraceFilter::AddPrefix(const Name& prefix)
+{
+  std::string key;
+  for (const auto& component : prefix) {
+    key.append(reinterpret_cast<const char*>(component.wire()), component.size());
+  }
+  m_prefixes.insert(key);
+
+  auto length = std::lower_bound(m_prefixLengths.begin(), m_prefixLengths.end(), prefix.size());
+  if (length == m_prefixLengths.end() || *length != prefix.size()) {
+    m_prefixLengths.insert(length, prefix.size());
+  }
+  return *this;
+}
+
+TraceFilter&
+TraceFilter::AddFace(nfd::FaceId faceId)
+{
+  auto face = std::lower_bound(m_faces.begin(), m_faces.end(), faceId);
+  if (face == m_faces.end() || *face != faceId) {
+    m_faces.insert(face, faceId);
+  }
+  return *this;
+}
+
+bool
+TraceFilter::AcceptFace(nfd::FaceId faceId) const
+{
+  return m_faces.empty() || std::binary_search(m_faces.begin(), m_faces.end(), faceId);
+}
+
+bool
+TraceFilter::AcceptName(const Name& name)
+{
+  if (m_prefixes.empty()) {
+    return true;
+  }
+
+  // the key is extended only up to the lengths of the selected prefixes
+  m_key.clear();
+  size_t next = 0;
+  for (size_t length : m_prefixLengths) {
+    if (length > name.size()) {
+      break;
+    }
+    for (; next < length; next++) {
+      m_key.append(reinterpret_cast<const char*>(name[next].wire()), name[next].size());
+    }
+    if (m_prefixes.count(m_key) > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_FILTER_H
+#define NDN_TRACE_FILTER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <array>
+#include <unordered_set>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Selection of events traced by L3Tracer subclasses and AppDelayTracer
+ *
+ * An event is traced if it passes all configured criteria:
+ *
+ * - its face is one of the selected faces (only for events with a face)
+ * - its name is under one of the selected prefixes
+ * - it is every n-th event of its kind that passed the criteria above
+ *
+ * Each tracer uses its own copy of the filter, so the sampling counters are per tracer.  Tracers
+ * multiply counts of the sampled events by the sampling factor (GetWeight).
+ */
+class TraceFilter {
+public:
+  /**
+   * @brief Maximum number of kinds of events sampled independently
+   */
+  static const size_t MAX_EVENTS = 16;
+
+  /**
+   * @brief Create a filter that accepts all events
+   */
+  TraceFilter();
+
+  /**
+   * @brief Trace only one of every @p n events of each kind
+   */
+  TraceFilter&
+  SetSampling(uint32_t n);
+
+  /**
+   * @brief Trace only names under the prefix (or any other added prefix)
+   */
+  TraceFilter&
+  AddPrefix(const Name& prefix);
+
+  /**
+   * @brief Trace only events on the face (or any other added face)
+   */
+  TraceFilter&
+  AddFace(nfd::FaceId faceId);
+
+  /**
+   * @brief Factor by which counts of traced events should be multiplied
+   */
+  double
+  GetWeight() const
+  {
+    return m_sampling;
+  }
+
+  bool
+  IsAcceptingAll() const
+  {
+    return m_sampling == 1 && m_prefixes.empty() && m_faces.empty();
+  }
+
+  /**
+   * @brief Check all criteria
+   * @param event kind of the event, less than MAX_EVENTS
+   * @param face face of the event, or nullptr if the event is not related to a face
+   */
+  bool
+  Accept(size_t event, const Name& name, const Face* face)
+  {
+    return (face == nullptr || AcceptFace(face->getId())) && AcceptName(name) && Sample(event);
+  }
+
+  bool
+  AcceptFace(nfd::FaceId faceId) const;
+
+  bool
+  AcceptName(const Name& name);
+
+  /**
+   * @brief Advance the sampling counter of the event kind
+   * @return true, if the event should be traced
+   */
+  bool
+  Sample(size_t event)
+  {
+    if (m_sampling == 1) {
+      return true;
+    }
+    if (++m_counters[event] < m_sampling) {
+      return false;
+    }
+    m_counters[event] = 0;
+    return true;
+  }
+
+private:
+  uint32_t m_sampling;
+  std::array<uint32_t, MAX_EVENTS> m_counters;
+
+  std::unordered_set<std::string> m_prefixes; // wire encodings of the components
+  std::vector<size_t> m_prefixLengths;        // distinct numbers of components, sorted
+  std::string m_key;                          // reusable buffer for prefix lookups
+
+  std::vector<nfd::FaceId> m_faces; // sorted
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_FILTER_H
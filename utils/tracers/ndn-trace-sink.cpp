@@ -0,0 +1,602 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-trace-sink.hpp"
+
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/global-value.h"
+#include "ns3/simulator.h"
+
+#include <cryptopp/filters.h>
+#include <cryptopp/zdeflate.h>
+#include <cryptopp/zinflate.h>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceSink");
+
+namespace ns3 {
+namespace ndn {
+
+static const char BINARY_TRACE_MAGIC[8] = {'n', 'd', 'n', 'T', 'r', 'a', 'c', 'e'};
+static const uint32_t BINARY_TRACE_VERSION = 1;
+
+// fast compression is enough, as columns of a block are mostly repeated values
+static const int BINARY_TRACE_DEFLATE_LEVEL = 1;
+
+static GlobalValue g_asyncTraces("NdnAsyncTraces",
+                                 "Format and write traces in a background thread",
+                                 BooleanValue(false), MakeBooleanChecker());
+
+static void
+FlushIfAlive(std::weak_ptr<TraceSink> sink)
+{
+  shared_ptr<TraceSink> alive = sink.lock();
+  if (alive != nullptr) {
+    alive->Flush();
+  }
+}
+
+shared_ptr<TraceSink>
+TraceSink::Open(const std::string& file, Format format /* = TEXT*/)
+{
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+    if (format == BINARY) {
+      mode |= std::ios_base::binary;
+    }
+
+    shared_ptr<std::ofstream> os(new std::ofstream());
+    os->open(file.c_str(), mode);
+
+    if (!os->is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return nullptr;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  shared_ptr<TraceSink> sink;
+  if (format == BINARY) {
+    sink = make_shared<BinaryTraceSink>(outputStream);
+  }
+  else {
+    sink = make_shared<TextTraceSink>(outputStream);
+  }
+
+  BooleanValue isAsync;
+  g_asyncTraces.GetValue(isAsync);
+  if (isAsync.Get()) {
+    sink = make_shared<AsyncTraceSink>(sink);
+    // rows of sinks outliving the simulation must still reach the file at its end
+    Simulator::ScheduleDestroy(&FlushIfAlive, std::weak_ptr<TraceSink>(sink));
+  }
+  return sink;
+}
+
+void
+TraceSink::PrintColumnNames(std::ostream& os, const Columns& columns)
+{
+  for (size_t i = 0; i < columns.size(); i++) {
+    if (i > 0) {
+      os << "\t";
+    }
+    os << columns[i].name;
+  }
+}
+
+TraceSink::~TraceSink()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+TextTraceSink::TextTraceSink(shared_ptr<std::ostream> os)
+  : m_os(os)
+  , m_rowStarted(false)
+{
+}
+
+void
+TextTraceSink::SetColumns(const Columns& columns)
+{
+  PrintColumnNames(*m_os, columns);
+  *m_os << "\n";
+}
+
+void
+TextTraceSink::Flush()
+{
+  m_os->flush();
+}
+
+void
+TextTraceSink::AddString(const char* value, size_t length)
+{
+  Separate();
+  m_os->write(value, length);
+}
+
+void
+TextTraceSink::AddInteger(int64_t value)
+{
+  Separate();
+  *m_os << value;
+}
+
+void
+TextTraceSink::AddDouble(double value)
+{
+  Separate();
+  *m_os << value;
+}
+
+void
+TextTraceSink::EndRow()
+{
+  *m_os << "\n";
+  m_rowStarted = false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+BinaryTraceSink::BinaryTraceSink(shared_ptr<std::ostream> os,
+                                 size_t blockRows /* = DEFAULT_BLOCK_ROWS*/)
+  : m_os(os)
+  , m_blockRows(blockRows)
+  , m_column(0)
+  , m_nRows(0)
+  , m_nNewStrings(0)
+{
+}
+
+BinaryTraceSink::~BinaryTraceSink()
+{
+  Flush();
+}
+
+void
+BinaryTraceSink::SetColumns(const Columns& columns)
+{
+  NS_ASSERT_MSG(m_columns.empty(), "Columns of the trace can be set only once");
+
+  m_columns = columns;
+  m_values.resize(m_columns.size());
+
+  std::string header(BINARY_TRACE_MAGIC, sizeof(BINARY_TRACE_MAGIC));
+  Append(header, BINARY_TRACE_VERSION);
+  Append(header, static_cast<uint32_t>(m_columns.size()));
+  for (const Column& column : m_columns) {
+    Append(header, static_cast<uint8_t>(column.type));
+    Append(header, static_cast<uint32_t>(column.name.size()));
+    header.append(column.name);
+  }
+  m_os->write(header.data(), header.size());
+}
+
+void
+BinaryTraceSink::Flush()
+{
+  WriteBlock();
+  m_os->flush();
+}
+
+std::string&
+BinaryTraceSink::NextColumn(ColumnType type)
+{
+  NS_ASSERT_MSG(m_column < m_columns.size(), "Row has more values than the trace has columns");
+  NS_ASSERT_MSG(m_columns[m_column].type == type,
+                "Value does not match the type of column " << m_columns[m_column].name);
+  return m_values[m_column++];
+}
+
+void
+BinaryTraceSink::AddString(const char* value, size_t length)
+{
+  std::string& column = NextColumn(STRING);
+
+  m_key.assign(value, length);
+  auto entry = m_dictionary.find(m_key);
+  if (entry == m_dictionary.end()) {
+    entry = m_dictionary.insert(std::make_pair(m_key, m_dictionary.size())).first;
+
+    Append(m_newStrings, static_cast<uint32_t>(length));
+    m_newStrings.append(value, length);
+    m_nNewStrings++;
+  }
+  Append(column, entry->second);
+}
+
+void
+BinaryTraceSink::AddInteger(int64_t value)
+{
+  Append(NextColumn(INTEGER), value);
+}
+
+void
+BinaryTraceSink::AddDouble(double value)
+{
+  Append(NextColumn(DOUBLE), value);
+}
+
+void
+BinaryTraceSink::EndRow()
+{
+  NS_ASSERT_MSG(m_column == m_columns.size(), "Row has fewer values than the trace has columns");
+  m_column = 0;
+  m_nRows++;
+
+  if (m_nRows >= m_blockRows) {
+    WriteBlock();
+  }
+}
+
+void
+BinaryTraceSink::WriteBlock()
+{
+  if (m_nRows == 0) {
+    return;
+  }
+
+  m_raw = m_newStrings;
+  for (std::string& column : m_values) {
+    m_raw.append(column);
+    column.clear();
+  }
+
+  m_compressed.clear();
+  CryptoPP::Deflator deflator(new CryptoPP::StringSink(m_compressed), BINARY_TRACE_DEFLATE_LEVEL);
+  deflator.Put(reinterpret_cast<const uint8_t*>(m_raw.data()), m_raw.size());
+  deflator.MessageEnd();
+
+  std::string header;
+  Append(header, m_nRows);
+  Append(header, m_nNewStrings);
+  Append(header, static_cast<uint32_t>(m_raw.size()));
+  Append(header, static_cast<uint32_t>(m_compressed.size()));
+  m_os->write(header.data(), header.size());
+  m_os->write(m_compressed.data(), m_compressed.size());
+
+  m_nRows = 0;
+  m_newStrings.clear();
+  m_nNewStrings = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+AsyncTraceSink::AsyncTraceSink(shared_ptr<TraceSink> sink,
+                               size_t capacity /* = DEFAULT_CAPACITY*/)
+  : m_sink(sink)
+  , m_head(0)
+  , m_tail(0)
+  , m_isStopping(false)
+  , m_nStalls(0)
+{
+  size_t size = 2;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  m_ring.resize(size);
+  m_mask = size - 1;
+
+  m_thread = std::thread(&AsyncTraceSink::Run, this);
+}
+
+AsyncTraceSink::~AsyncTraceSink()
+{
+  m_isStopping.store(true, std::memory_order_release);
+  Wake();
+  m_thread.join();
+
+  m_sink->Flush();
+  NS_LOG_INFO("Writer thread stopped, " << m_nStalls << " stalls on full ring buffer");
+}
+
+void
+AsyncTraceSink::SetColumns(const Columns& columns)
+{
+  // called before the first row, when the writer thread does not touch the wrapped sink yet
+  m_sink->SetColumns(columns);
+}
+
+void
+AsyncTraceSink::Flush()
+{
+  Record record;
+  record.type = RECORD_FLUSH;
+  Push(record);
+
+  size_t head = m_head.load(std::memory_order_relaxed);
+  while (m_tail.load(std::memory_order_acquire) != head) {
+    Wake();
+    std::this_thread::yield();
+  }
+}
+
+void
+AsyncTraceSink::AddString(const char* value, size_t length)
+{
+  m_key.assign(value, length);
+
+  Record record;
+  record.type = RECORD_STRING;
+  record.string = &*m_strings.insert(m_key).first;
+  Push(record);
+}
+
+void
+AsyncTraceSink::AddInteger(int64_t value)
+{
+  Record record;
+  record.type = RECORD_INTEGER;
+  record.integer = value;
+  Push(record);
+}
+
+void
+AsyncTraceSink::AddDouble(double value)
+{
+  Record record;
+  record.type = RECORD_DOUBLE;
+  record.real = value;
+  Push(record);
+}
+
+void
+AsyncTraceSink::EndRow()
+{
+  Record record;
+  record.type = RECORD_END_ROW;
+  Push(record);
+}
+
+void
+AsyncTraceSink::Push(const Record& record)
+{
+  size_t head = m_head.load(std::memory_order_relaxed);
+  size_t used = head - m_tail.load(std::memory_order_acquire);
+
+  if (used == m_ring.size()) {
+    m_nStalls++;
+    do {
+      Wake();
+      std::this_thread::yield();
+    } while (head - m_tail.load(std::memory_order_acquire) == m_ring.size());
+  }
+
+  m_ring[head & m_mask] = record;
+  m_head.store(head + 1, std::memory_order_release);
+
+  // the writer thread also polls periodically, so it is woken up only when there is enough work
+  if (used + 1 == m_ring.size() / 2) {
+    Wake();
+  }
+}
+
+void
+AsyncTraceSink::Wake()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_wakeup.notify_one();
+}
+
+void
+AsyncTraceSink::Run()
+{
+  size_t tail = m_tail.load(std::memory_order_relaxed);
+  while (true) {
+    size_t head = m_head.load(std::memory_order_acquire);
+    if (tail == head) {
+      if (m_isStopping.load(std::memory_order_acquire)
+          && m_head.load(std::memory_order_acquire) == tail) {
+        break;
+      }
+
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wakeup.wait_for(lock, std::chrono::milliseconds(10));
+      continue;
+    }
+
+    for (; tail != head; tail++) {
+      Apply(m_ring[tail & m_mask]);
+    }
+    m_tail.store(tail, std::memory_order_release);
+  }
+}
+
+void
+AsyncTraceSink::Apply(const Record& record)
+{
+  switch (record.type) {
+  case RECORD_STRING:
+    m_sink->AddString(record.string->data(), record.string->size());
+    break;
+  case RECORD_INTEGER:
+    m_sink->AddInteger(record.integer);
+    break;
+  case RECORD_DOUBLE:
+    m_sink->AddDouble(record.real);
+    break;
+  case RECORD_END_ROW:
+    m_sink->EndRow();
+    break;
+  case RECORD_FLUSH:
+    m_sink->Flush();
+    break;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+T
+BinaryTraceReader::Read()
+{
+  T value;
+  if (!m_is.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+    throw Error("Binary trace is truncated");
+  }
+  return value;
+}
+
+template<typename T>
+T
+BinaryTraceReader::Get(const std::string& buffer, size_t& offset)
+{
+  if (offset + sizeof(T) > buffer.size()) {
+    throw Error("Block of the binary trace is malformed");
+  }
+
+  T value;
+  std::memcpy(&value, buffer.data() + offset, sizeof(value));
+  offset += sizeof(value);
+  return value;
+}
+
+BinaryTraceReader::BinaryTraceReader(std::istream& is)
+  : m_is(is)
+{
+  char magic[sizeof(BINARY_TRACE_MAGIC)];
+  if (!m_is.read(magic, sizeof(magic))
+      || std::memcmp(magic, BINARY_TRACE_MAGIC, sizeof(magic)) != 0) {
+    throw Error("Not a binary trace");
+  }
+
+  uint32_t version = Read<uint32_t>();
+  if (version != BINARY_TRACE_VERSION) {
+    throw Error("Unsupported version of binary trace: " + std::to_string(version));
+  }
+
+  uint32_t nColumns = Read<uint32_t>();
+  for (uint32_t i = 0; i < nColumns; i++) {
+    TraceSink::Column column;
+    uint8_t type = Read<uint8_t>();
+    if (type > TraceSink::DOUBLE) {
+      throw Error("Unknown column type: " + std::to_string(type));
+    }
+    column.type = static_cast<TraceSink::ColumnType>(type);
+
+    column.name.resize(Read<uint32_t>());
+    if (!m_is.read(&column.name[0], column.name.size())) {
+      throw Error("Binary trace is truncated");
+    }
+    m_columns.push_back(column);
+  }
+}
+
+void
+BinaryTraceReader::ConvertToText(std::ostream& os)
+{
+  TraceSink::PrintColumnNames(os, m_columns);
+  os << "\n";
+
+  std::string compressed;
+  std::string raw;
+  std::vector<size_t> offsets(m_columns.size());
+
+  while (m_is.peek() != std::char_traits<char>::eof()) {
+    uint32_t nRows = Read<uint32_t>();
+    uint32_t nNewStrings = Read<uint32_t>();
+    uint32_t rawSize = Read<uint32_t>();
+    uint32_t compressedSize = Read<uint32_t>();
+
+    compressed.resize(compressedSize);
+    if (!m_is.read(&compressed[0], compressedSize)) {
+      throw Error("Binary trace is truncated");
+    }
+
+    raw.clear();
+    try {
+      CryptoPP::Inflator inflator(new CryptoPP::StringSink(raw));
+      inflator.Put(reinterpret_cast<const uint8_t*>(compressed.data()), compressed.size());
+      inflator.MessageEnd();
+    }
+    catch (const CryptoPP::Exception& e) {
+      throw Error(std::string("Block of the binary trace cannot be decompressed: ") + e.what());
+    }
+    if (raw.size() != rawSize) {
+      throw Error("Block of the binary trace is malformed");
+    }
+
+    size_t offset = 0;
+    for (uint32_t i = 0; i < nNewStrings; i++) {
+      uint32_t length = Get<uint32_t>(raw, offset);
+      if (offset + length > raw.size()) {
+        throw Error("Block of the binary trace is malformed");
+      }
+      m_dictionary.push_back(raw.substr(offset, length));
+      offset += length;
+    }
+
+    for (size_t column = 0; column < m_columns.size(); column++) {
+      offsets[column] = offset;
+      offset += nRows * (m_columns[column].type == TraceSink::STRING ? sizeof(uint32_t)
+                                                                     : sizeof(int64_t));
+    }
+    if (offset != raw.size()) {
+      throw Error("Block of the binary trace is malformed");
+    }
+
+    for (uint32_t row = 0; row < nRows; row++) {
+      for (size_t column = 0; column < m_columns.size(); column++) {
+        if (column > 0) {
+          os << "\t";
+        }
+
+        switch (m_columns[column].type) {
+        case TraceSink::STRING: {
+          uint32_t id = Get<uint32_t>(raw, offsets[column]);
+          if (id >= m_dictionary.size()) {
+            throw Error("Unknown string id in the binary trace: " + std::to_string(id));
+          }
+          os << m_dictionary[id];
+          break;
+        }
+        case TraceSink::INTEGER:
+          os << Get<int64_t>(raw, offsets[column]);
+          break;
+        case TraceSink::DOUBLE:
+          os << Get<double>(raw, offsets[column]);
+          break;
+        }
+      }
+      os << "\n";
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
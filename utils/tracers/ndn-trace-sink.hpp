@@ -0,0 +1,427 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACE_SINK_H
+#define NDN_TRACE_SINK_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Output of tracers: rows of values in typed columns
+ *
+ * Tracers declare their columns once and write each row with WriteRow, leaving the formatting to
+ * the sink.  A sink can be shared by several tracers of the same kind.
+ */
+class TraceSink {
+public:
+  enum Format {
+    TEXT,  ///< tab-separated values, with names of the columns in the first row
+    BINARY ///< compressed columnar blocks, see BinaryTraceSink
+  };
+
+  enum ColumnType {
+    STRING,  ///< e.g., node name or type of measurement
+    INTEGER, ///< signed 64-bit integer, e.g., face id or sequence number
+    DOUBLE   ///< e.g., time or rate
+  };
+
+  struct Column {
+    std::string name;
+    ColumnType type;
+  };
+
+  typedef std::vector<Column> Columns;
+
+  /**
+   * @brief Create a sink writing to the file
+   * @param file name of the file, or - for std::cout
+   * @param format format of the output
+   * @return nullptr if the file cannot be opened for writing
+   *
+   * If the global value NdnAsyncTraces is true (e.g., --NdnAsyncTraces=1 on the command line),
+   * the sink is wrapped into AsyncTraceSink, which is flushed on Simulator::Destroy.
+   */
+  static shared_ptr<TraceSink>
+  Open(const std::string& file, Format format = TEXT);
+
+  /**
+   * @brief Print names of the columns, separated by tabs
+   */
+  static void
+  PrintColumnNames(std::ostream& os, const Columns& columns);
+
+  virtual ~TraceSink();
+
+  /**
+   * @brief Declare columns of the trace, must be called once before the first row
+   */
+  virtual void
+  SetColumns(const Columns& columns) = 0;
+
+  /**
+   * @brief Write a row, values must follow the order and types of the columns
+   */
+  template<typename... Values>
+  void
+  WriteRow(const Values&... values)
+  {
+    int expand[] = {(Add(values), 0)...};
+    (void)expand;
+    EndRow();
+  }
+
+  /**
+   * @brief Write out buffered rows
+   */
+  virtual void
+  Flush() = 0;
+
+protected:
+  virtual void
+  AddString(const char* value, size_t length) = 0;
+
+  virtual void
+  AddInteger(int64_t value) = 0;
+
+  virtual void
+  AddDouble(double value) = 0;
+
+  virtual void
+  EndRow() = 0;
+
+private:
+  friend class AsyncTraceSink;
+
+  void
+  Add(const std::string& value)
+  {
+    AddString(value.data(), value.size());
+  }
+
+  void
+  Add(const char* value)
+  {
+    AddString(value, std::char_traits<char>::length(value));
+  }
+
+  void
+  Add(double value)
+  {
+    AddDouble(value);
+  }
+
+  template<typename T>
+  typename std::enable_if<std::is_integral<T>::value>::type
+  Add(T value)
+  {
+    AddInteger(static_cast<int64_t>(value));
+  }
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Sink writing tab-separated values, the traditional format of ndnSIM tracers
+ */
+class TextTraceSink : public TraceSink {
+public:
+  explicit TextTraceSink(shared_ptr<std::ostream> os);
+
+  virtual void
+  SetColumns(const Columns& columns);
+
+  virtual void
+  Flush();
+
+protected:
+  virtual void
+  AddString(const char* value, size_t length);
+
+  virtual void
+  AddInteger(int64_t value);
+
+  virtual void
+  AddDouble(double value);
+
+  virtual void
+  EndRow();
+
+private:
+  void
+  Separate()
+  {
+    if (m_rowStarted) {
+      *m_os << '\t';
+    }
+    m_rowStarted = true;
+  }
+
+private:
+  shared_ptr<std::ostream> m_os;
+  bool m_rowStarted;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Sink writing rows in compressed columnar blocks
+ *
+ * The file starts with the magic "ndnTrace", version (uint32), number of columns (uint32), and
+ * for each column its type (uint8), length of the name (uint32), and the name.  It is followed by
+ * blocks of up to BlockRows rows, each with a header of four uint32 fields (number of rows,
+ * number of new dictionary strings, raw size, compressed size) and deflate-compressed payload:
+ *
+ * - strings added to the dictionary since the previous block, each as length (uint32) and bytes;
+ *   the dictionary is shared by all string columns, and ids are assigned in the order of addition
+ * - values of each column in turn: uint32 dictionary ids for STRING, int64 for INTEGER, and IEEE
+ *   754 double for DOUBLE columns
+ *
+ * Numbers are in the byte order of the host.  Use BinaryTraceReader to convert to text.
+ */
+class BinaryTraceSink : public TraceSink {
+public:
+  static const size_t DEFAULT_BLOCK_ROWS = 4096;
+
+  explicit BinaryTraceSink(shared_ptr<std::ostream> os, size_t blockRows = DEFAULT_BLOCK_ROWS);
+
+  /**
+   * @brief Write out the last block
+   */
+  ~BinaryTraceSink();
+
+  virtual void
+  SetColumns(const Columns& columns);
+
+  virtual void
+  Flush();
+
+protected:
+  virtual void
+  AddString(const char* value, size_t length);
+
+  virtual void
+  AddInteger(int64_t value);
+
+  virtual void
+  AddDouble(double value);
+
+  virtual void
+  EndRow();
+
+private:
+  template<typename T>
+  void
+  Append(std::string& buffer, T value)
+  {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  std::string&
+  NextColumn(ColumnType type);
+
+  void
+  WriteBlock();
+
+private:
+  shared_ptr<std::ostream> m_os;
+  size_t m_blockRows;
+
+  Columns m_columns;
+  std::vector<std::string> m_values; // values of the current block, by column
+  size_t m_column;                   // column of the next value
+  uint32_t m_nRows;                  // rows in the current block
+
+  std::unordered_map<std::string, uint32_t> m_dictionary;
+  std::string m_newStrings; // dictionary additions of the current block
+  uint32_t m_nNewStrings;
+  std::string m_key; // reusable buffer for dictionary lookups
+
+  std::string m_raw;        // reusable buffer for the block payload
+  std::string m_compressed; // reusable buffer for the compressed payload
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Sink passing rows to another sink, which formats and writes them in a background thread
+ *
+ * The simulation thread only appends fixed-size records (one per value and one per end of row)
+ * to a lock-free single-producer single-consumer ring buffer.  Strings are interned, so a record
+ * carries a pointer to the string that stays valid for the lifetime of the sink.  When the ring is
+ * full, the simulation thread waits for the writer thread to catch up.
+ *
+ * Flush() returns after all rows written so far have been passed to the wrapped sink and it has
+ * been flushed.  The destructor writes out all remaining rows before destroying the wrapped sink.
+ */
+class AsyncTraceSink : public TraceSink {
+public:
+  static const size_t DEFAULT_CAPACITY = 65536;
+
+  /**
+   * @param sink sink to write the rows to, used only by the writer thread after SetColumns
+   * @param capacity number of records in the ring buffer, rounded up to a power of two
+   */
+  explicit AsyncTraceSink(shared_ptr<TraceSink> sink, size_t capacity = DEFAULT_CAPACITY);
+
+  /**
+   * @brief Write out all remaining rows and stop the writer thread
+   */
+  ~AsyncTraceSink();
+
+  virtual void
+  SetColumns(const Columns& columns);
+
+  virtual void
+  Flush();
+
+  /**
+   * @brief Number of times the simulation thread had to wait for space in the ring buffer
+   */
+  uint64_t
+  GetStalls() const
+  {
+    return m_nStalls;
+  }
+
+protected:
+  virtual void
+  AddString(const char* value, size_t length);
+
+  virtual void
+  AddInteger(int64_t value);
+
+  virtual void
+  AddDouble(double value);
+
+  virtual void
+  EndRow();
+
+private:
+  enum RecordType : uint8_t {
+    RECORD_STRING,
+    RECORD_INTEGER,
+    RECORD_DOUBLE,
+    RECORD_END_ROW,
+    RECORD_FLUSH
+  };
+
+  struct Record {
+    RecordType type;
+    union {
+      const std::string* string;
+      int64_t integer;
+      double real;
+    };
+  };
+
+  void
+  Push(const Record& record);
+
+  void
+  Wake();
+
+  void
+  Run();
+
+  void
+  Apply(const Record& record);
+
+private:
+  shared_ptr<TraceSink> m_sink;
+
+  std::vector<Record> m_ring;
+  size_t m_mask;
+  std::atomic<size_t> m_head; // next record to write, advanced by the simulation thread
+  std::atomic<size_t> m_tail; // next record to read, advanced by the writer thread
+  std::atomic<bool> m_isStopping;
+  uint64_t m_nStalls;
+
+  // owned by the simulation thread, nodes are never moved or erased
+  std::unordered_set<std::string> m_strings;
+  std::string m_key; // reusable buffer for string lookups
+
+  std::mutex m_mutex;
+  std::condition_variable m_wakeup;
+  std::thread m_thread;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Reader of traces written by BinaryTraceSink
+ */
+class BinaryTraceReader {
+public:
+  class Error : public std::runtime_error {
+  public:
+    explicit Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /**
+   * @brief Read the file header
+   * @throw Error the stream does not contain a binary trace
+   */
+  explicit BinaryTraceReader(std::istream& is);
+
+  const TraceSink::Columns&
+  GetColumns() const
+  {
+    return m_columns;
+  }
+
+  /**
+   * @brief Convert the remaining blocks to tab-separated values, the same as written by
+   *        TextTraceSink, including the header
+   * @throw Error the trace is truncated or malformed
+   */
+  void
+  ConvertToText(std::ostream& os);
+
+private:
+  template<typename T>
+  T
+  Read();
+
+  template<typename T>
+  static T
+  Get(const std::string& buffer, size_t& offset);
+
+private:
+  std::istream& m_is;
+  TraceSink::Columns m_columns;
+  std::vector<std::string> m_dictionary;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACE_SINK_H
@@ -0,0 +1,265 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-tracer-registry.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TracerRegistry");
+
+namespace ns3 {
+namespace ndn {
+
+TracerRegistry&
+TracerRegistry::Get()
+{
+  static TracerRegistry registry;
+  return registry;
+}
+
+TracerRegistry::TracerRegistry()
+  : m_lastId(0)
+  , m_isPrinting(false)
+  , m_isHooked(false)
+{
+}
+
+TracerRegistry::~TracerRegistry()
+{
+  Clear();
+}
+
+TracerRegistry::GroupId
+TracerRegistry::Add(const std::string& type, shared_ptr<TraceSink> sink, shared_ptr<void> tracers,
+                    Time period /* = Time(0)*/, const Printer& printer /* = Printer()*/)
+{
+  NS_ASSERT_MSG(period.IsStrictlyPositive() == static_cast<bool>(printer),
+                "Printer and period should be either both set or both unset");
+
+  if (!m_isHooked) {
+    // events of the ticks, as well as traced nodes, are gone with the simulator
+    Simulator::ScheduleDestroy(&TracerRegistry::OnSimulatorDestroy, this);
+    m_isHooked = true;
+  }
+
+  GroupId id = ++m_lastId;
+  NS_LOG_DEBUG("Add " << type << " group " << id << ", period " << period);
+
+  Group group{id, type, sink, tracers, printer, false};
+  if (m_isPrinting) {
+    m_added.push_back(std::make_pair(std::move(group), period));
+  }
+  else {
+    Insert(std::move(group), period);
+  }
+  return id;
+}
+
+bool
+TracerRegistry::Remove(GroupId id)
+{
+  bool isFound = false;
+  RemoveIf([id, &isFound] (const Group& group) {
+      if (group.id != id) {
+        return false;
+      }
+      isFound = true;
+      return true;
+    });
+  return isFound;
+}
+
+void
+TracerRegistry::Remove(const std::string& type)
+{
+  RemoveIf([&type] (const Group& group) { return group.type == type; });
+}
+
+void
+TracerRegistry::Clear()
+{
+  RemoveIf([] (const Group&) { return true; });
+}
+
+void
+TracerRegistry::Flush()
+{
+  for (const Tick& tick : m_ticks) {
+    for (const Group& group : tick.groups) {
+      group.sink->Flush();
+    }
+  }
+  for (const auto& added : m_added) {
+    added.first.sink->Flush();
+  }
+}
+
+size_t
+TracerRegistry::GetNGroups() const
+{
+  size_t nGroups = m_added.size();
+  for (const Tick& tick : m_ticks) {
+    nGroups += std::count_if(tick.groups.begin(), tick.groups.end(),
+                             [] (const Group& group) { return !group.isRemoved; });
+  }
+  return nGroups;
+}
+
+size_t
+TracerRegistry::GetNEvents() const
+{
+  return std::count_if(m_ticks.begin(), m_ticks.end(),
+                       [] (const Tick& tick) { return tick.period.IsStrictlyPositive(); });
+}
+
+TracerRegistry::Tick*
+TracerRegistry::FindTick(const Time& period)
+{
+  Time now = Simulator::Now();
+  for (Tick& tick : m_ticks) {
+    if (tick.period != period) {
+      continue;
+    }
+    if (period.IsZero() || (now - tick.start).GetTimeStep() % period.GetTimeStep() == 0) {
+      return &tick;
+    }
+  }
+  return nullptr;
+}
+
+TracerRegistry::Tick*
+TracerRegistry::FindTick(const Time& period, const Time& start)
+{
+  for (Tick& tick : m_ticks) {
+    if (tick.period == period && tick.start == start) {
+      return &tick;
+    }
+  }
+  return nullptr;
+}
+
+void
+TracerRegistry::Insert(Group&& group, const Time& period)
+{
+  Tick* tick = FindTick(period);
+  if (tick == nullptr) {
+    Time now = Simulator::Now();
+    m_ticks.push_back(Tick{period, now, EventId(), {}});
+    tick = &m_ticks.back();
+    if (period.IsStrictlyPositive()) {
+      tick->event = Simulator::Schedule(period, &TracerRegistry::OnTick, this, period, now);
+    }
+  }
+  tick->groups.push_back(std::move(group));
+}
+
+template<typename Predicate>
+void
+TracerRegistry::RemoveIf(const Predicate& predicate)
+{
+  m_added.erase(std::remove_if(m_added.begin(), m_added.end(),
+                               [&predicate] (const std::pair<Group, Time>& added) {
+                                 return predicate(added.first);
+                               }),
+                m_added.end());
+
+  if (m_isPrinting) {
+    // the printed group vector must stay intact, groups are removed after printing
+    for (Tick& tick : m_ticks) {
+      for (Group& group : tick.groups) {
+        if (predicate(group)) {
+          group.isRemoved = true;
+        }
+      }
+    }
+    return;
+  }
+
+  std::vector<Group> removed;
+  for (auto tick = m_ticks.begin(); tick != m_ticks.end();) {
+    std::vector<Group>& groups = tick->groups;
+    for (auto group = groups.begin(); group != groups.end();) {
+      if (predicate(*group)) {
+        NS_LOG_DEBUG("Remove " << group->type << " group " << group->id);
+        removed.push_back(std::move(*group));
+        group = groups.erase(group);
+      }
+      else {
+        ++group;
+      }
+    }
+
+    if (groups.empty()) {
+      Simulator::Remove(tick->event);
+      tick = m_ticks.erase(tick);
+    }
+    else {
+      ++tick;
+    }
+  }
+
+  // some tracers write their last rows when destroyed, so sinks are flushed afterwards
+  for (Group& group : removed) {
+    group.printer = nullptr;
+    group.tracers.reset();
+    group.sink->Flush();
+  }
+}
+
+void
+TracerRegistry::OnTick(Time period, Time start)
+{
+  Tick* tick = FindTick(period, start);
+  NS_ASSERT(tick != nullptr);
+
+  m_isPrinting = true;
+  for (Group& group : tick->groups) {
+    if (!group.isRemoved) {
+      group.printer(*group.sink);
+    }
+  }
+  m_isPrinting = false;
+
+  tick->event = Simulator::Schedule(period, &TracerRegistry::OnTick, this, period, start);
+
+  // apply changes requested by the printers
+  RemoveIf([] (const Group& group) { return group.isRemoved; });
+
+  std::vector<std::pair<Group, Time>> added;
+  added.swap(m_added);
+  for (auto& group : added) {
+    Insert(std::move(group.first), group.second);
+  }
+}
+
+void
+TracerRegistry::OnSimulatorDestroy()
+{
+  m_isHooked = false;
+  for (Tick& tick : m_ticks) {
+    tick.event = EventId();
+  }
+  Clear();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRACER_REGISTRY_H
+#define NDN_TRACER_REGISTRY_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-trace-sink.hpp"
+
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Registry of all installed tracers, which drives their periodic output
+ *
+ * Tracers are registered in groups, one per Install call: tracers of all nodes of the call, the
+ * sink they write to, and a printer writing their rows.  All groups with the same period are
+ * printed by one shared event, one group after another, so the number of events does not depend
+ * on the number of traced nodes.  A group added later in the simulation shares the event only if
+ * it is in phase with it, so that the first period of each group is complete.
+ *
+ * The registry owns the groups: the tracers and the sink are released, and the sink flushed,
+ * when the group is removed, when all groups of its type are removed by the tracer's Destroy(),
+ * or on Simulator::Destroy.  Groups can be added and removed at any time, including from within
+ * a printer.
+ */
+class TracerRegistry : boost::noncopyable {
+public:
+  typedef uint64_t GroupId;
+
+  /**
+   * @brief Write rows of all tracers of a group into the sink, and reset their counters
+   */
+  typedef std::function<void(TraceSink& sink)> Printer;
+
+  /**
+   * @brief Get the global instance of the registry
+   */
+  static TracerRegistry&
+  Get();
+
+  /**
+   * @brief Register a group of tracers
+   * @param type type of the tracers, e.g., "L3RateTracer", used by Remove(type)
+   * @param sink sink of the group
+   * @param tracers object keeping the tracers alive as long as the group is registered
+   * @param period how often the printer is called; tracers writing rows as events happen need
+   *        neither period nor printer
+   * @param printer printer of the group
+   */
+  GroupId
+  Add(const std::string& type, shared_ptr<TraceSink> sink, shared_ptr<void> tracers,
+      Time period = Time(0), const Printer& printer = Printer());
+
+  /**
+   * @brief Remove the group, flushing its sink
+   * @return false if there is no such group
+   */
+  bool
+  Remove(GroupId id);
+
+  /**
+   * @brief Remove all groups of the type, flushing their sinks
+   */
+  void
+  Remove(const std::string& type);
+
+  /**
+   * @brief Remove all groups, flushing their sinks
+   */
+  void
+  Clear();
+
+  /**
+   * @brief Flush sinks of all groups
+   */
+  void
+  Flush();
+
+  /**
+   * @brief Get number of registered groups
+   */
+  size_t
+  GetNGroups() const;
+
+  /**
+   * @brief Get number of scheduled periodic events, one per distinct period
+   */
+  size_t
+  GetNEvents() const;
+
+private:
+  TracerRegistry();
+
+  ~TracerRegistry();
+
+  struct Group {
+    GroupId id;
+    std::string type;
+    shared_ptr<TraceSink> sink;
+    shared_ptr<void> tracers;
+    Printer printer;
+    bool isRemoved; // removal requested while printing, done after it
+  };
+
+  struct Tick {
+    Time period; // zero for groups without printer
+    Time start;  // when the tick was created, the phase of its event
+    EventId event;
+    std::vector<Group> groups;
+  };
+
+  /**
+   * @brief Find the tick printing groups of the period, if added now
+   */
+  Tick*
+  FindTick(const Time& period);
+
+  Tick*
+  FindTick(const Time& period, const Time& start);
+
+  void
+  Insert(Group&& group, const Time& period);
+
+  template<typename Predicate>
+  void
+  RemoveIf(const Predicate& predicate);
+
+  void
+  OnTick(Time period, Time start);
+
+  void
+  OnSimulatorDestroy();
+
+private:
+  std::vector<Tick> m_ticks; // few, one per distinct period
+  std::vector<std::pair<Group, Time>> m_added; // groups added while printing
+  GroupId m_lastId;
+  bool m_isPrinting;
+  bool m_isHooked; // cleanup on Simulator::Destroy is scheduled
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRACER_REGISTRY_H